@@ -0,0 +1,205 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+#include "BlockHeadTracker.h"
+#include "Provider.h"
+#include "ProviderSubscriptions.h"
+#include "Util/HexUtility.h"
+#include "Util/Log.h"
+
+static TMap<FString, TSharedRef<FBlockHeadTracker>>& Trackers()
+{
+	static TMap<FString, TSharedRef<FBlockHeadTracker>> Registry;
+	return Registry;
+}
+
+FBlockHeadTracker::FBlockHeadTracker(const FString& UrlIn) : Url(UrlIn)
+{
+	this->Fetch = [UrlIn](const TSuccessCallback<uint64>& OnSuccess, const FFailureCallback& OnFailure)
+	{
+		UProvider::Make(UrlIn)->BlockNumber(OnSuccess, OnFailure);
+	};
+}
+
+FBlockHeadTracker::FBlockHeadTracker(const FString& UrlIn, const FHeadFetch& FetchIn) : Url(UrlIn), Fetch(FetchIn)
+{
+}
+
+TSharedRef<FBlockHeadTracker> FBlockHeadTracker::Get(const FString& Url)
+{
+	if (const TSharedRef<FBlockHeadTracker>* Tracker = Trackers().Find(Url))
+	{
+		return *Tracker;
+	}
+
+	const TSharedRef<FBlockHeadTracker> Tracker = MakeShared<FBlockHeadTracker>(Url);
+	Trackers().Add(Url, Tracker);
+	return Tracker;
+}
+
+TOptional<uint64> FBlockHeadTracker::GetHead() const
+{
+	return this->Head;
+}
+
+int32 FBlockHeadTracker::AddListener(const TSuccessCallback<uint64>& OnNewHead)
+{
+	const int32 ListenerId = this->NextListenerId++;
+	this->Listeners.Add(ListenerId, OnNewHead);
+
+	if (this->Listeners.Num() == 1)
+	{
+		this->StartPolling();
+	}
+	return ListenerId;
+}
+
+void FBlockHeadTracker::RemoveListener(const int32 ListenerId)
+{
+	this->Listeners.Remove(ListenerId);
+
+	if (this->Listeners.Num() == 0)
+	{
+		this->StopPolling();
+	}
+}
+
+void FBlockHeadTracker::SetPollInterval(const float Seconds)
+{
+	this->PollIntervalSeconds = FMath::Max(Seconds, 0.1f);
+
+	//only the timer is replaced, a newHeads subscription is left running
+	if (this->TickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(this->TickerHandle);
+		this->TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateSP(this, &FBlockHeadTracker::Tick), this->PollIntervalSeconds);
+	}
+}
+
+float FBlockHeadTracker::GetPollInterval() const
+{
+	return this->PollIntervalSeconds;
+}
+
+bool FBlockHeadTracker::IsPolling() const
+{
+	return this->TickerHandle.IsValid();
+}
+
+void FBlockHeadTracker::Refresh()
+{
+	this->Poll();
+}
+
+void FBlockHeadTracker::StartPolling()
+{
+	if (this->TickerHandle.IsValid())
+	{
+		return;
+	}
+
+	this->TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateSP(this, &FBlockHeadTracker::Tick), this->PollIntervalSeconds);
+	this->Poll();
+
+	if (const TSharedPtr<FProviderSubscriptions> Subscriptions = FProviderSubscriptions::Get(this->Url))
+	{
+		const TWeakPtr<FBlockHeadTracker> WeakThis = AsShared();
+		this->HeadSubscription = Subscriptions->SubscribeNewHeads([WeakThis](const TSharedPtr<FJsonValue>& Result)
+		{
+			const TSharedPtr<FJsonObject>* Header;
+			FString Number;
+			if (!Result || !Result->TryGetObject(Header) || !(*Header)->TryGetStringField(TEXT("number"), Number))
+			{
+				return;
+			}
+
+			const TOptional<uint64> BlockNumber = HexStringToUint64(Number);
+			const TSharedPtr<FBlockHeadTracker> Tracker = WeakThis.Pin();
+			if (Tracker && BlockNumber.IsSet())
+			{
+				Tracker->OnBlockNumber(BlockNumber.GetValue());
+			}
+		}, [WeakThis](const FSequenceError& Error)
+		{
+			if (const TSharedPtr<FBlockHeadTracker> Tracker = WeakThis.Pin())
+			{
+				Tracker->HeadSubscription = INDEX_NONE;
+			}
+			SEQ_LOG(Warning, TEXT("newHeads subscription rejected, falling back to polling: %s"), *Error.Message);
+		});
+	}
+}
+
+void FBlockHeadTracker::StopPolling()
+{
+	if (this->TickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(this->TickerHandle);
+		this->TickerHandle.Reset();
+	}
+
+	if (this->HeadSubscription != INDEX_NONE)
+	{
+		if (const TSharedPtr<FProviderSubscriptions> Subscriptions = FProviderSubscriptions::Get(this->Url))
+		{
+			Subscriptions->Unsubscribe(this->HeadSubscription);
+		}
+		this->HeadSubscription = INDEX_NONE;
+	}
+}
+
+bool FBlockHeadTracker::Tick(float DeltaTime)
+{
+	//polling is only a fallback while the newHeads subscription is down
+	if (this->HeadSubscription != INDEX_NONE)
+	{
+		const TSharedPtr<FProviderSubscriptions> Subscriptions = FProviderSubscriptions::Get(this->Url);
+		if (Subscriptions && Subscriptions->IsLive(this->HeadSubscription))
+		{
+			return true;
+		}
+	}
+	this->Poll();
+	return true;
+}
+
+void FBlockHeadTracker::Poll()
+{
+	if (this->bPollInFlight)
+	{
+		return;
+	}
+	this->bPollInFlight = true;
+
+	const TWeakPtr<FBlockHeadTracker> WeakThis = AsShared();
+	this->Fetch([WeakThis](const uint64 BlockNumber)
+	{
+		if (const TSharedPtr<FBlockHeadTracker> Tracker = WeakThis.Pin())
+		{
+			Tracker->bPollInFlight = false;
+			Tracker->OnBlockNumber(BlockNumber);
+		}
+	}, [WeakThis](const FSequenceError& Error)
+	{
+		if (const TSharedPtr<FBlockHeadTracker> Tracker = WeakThis.Pin())
+		{
+			Tracker->bPollInFlight = false;
+		}
+		SEQ_LOG(Warning, TEXT("Failed to poll block head: %s"), *Error.Message);
+	});
+}
+
+void FBlockHeadTracker::OnBlockNumber(const uint64 BlockNumber)
+{
+	if (this->Head.IsSet() && this->Head.GetValue() >= BlockNumber)
+	{
+		return;
+	}
+	this->Head = BlockNumber;
+
+	//listeners may add or remove listeners while being notified
+	TArray<TSuccessCallback<uint64>> ToNotify;
+	this->Listeners.GenerateValueArray(ToNotify);
+	for (const TSuccessCallback<uint64>& Listener : ToNotify)
+	{
+		Listener(BlockNumber);
+	}
+}
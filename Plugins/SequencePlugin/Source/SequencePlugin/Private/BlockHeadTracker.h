@@ -0,0 +1,84 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+#pragma once
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "Util/Async.h"
+
+/**
+ * Tracks the head block of one chain (one RPC Url) and fans new blocks out to listeners.
+ * There is one tracker per Url, shared by every consumer, so the chain is polled once
+ * no matter how many caches or widgets want to follow it.
+ * Polling only runs while at least one listener is registered. When a WebSocket url is set for the
+ * chain (UProvider::SetWebSocketUrl) before the first listener, heads come from a newHeads subscription
+ * and polling only resumes while that subscription is down.
+ */
+class SEQUENCEPLUGIN_API FBlockHeadTracker : public TSharedFromThis<FBlockHeadTracker>
+{
+public:
+	/* Fetches the current head once */
+	using FHeadFetch = TFunction<void (const TSuccessCallback<uint64>&, const FFailureCallback&)>;
+private:
+	FString Url;
+	FHeadFetch Fetch;
+
+	TOptional<uint64> Head;
+	TMap<int32, TSuccessCallback<uint64>> Listeners;
+	int32 NextListenerId = 1;
+
+	float PollIntervalSeconds = 2.0f;
+	bool bPollInFlight = false;
+	FTSTicker::FDelegateHandle TickerHandle;
+	int32 HeadSubscription = INDEX_NONE;
+
+	bool Tick(float DeltaTime);
+	void Poll();
+	void OnBlockNumber(const uint64 BlockNumber);
+	void StartPolling();
+	void StopPolling();
+public:
+	explicit FBlockHeadTracker(const FString& UrlIn);
+
+	/**
+	 * @param FetchIn Polls the head, public so the tracker can be driven without a node
+	 */
+	FBlockHeadTracker(const FString& UrlIn, const FHeadFetch& FetchIn);
+
+	/**
+	 * Gets the shared tracker for the given RPC Url, creating it on first use
+	 */
+	static TSharedRef<FBlockHeadTracker> Get(const FString& Url);
+
+	/**
+	 * @return the last head seen, unset until the first poll completes
+	 */
+	TOptional<uint64> GetHead() const;
+
+	/**
+	 * Registers a listener fired with the new head every time the chain advances,
+	 * the first listener starts polling
+	 * @return Id used to remove the listener
+	 */
+	int32 AddListener(const TSuccessCallback<uint64>& OnNewHead);
+
+	/**
+	 * Removes a listener, polling stops once the last listener is removed
+	 */
+	void RemoveListener(const int32 ListenerId);
+
+	/**
+	 * Sets how often the head is polled
+	 */
+	void SetPollInterval(const float Seconds);
+
+	float GetPollInterval() const;
+
+	/**
+	 * @return true while listeners keep the poll timer running
+	 */
+	bool IsPolling() const;
+
+	/**
+	 * Polls the head immediately without waiting for the next interval
+	 */
+	void Refresh();
+};
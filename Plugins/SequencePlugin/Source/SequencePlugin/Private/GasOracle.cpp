@@ -0,0 +1,235 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+#include "GasOracle.h"
+#include "BlockHeadTracker.h"
+#include "Provider.h"
+#include "ProviderBatch.h"
+#include "Util/HexUtility.h"
+#include "Util/Log.h"
+
+static TMap<FString, TSharedRef<FGasOracle>>& Oracles()
+{
+	static TMap<FString, TSharedRef<FGasOracle>> Registry;
+	return Registry;
+}
+
+FGasOracle::FGasOracle(const FString& UrlIn) : Url(UrlIn)
+{
+}
+
+TSharedRef<FGasOracle> FGasOracle::Get(const FString& Url)
+{
+	if (const TSharedRef<FGasOracle>* Oracle = Oracles().Find(Url))
+	{
+		return *Oracle;
+	}
+
+	const TSharedRef<FGasOracle> Oracle = MakeShared<FGasOracle>(Url);
+	Oracles().Add(Url, Oracle);
+	return Oracle;
+}
+
+void FGasOracle::GetSuggestion(const TSuccessCallback<FGasSuggestion>& OnSuccess, const FFailureCallback& OnFailure)
+{
+	if (this->IsFresh())
+	{
+		OnSuccess(this->Suggestion.GetValue());
+		return;
+	}
+
+	this->Waiting.Add(FWaiting{ OnSuccess, OnFailure });
+	if (!this->bFetching)
+	{
+		this->Fetch();
+	}
+}
+
+void FGasOracle::GetGasPrice(const TSuccessCallback<FUnsizedData>& OnSuccess, const FFailureCallback& OnFailure)
+{
+	this->GetSuggestion([OnSuccess](const FGasSuggestion& Suggestion)
+	{
+		OnSuccess(Suggestion.GasPrice);
+	}, OnFailure);
+}
+
+TOptional<FGasSuggestion> FGasOracle::GetCachedSuggestion() const
+{
+	return this->Suggestion;
+}
+
+void FGasOracle::SetFeeHistorySampling(const bool bEnabled, const int32 Blocks, const TArray<float>& Percentiles)
+{
+	this->bSampleFeeHistory = bEnabled;
+	this->FeeHistoryBlocks = FMath::Clamp(Blocks, 1, 1024);
+	this->RewardPercentiles = Percentiles;
+	this->Invalidate();
+}
+
+void FGasOracle::SetAutoRefresh(const bool bEnabled)
+{
+	if (bEnabled == (this->HeadListener != INDEX_NONE))
+	{
+		return;
+	}
+
+	const TSharedRef<FBlockHeadTracker> Tracker = FBlockHeadTracker::Get(this->Url);
+	if (!bEnabled)
+	{
+		Tracker->RemoveListener(this->HeadListener);
+		this->HeadListener = INDEX_NONE;
+		return;
+	}
+
+	const TWeakPtr<FGasOracle> WeakThis = AsShared();
+	this->HeadListener = Tracker->AddListener([WeakThis](const uint64 Head)
+	{
+		const TSharedPtr<FGasOracle> Oracle = WeakThis.Pin();
+		if (Oracle && !Oracle->bFetching)
+		{
+			Oracle->Fetch();
+		}
+	});
+}
+
+void FGasOracle::SetMaxAge(const float Seconds)
+{
+	this->MaxAgeSeconds = FMath::Max(Seconds, 0.0f);
+}
+
+void FGasOracle::Invalidate()
+{
+	this->Suggestion.Reset();
+}
+
+bool FGasOracle::IsFresh() const
+{
+	if (!this->Suggestion.IsSet() || FPlatformTime::Seconds() - this->Suggestion->FetchedSeconds > this->MaxAgeSeconds)
+	{
+		return false;
+	}
+
+	//a newer head means a new base fee, only known when someone follows the chain
+	const TOptional<uint64> Head = FBlockHeadTracker::Get(this->Url)->GetHead();
+	return !Head.IsSet() || !this->Suggestion->BlockNumber.IsSet() || this->Suggestion->BlockNumber.GetValue() >= Head.GetValue();
+}
+
+void FGasOracle::Fetch()
+{
+	this->bFetching = true;
+
+	const TSharedRef<FGasSuggestion> Fetched = MakeShared<FGasSuggestion>();
+	Fetched->BlockNumber = FBlockHeadTracker::Get(this->Url)->GetHead();
+
+	const TSharedRef<TOptional<FSequenceError>> GasPriceError = MakeShared<TOptional<FSequenceError>>();
+	const TWeakPtr<FGasOracle> WeakThis = AsShared();
+	const TSharedRef<int32> Remaining = MakeShared<int32>(this->bSampleFeeHistory ? 2 : 1);
+	const TFunction<void ()> EntryDone = [WeakThis, Fetched, GasPriceError, Remaining]()
+	{
+		if (--(*Remaining) > 0)
+		{
+			return;
+		}
+
+		if (const TSharedPtr<FGasOracle> Oracle = WeakThis.Pin())
+		{
+			Fetched->FetchedSeconds = FPlatformTime::Seconds();
+			Oracle->OnFetched(GasPriceError->IsSet() ? TOptional<FGasSuggestion>() : TOptional<FGasSuggestion>(*Fetched), GasPriceError->Get(FSequenceError(RequestFail, "")));
+		}
+	};
+
+	const TSharedRef<FProviderBatch> Batch = UProvider::Make(this->Url)->NewBatch();
+	Batch->GetGasPrice([Fetched, EntryDone](const FUnsizedData& GasPrice)
+	{
+		Fetched->GasPrice = GasPrice;
+		EntryDone();
+	}, [GasPriceError, EntryDone](const FSequenceError& Error)
+	{
+		*GasPriceError = Error;
+		EntryDone();
+	});
+
+	if (this->bSampleFeeHistory)
+	{
+		//fee history is not served by every chain, the gas price alone still makes a suggestion
+		Batch->FeeHistory(this->FeeHistoryBlocks, EBlockTag::ELatest, this->RewardPercentiles, [Fetched, EntryDone](const TSharedPtr<FJsonObject>& FeeHistory)
+		{
+			ParseFeeHistory(FeeHistory, *Fetched);
+			EntryDone();
+		}, [EntryDone](const FSequenceError& Error)
+		{
+			SEQ_LOG(Warning, TEXT("eth_feeHistory failed, suggesting gas price only: %s"), *Error.Message);
+			EntryDone();
+		});
+	}
+
+	Batch->Send();
+}
+
+void FGasOracle::OnFetched(const TOptional<FGasSuggestion>& Fetched, const FSequenceError& Error)
+{
+	this->bFetching = false;
+	if (Fetched.IsSet())
+	{
+		this->Suggestion = Fetched;
+	}
+
+	const TArray<FWaiting> Ready = MoveTemp(this->Waiting);
+	this->Waiting.Reset();
+	for (const FWaiting& Entry : Ready)
+	{
+		if (Fetched.IsSet())
+		{
+			Entry.OnSuccess(Fetched.GetValue());
+		}
+		else
+		{
+			Entry.OnFailure(Error);
+		}
+	}
+}
+
+bool FGasOracle::ParseFeeHistory(const TSharedPtr<FJsonObject>& FeeHistory, FGasSuggestion& Suggestion)
+{
+	const TArray<TSharedPtr<FJsonValue>>* BaseFees;
+	if (!FeeHistory || !FeeHistory->TryGetArrayField(TEXT("baseFeePerGas"), BaseFees) || BaseFees->Num() == 0)
+	{
+		return false;
+	}
+
+	//the last base fee is the one of the block after the newest sampled block
+	Suggestion.BaseFee = HexStringToUint64(BaseFees->Last()->AsString()).Get(0);
+
+	FString OldestBlock;
+	if (FeeHistory->TryGetStringField(TEXT("oldestBlock"), OldestBlock))
+	{
+		const TOptional<uint64> Oldest = HexStringToUint64(OldestBlock);
+		if (Oldest.IsSet() && BaseFees->Num() >= 2)
+		{
+			Suggestion.BlockNumber = Oldest.GetValue() + BaseFees->Num() - 2;
+		}
+	}
+
+	const TArray<TSharedPtr<FJsonValue>>* Rewards;
+	Suggestion.PriorityFees.Reset();
+	if (!FeeHistory->TryGetArrayField(TEXT("reward"), Rewards) || Rewards->Num() == 0)
+	{
+		return true;
+	}
+
+	const int32 PercentileCount = (*Rewards)[0]->AsArray().Num();
+	for (int32 Percentile = 0; Percentile < PercentileCount; Percentile++)
+	{
+		TArray<uint64> Samples;
+		for (const TSharedPtr<FJsonValue>& Block : *Rewards)
+		{
+			const TArray<TSharedPtr<FJsonValue>>& BlockRewards = Block->AsArray();
+			if (BlockRewards.IsValidIndex(Percentile))
+			{
+				Samples.Add(HexStringToUint64(BlockRewards[Percentile]->AsString()).Get(0));
+			}
+		}
+
+		Samples.Sort();
+		Suggestion.PriorityFees.Add(Samples.Num() > 0 ? Samples[Samples.Num() / 2] : 0);
+	}
+	return true;
+}
@@ -0,0 +1,104 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+#pragma once
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "Types/BinaryData.h"
+#include "Util/Async.h"
+
+/**
+ * Fees suggested for the next block
+ */
+struct SEQUENCEPLUGIN_API FGasSuggestion
+{
+	/* eth_gasPrice, what legacy transactions should pay */
+	FUnsizedData GasPrice = FUnsizedData::Empty();
+
+	/* Base fee of the next block, 0 without fee history sampling or on chains without EIP-1559 */
+	uint64 BaseFee = 0;
+
+	/* Median over the sampled blocks of each requested reward percentile, empty without fee history sampling */
+	TArray<uint64> PriorityFees;
+
+	/* Head when the suggestion was fetched, unset if no head was known */
+	TOptional<uint64> BlockNumber;
+	double FetchedSeconds = 0.0;
+};
+
+/**
+ * Caches gas price, and optionally eth_feeHistory percentiles, of one chain (one RPC Url) per block.
+ * Concurrent requests share one fetch, and while auto refresh is on the cache is renewed on every new
+ * head from FBlockHeadTracker, so transaction builders can read fees synchronously without a round trip.
+ * There is one oracle per Url, shared by every provider. Game thread only.
+ */
+class SEQUENCEPLUGIN_API FGasOracle : public TSharedFromThis<FGasOracle>
+{
+	struct FWaiting
+	{
+		TSuccessCallback<FGasSuggestion> OnSuccess;
+		FFailureCallback OnFailure;
+	};
+
+	FString Url;
+	TOptional<FGasSuggestion> Suggestion;
+	TArray<FWaiting> Waiting;
+	bool bFetching = false;
+
+	bool bSampleFeeHistory = false;
+	int32 FeeHistoryBlocks = 10;
+	TArray<float> RewardPercentiles = { 25.0f, 50.0f, 75.0f };
+
+	float MaxAgeSeconds = 5.0f;
+	int32 HeadListener = INDEX_NONE;
+
+	bool IsFresh() const;
+	void Fetch();
+	void OnFetched(const TOptional<FGasSuggestion>& Fetched, const FSequenceError& Error);
+public:
+	explicit FGasOracle(const FString& UrlIn);
+
+	/**
+	 * Gets the shared oracle for the given RPC Url, creating it on first use
+	 */
+	static TSharedRef<FGasOracle> Get(const FString& Url);
+
+	/**
+	 * Serves the cached suggestion while it is fresh (fetched at the current head and within the max age),
+	 * otherwise fetches a new one
+	 */
+	void GetSuggestion(const TSuccessCallback<FGasSuggestion>& OnSuccess, const FFailureCallback& OnFailure);
+
+	/**
+	 * Same as GetSuggestion for the gas price alone
+	 */
+	void GetGasPrice(const TSuccessCallback<FUnsizedData>& OnSuccess, const FFailureCallback& OnFailure);
+
+	/**
+	 * @return the last suggestion fetched, possibly a block old, unset until the first fetch completes
+	 */
+	TOptional<FGasSuggestion> GetCachedSuggestion() const;
+
+	/**
+	 * Also samples eth_feeHistory on every fetch, in the same batch as eth_gasPrice
+	 * @param Blocks Number of recent blocks sampled
+	 * @param Percentiles Priority fee percentiles sampled in each block, ascending
+	 */
+	void SetFeeHistorySampling(const bool bEnabled, const int32 Blocks = 10, const TArray<float>& Percentiles = { 25.0f, 50.0f, 75.0f });
+
+	/**
+	 * Refetches on every new head so GetCachedSuggestion stays current
+	 */
+	void SetAutoRefresh(const bool bEnabled);
+
+	/**
+	 * Sets how long a suggestion is served for when no newer head is known
+	 */
+	void SetMaxAge(const float Seconds);
+
+	void Invalidate();
+
+	/**
+	 * Reads the next block base fee and the median of each reward percentile from an eth_feeHistory result
+	 * @return false if the result carries no base fees
+	 */
+	static bool ParseFeeHistory(const TSharedPtr<FJsonObject>& FeeHistory, FGasSuggestion& Suggestion);
+};
@@ -366,6 +366,8 @@ FString AGeneralTesting::ErrorToString(EErrorType Error)
 		return "RequestTimeExceeded";
 	case TestFail:
 		return "TestFail";
+	case TransactionDropped:
+		return "TransactionDropped";
 	default:
 		return "SequenceError";
 	}
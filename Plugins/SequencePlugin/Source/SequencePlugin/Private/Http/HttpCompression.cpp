@@ -0,0 +1,175 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+#include "Http/HttpCompression.h"
+#include "Http/HttpExecutor.h"
+#include "Http/RequestPolicy.h"
+#include "Misc/Compression.h"
+#include "Types/BinaryData.h"
+#include "Util/Log.h"
+
+namespace HttpCompression
+{
+	/* header (10) + trailer (8) */
+	constexpr int32 MinGzipSize = 18;
+
+	/* refuse to inflate a corrupt or hostile trailer into an absurd allocation */
+	constexpr int64 MaxDecodedSize = 256 * 1024 * 1024;
+
+	static FHttpTransferStats& Stats()
+	{
+		static FHttpTransferStats Totals;
+		return Totals;
+	}
+
+	/*
+	* gzip ends with the decoded size modulo 2^32 as a little endian uint32
+	*/
+	static int64 GetGzipDecodedSize(const TConstArrayView<uint8> Compressed)
+	{
+		const uint8* Trailer = Compressed.GetData() + Compressed.Num() - 4;
+		return static_cast<int64>(Trailer[0]) | static_cast<int64>(Trailer[1]) << 8 | static_cast<int64>(Trailer[2]) << 16 | static_cast<int64>(Trailer[3]) << 24;
+	}
+
+	static bool IsGzipEncoded(const FHttpResponsePtr& Response)
+	{
+		return Response->GetHeader(TEXT("Content-Encoding")).Contains(TEXT("gzip"));
+	}
+}
+
+int64 FHttpTransferStats::GetSavedBytes() const
+{
+	return (this->RequestPlainBytes - this->RequestWireBytes) + (this->ResponsePlainBytes - this->ResponseWireBytes);
+}
+
+void FHttpCompression::EncodeRequest(const FHttpRequestRef& Request, const FHttpRequestDescriptor& Descriptor, const FRequestPolicy& Policy)
+{
+	if (Policy.bAcceptCompressed)
+	{
+		Request->SetHeader(TEXT("Accept-Encoding"), TEXT("gzip"));
+	}
+
+	if (Descriptor.Content.IsEmpty())
+	{
+		return;
+	}
+
+	const FTCHARToUTF8 Utf8(*Descriptor.Content);
+	const TConstArrayView<uint8> Plain(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+	FHttpTransferStats& Stats = HttpCompression::Stats();
+	Stats.RequestPlainBytes += Plain.Num();
+
+	TArray<uint8> Compressed;
+	if (Policy.CompressRequestsAboveBytes > 0 && Plain.Num() >= Policy.CompressRequestsAboveBytes && Gzip(Plain, Compressed) && Compressed.Num() < Plain.Num())
+	{
+		Stats.RequestWireBytes += Compressed.Num();
+		Stats.CompressedRequests++;
+		Request->SetHeader(TEXT("Content-Encoding"), TEXT("gzip"));
+		Request->SetContent(MoveTemp(Compressed));
+		return;
+	}
+
+	Stats.RequestWireBytes += Plain.Num();
+	Request->SetContent(TArray<uint8>(Plain));
+}
+
+void FHttpCompression::RecordResponse(const FHttpResponsePtr& Response)
+{
+	if (!Response.IsValid())
+	{
+		return;
+	}
+
+	const TArray<uint8>& Content = Response->GetContent();
+	int64 PlainBytes = Content.Num();
+	int64 WireBytes = Content.Num();
+
+	FHttpTransferStats& Stats = HttpCompression::Stats();
+	if (HttpCompression::IsGzipEncoded(Response))
+	{
+		Stats.CompressedResponses++;
+		if (IsGzip(Content) && Content.Num() >= HttpCompression::MinGzipSize)
+		{
+			PlainBytes = HttpCompression::GetGzipDecodedSize(Content);
+		}
+		else
+		{
+			//already decoded by the platform, Content-Length still describes the encoded body
+			LexTryParseString(WireBytes, *Response->GetHeader(TEXT("Content-Length")));
+		}
+	}
+
+	Stats.ResponsePlainBytes += PlainBytes;
+	Stats.ResponseWireBytes += WireBytes;
+}
+
+const TArray<uint8>& FHttpCompression::GetContent(const FHttpResponsePtr& Response, TArray<uint8>& Decoded)
+{
+	const TArray<uint8>& Content = Response->GetContent();
+	if (!IsGzip(Content) || !HttpCompression::IsGzipEncoded(Response))
+	{
+		return Content;
+	}
+
+	if (!Gunzip(Content, Decoded))
+	{
+		SEQ_LOG(Warning, TEXT("Failed to decode gzip response from %s"), *Response->GetURL());
+		return Content;
+	}
+	return Decoded;
+}
+
+FString FHttpCompression::GetContentAsString(const FHttpResponsePtr& Response)
+{
+	TArray<uint8> Decoded;
+	return UTF8BytesToString(GetContent(Response, Decoded));
+}
+
+bool FHttpCompression::Gzip(const TConstArrayView<uint8> Plain, TArray<uint8>& OutCompressed)
+{
+	int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Gzip, Plain.Num());
+	OutCompressed.SetNumUninitialized(CompressedSize);
+	if (!FCompression::CompressMemory(NAME_Gzip, OutCompressed.GetData(), CompressedSize, Plain.GetData(), Plain.Num()))
+	{
+		OutCompressed.Reset();
+		return false;
+	}
+	OutCompressed.SetNum(CompressedSize, EAllowShrinking::No);
+	return true;
+}
+
+bool FHttpCompression::Gunzip(const TConstArrayView<uint8> Compressed, TArray<uint8>& OutPlain)
+{
+	if (!IsGzip(Compressed) || Compressed.Num() < HttpCompression::MinGzipSize)
+	{
+		return false;
+	}
+
+	const int64 Trailer = HttpCompression::GetGzipDecodedSize(Compressed);
+	if (Trailer > HttpCompression::MaxDecodedSize)
+	{
+		return false;
+	}
+
+	const int32 DecodedSize = static_cast<int32>(Trailer);
+	OutPlain.SetNumUninitialized(DecodedSize);
+	if (!FCompression::UncompressMemory(NAME_Gzip, OutPlain.GetData(), DecodedSize, Compressed.GetData(), Compressed.Num()))
+	{
+		OutPlain.Reset();
+		return false;
+	}
+	return true;
+}
+
+bool FHttpCompression::IsGzip(const TConstArrayView<uint8> Content)
+{
+	return Content.Num() >= 2 && Content[0] == 0x1f && Content[1] == 0x8b;
+}
+
+FHttpTransferStats FHttpCompression::GetStats()
+{
+	return HttpCompression::Stats();
+}
+
+void FHttpCompression::ResetStats()
+{
+	HttpCompression::Stats() = FHttpTransferStats();
+}
@@ -0,0 +1,72 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+#pragma once
+#include "CoreMinimal.h"
+#include "Interfaces/IHttpRequest.h"
+#include "Interfaces/IHttpResponse.h"
+
+struct FHttpRequestDescriptor;
+struct FRequestPolicy;
+
+/**
+ * Bytes moved by the SDK since the last reset.
+ * Wire bytes are what went over the network, plain bytes what they amount to once decoded.
+ */
+struct SEQUENCEPLUGIN_API FHttpTransferStats
+{
+	int64 RequestPlainBytes = 0;
+	int64 RequestWireBytes = 0;
+	int64 ResponsePlainBytes = 0;
+	int64 ResponseWireBytes = 0;
+	int32 CompressedRequests = 0;
+	int32 CompressedResponses = 0;
+
+	/*
+	* @return bytes saved by compression in both directions
+	*/
+	int64 GetSavedBytes() const;
+};
+
+/**
+ * Opt-in gzip transport, enabled per url through FRequestPolicy::bAcceptCompressed and
+ * FRequestPolicy::CompressRequestsAboveBytes.
+ * Most platform HTTP stacks decode gzip responses on their own, bodies that still arrive encoded
+ * are decoded by GetContent. Only gzip is negotiated because a deflate stream doesn't carry
+ * its decoded size, which the engine decompressor needs up front.
+ * Must be used from the game thread.
+ */
+class SEQUENCEPLUGIN_API FHttpCompression
+{
+public:
+	/*
+	* Sets the body of Request from the descriptor, gzip compressed when the policy asks for it,
+	* and advertises gzip support when the policy accepts compressed responses
+	*/
+	static void EncodeRequest(const FHttpRequestRef& Request, const FHttpRequestDescriptor& Descriptor, const FRequestPolicy& Policy);
+
+	/*
+	* Adds a completed response to the transfer stats
+	*/
+	static void RecordResponse(const FHttpResponsePtr& Response);
+
+	/*
+	* @param Decoded storage for the decoded body, only used when the body arrived still encoded
+	* @return the decoded body of Response
+	*/
+	static const TArray<uint8>& GetContent(const FHttpResponsePtr& Response, TArray<uint8>& Decoded);
+
+	/*
+	* @return the decoded body of Response as a string
+	*/
+	static FString GetContentAsString(const FHttpResponsePtr& Response);
+
+	static bool Gzip(TConstArrayView<uint8> Plain, TArray<uint8>& OutCompressed);
+	static bool Gunzip(TConstArrayView<uint8> Compressed, TArray<uint8>& OutPlain);
+
+	/*
+	* @return true if Content starts with the gzip magic bytes
+	*/
+	static bool IsGzip(TConstArrayView<uint8> Content);
+
+	static FHttpTransferStats GetStats();
+	static void ResetStats();
+};
@@ -0,0 +1,412 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+#include "Http/HttpExecutor.h"
+#include "HttpModule.h"
+#include "Containers/Ticker.h"
+#include "Http/HttpRequestPool.h"
+#include "Http/HttpCompression.h"
+#include "Http/RequestMetrics.h"
+#include "Http/RateLimiter.h"
+#include "Util/Log.h"
+
+namespace HttpExecutor
+{
+	constexpr int32 MaxLatencySamples = 64;
+	constexpr int32 MinLatencySamples = 16;
+
+	struct FLatencySamples
+	{
+		TArray<float> Samples;
+		int32 Next = 0;
+	};
+
+	static TMap<FString, FLatencySamples>& Latencies()
+	{
+		static TMap<FString, FLatencySamples> Endpoints;
+		return Endpoints;
+	}
+
+	static FString EndpointKey(const FString& Url)
+	{
+		int32 QueryStart = INDEX_NONE;
+		return Url.FindChar(TEXT('?'), QueryStart) ? Url.Left(QueryStart) : Url;
+	}
+
+	static FString FindAccessKey(const FHttpRequestDescriptor& Descriptor)
+	{
+		for (const TPair<FString, FString>& Header : Descriptor.Headers)
+		{
+			if (Header.Key.Equals("X-Access-Key", ESearchCase::IgnoreCase))
+			{
+				return Header.Value;
+			}
+		}
+
+		if (Descriptor.SharedHeaders.IsValid())
+		{
+			for (const TPair<FString, FString>& Header : *Descriptor.SharedHeaders)
+			{
+				if (Header.Key.Equals("X-Access-Key", ESearchCase::IgnoreCase))
+				{
+					return Header.Value;
+				}
+			}
+		}
+		return "";
+	}
+
+	static void AddTimer(const float DelaySeconds, TFunction<void ()> Callback)
+	{
+		FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([Callback](float)
+		{
+			Callback();
+			return false;
+		}), DelaySeconds);
+	}
+
+	/*
+	* Timing of a single attempt, reported for the attempt that settles the call
+	*/
+	struct FAttemptTiming
+	{
+		double QueueSeconds = 0.0;
+		TOptional<double> TimeToFirstByteSeconds;
+	};
+
+	/*
+	* State shared by every attempt of one call
+	*/
+	class FHttpCall : public TSharedFromThis<FHttpCall>
+	{
+		TSharedRef<const FHttpRequestDescriptor> Descriptor;
+		FRequestPolicy Policy;
+		FHttpCompleteCallback OnComplete;
+		FString AccessKey;
+		TArray<FHttpRequestPtr> InFlight;
+		double StartSeconds = 0.0;
+		int32 AttemptsStarted = 0;
+		bool bHedged = false;
+		bool bDone = false;
+	public:
+		FHttpCall(const TSharedRef<const FHttpRequestDescriptor>& DescriptorIn, const FRequestPolicy& PolicyIn, const FHttpCompleteCallback& OnCompleteIn)
+			: Descriptor(DescriptorIn), Policy(PolicyIn), OnComplete(OnCompleteIn), AccessKey(FindAccessKey(*DescriptorIn))
+		{
+		}
+
+		void Start()
+		{
+			this->StartSeconds = FPlatformTime::Seconds();
+			this->StartAttempt();
+
+			if (this->Policy.bHedge && this->Descriptor->bIdempotent)
+			{
+				const float HedgeDelay = this->Policy.GetHedgeDelaySeconds(FHttpExecutor::GetLatencyPercentile(this->Descriptor->Url, 0.95f));
+				TSharedRef<FHttpCall> Call = this->AsShared();
+				AddTimer(HedgeDelay, [Call]()
+				{
+					Call->Hedge();
+				});
+			}
+		}
+	private:
+		void StartAttempt()
+		{
+			this->AttemptsStarted++;
+
+			TSharedRef<FHttpCall> Call = this->AsShared();
+			const double EnqueuedSeconds = FPlatformTime::Seconds();
+			FRateLimiter::Get().Acquire(this->Descriptor->Url, this->AccessKey, this->Descriptor->Priority, [Call, EnqueuedSeconds]()
+			{
+				FRequestScheduler::Get().Enqueue(Call->Descriptor->Url, Call->Descriptor->Priority, [Call, EnqueuedSeconds]()
+				{
+					Call->Launch(FPlatformTime::Seconds() - EnqueuedSeconds);
+				});
+			});
+		}
+
+		void Launch(const double QueueSeconds)
+		{
+			//the call was settled by another attempt while this one waited for a slot
+			if (this->bDone)
+			{
+				FRequestScheduler::Get().Release(this->Descriptor->Url, this->Descriptor->Priority);
+				return;
+			}
+
+			const FHttpRequestRef Request = FHttpExecutor::CreateRequest(*this->Descriptor, this->Policy);
+			const double StartTime = FPlatformTime::Seconds();
+			const TSharedRef<double> FirstHeaderTime = MakeShared<double>(0.0);
+
+			Request->OnHeaderReceived().BindLambda([FirstHeaderTime](FHttpRequestPtr, const FString&, const FString&)
+			{
+				if (*FirstHeaderTime == 0.0)
+				{
+					*FirstHeaderTime = FPlatformTime::Seconds();
+				}
+			});
+
+			TSharedRef<FHttpCall> Call = this->AsShared();
+			Request->OnProcessRequestComplete().BindLambda([Call, StartTime, QueueSeconds, FirstHeaderTime](FHttpRequestPtr Req, FHttpResponsePtr Response, const bool bWasSuccessful)
+			{
+				FAttemptTiming Timing;
+				Timing.QueueSeconds = QueueSeconds;
+				if (*FirstHeaderTime > 0.0)
+				{
+					Timing.TimeToFirstByteSeconds = *FirstHeaderTime - StartTime;
+				}
+				Call->OnAttemptComplete(Req, Response, bWasSuccessful, FPlatformTime::Seconds() - StartTime, Timing);
+			});
+
+			this->InFlight.Add(Request);
+			Request->ProcessRequest();
+		}
+
+		void Hedge()
+		{
+			if (this->bDone || this->bHedged || this->InFlight.Num() == 0)
+			{
+				return;
+			}
+
+			this->bHedged = true;
+			SEQ_LOG(Verbose, TEXT("Hedging request to %s"), *this->Descriptor->Url);
+			this->StartAttempt();
+		}
+
+		void OnAttemptComplete(const FHttpRequestPtr& Request, const FHttpResponsePtr& Response, const bool bWasSuccessful, const double Seconds, const FAttemptTiming& Timing)
+		{
+			FRequestScheduler::Get().Release(this->Descriptor->Url, this->Descriptor->Priority);
+			if (this->bDone)
+			{
+				return;
+			}
+			this->InFlight.Remove(Request);
+
+			//the retry below waits in the limiter until the server's Retry-After has passed
+			if (bWasSuccessful && Response.IsValid() && (Response->GetResponseCode() == 429 || (Response->GetResponseCode() == 503 && !Response->GetHeader("Retry-After").IsEmpty())))
+			{
+				FRateLimiter::Get().OnThrottled(this->Descriptor->Url, this->AccessKey, FRateLimiter::ParseRetryAfter(Response->GetHeader("Retry-After"), FDateTime::UtcNow()));
+			}
+
+			if (!FHttpExecutor::IsRetryable(Request, Response, bWasSuccessful, this->Descriptor->bIdempotent))
+			{
+				if (bWasSuccessful && Response.IsValid())
+				{
+					FHttpExecutor::RecordLatency(this->Descriptor->Url, Seconds);
+				}
+				this->Finish(Request, Response, bWasSuccessful, Timing);
+				return;
+			}
+
+			//a hedged copy is still running, let it decide the outcome
+			if (this->InFlight.Num() > 0)
+			{
+				return;
+			}
+
+			if (this->AttemptsStarted >= this->Policy.MaxAttempts)
+			{
+				this->Finish(Request, Response, bWasSuccessful, Timing);
+				return;
+			}
+
+			const float Backoff = this->Policy.GetBackoffSeconds(this->AttemptsStarted, FMath::FRand());
+			SEQ_LOG(Verbose, TEXT("Retrying request to %s in %.2fs (attempt %d of %d)"), *this->Descriptor->Url, Backoff, this->AttemptsStarted + 1, this->Policy.MaxAttempts);
+
+			TSharedRef<FHttpCall> Call = this->AsShared();
+			AddTimer(Backoff, [Call]()
+			{
+				Call->StartAttempt();
+			});
+		}
+
+		void Finish(const FHttpRequestPtr& Request, const FHttpResponsePtr& Response, const bool bWasSuccessful, const FAttemptTiming& Timing)
+		{
+			this->bDone = true;
+
+			for (const FHttpRequestPtr& Loser : this->InFlight)
+			{
+				Loser->OnProcessRequestComplete().Unbind();
+				Loser->CancelRequest();
+				FRequestScheduler::Get().Release(this->Descriptor->Url, this->Descriptor->Priority);
+			}
+			this->InFlight.Empty();
+
+			FHttpCompression::RecordResponse(Response);
+			FRequestTracer::Trace(*this->Descriptor, Request, Response, bWasSuccessful, this->AttemptsStarted, this->StartSeconds, static_cast<float>(Timing.QueueSeconds));
+			FRequestMetrics::Record(*this->Descriptor, Request, Response, bWasSuccessful, this->AttemptsStarted, Timing.QueueSeconds, Timing.TimeToFirstByteSeconds, FPlatformTime::Seconds() - this->StartSeconds);
+			this->OnComplete(Request, Response, bWasSuccessful);
+		}
+	};
+}
+
+void FHttpExecutor::Execute(const FHttpRequestDescriptor& Descriptor, const FHttpCompleteCallback& OnComplete)
+{
+	Execute(Descriptor, FRequestPolicies::GetPolicy(Descriptor.Url), OnComplete);
+}
+
+void FHttpExecutor::Execute(const FHttpRequestDescriptor& Descriptor, const FRequestPolicy& Policy, const FHttpCompleteCallback& OnComplete)
+{
+	const TSharedRef<FHttpRequestDescriptor> Pooled = FHttpRequestPool::Acquire();
+	*Pooled = Descriptor;
+	Execute(Pooled, Policy, OnComplete);
+}
+
+void FHttpExecutor::Execute(const TSharedRef<const FHttpRequestDescriptor>& Descriptor, const FHttpCompleteCallback& OnComplete)
+{
+	Execute(Descriptor, FRequestPolicies::GetPolicy(Descriptor->Url), OnComplete);
+}
+
+void FHttpExecutor::Execute(const TSharedRef<const FHttpRequestDescriptor>& Descriptor, const FRequestPolicy& Policy, const FHttpCompleteCallback& OnComplete)
+{
+	MakeShared<HttpExecutor::FHttpCall>(Descriptor, Policy, OnComplete)->Start();
+}
+
+void FHttpExecutor::ExecuteAndThen(const TSharedRef<const FHttpRequestDescriptor>& Descriptor, const FRequestPolicy& Policy, const TSuccessCallback<FString>& OnSuccess, const FFailureCallback& OnFailure)
+{
+	Execute(Descriptor, Policy, [OnSuccess, OnFailure](FHttpRequestPtr Req, const FHttpResponsePtr& Response, const bool bWasSuccessful)
+	{
+		if (bWasSuccessful)
+		{
+			OnSuccess(FHttpCompression::GetContentAsString(Response));
+		}
+		else
+		{
+			if(Response.IsValid())
+			{
+				OnFailure(FSequenceError(RequestFail, "Request is invalid" + FHttpCompression::GetContentAsString(Response)));
+			}
+			else
+			{
+				OnFailure(FSequenceError(RequestFail, "Request failed: No response received!"));
+			}
+		}
+	});
+}
+
+void FHttpExecutor::ExecuteAndThen(const TSharedRef<const FHttpRequestDescriptor>& Descriptor, const FRequestPolicy& Policy, const TSuccessCallback<FHttpResponsePtr>& OnSuccess, const FFailureCallback& OnFailure)
+{
+	Execute(Descriptor, Policy, [OnSuccess, OnFailure](FHttpRequestPtr Req, const FHttpResponsePtr& Response, const bool bWasSuccessful)
+	{
+		if(bWasSuccessful)
+		{
+			OnSuccess(Response);
+		}
+		else
+		{
+			if(!Response.IsValid())
+				OnFailure(FSequenceError(RequestFail, "The Request is invalid!"));
+			else
+				OnFailure(FSequenceError(RequestFail, "Request failed: " + FHttpCompression::GetContentAsString(Response)));
+		}
+	});
+}
+
+void FHttpRequestDescriptor::Reset()
+{
+	this->Url.Reset();
+	this->Verb = "POST";
+	this->SharedHeaders.Reset();
+	this->Headers.Reset();
+	this->Content.Reset();
+	this->bIdempotent = false;
+	this->Priority = ERequestPriority::Interactive;
+	this->Category = ERequestCategory::Other;
+}
+
+FHttpRequestRef FHttpExecutor::CreateRequest(const FHttpRequestDescriptor& Descriptor, const float TimeoutSeconds)
+{
+	FRequestPolicy Policy;
+	Policy.AttemptTimeoutSeconds = TimeoutSeconds;
+	return CreateRequest(Descriptor, Policy);
+}
+
+FHttpRequestRef FHttpExecutor::CreateRequest(const FHttpRequestDescriptor& Descriptor, const FRequestPolicy& Policy)
+{
+	const FHttpRequestRef Request = FHttpModule::Get().CreateRequest();
+	Request->SetURL(Descriptor.Url);
+	Request->SetVerb(Descriptor.Verb);
+	if (Descriptor.SharedHeaders.IsValid())
+	{
+		for (const TPair<FString, FString>& Header : *Descriptor.SharedHeaders)
+		{
+			Request->SetHeader(Header.Key, Header.Value);
+		}
+	}
+	for (const TPair<FString, FString>& Header : Descriptor.Headers)
+	{
+		Request->SetHeader(Header.Key, Header.Value);
+	}
+	FHttpCompression::EncodeRequest(Request, Descriptor, Policy);
+	Request->SetTimeout(Policy.AttemptTimeoutSeconds);
+	return Request;
+}
+
+bool FHttpExecutor::IsRetryable(const FHttpRequestPtr& Request, const FHttpResponsePtr& Response, const bool bWasSuccessful, const bool bIdempotent)
+{
+	if (bWasSuccessful && Response.IsValid())
+	{
+		switch (Response->GetResponseCode())
+		{
+		case 429:
+			//rejected before the server acted on it, safe to send again
+			return true;
+		case 408:
+		case 500:
+		case 502:
+		case 503:
+		case 504:
+			return bIdempotent;
+		default:
+			return false;
+		}
+	}
+
+	if (!Request.IsValid())
+	{
+		return false;
+	}
+
+	switch (Request->GetFailureReason())
+	{
+	case EHttpFailureReason::ConnectionError:
+		//nothing reached the server, always safe to send again
+		return true;
+	case EHttpFailureReason::Cancelled:
+		return false;
+	default:
+		return bIdempotent;
+	}
+}
+
+TOptional<float> FHttpExecutor::GetLatencyPercentile(const FString& Url, const float Percentile)
+{
+	const HttpExecutor::FLatencySamples* Endpoint = HttpExecutor::Latencies().Find(HttpExecutor::EndpointKey(Url));
+	if (!Endpoint || Endpoint->Samples.Num() < HttpExecutor::MinLatencySamples)
+	{
+		return TOptional<float>();
+	}
+
+	TArray<float> Sorted = Endpoint->Samples;
+	Sorted.Sort();
+	const int32 Index = FMath::Clamp(FMath::CeilToInt(Percentile * Sorted.Num()) - 1, 0, Sorted.Num() - 1);
+	return Sorted[Index];
+}
+
+void FHttpExecutor::RecordLatency(const FString& Url, const float Seconds)
+{
+	HttpExecutor::FLatencySamples& Endpoint = HttpExecutor::Latencies().FindOrAdd(HttpExecutor::EndpointKey(Url));
+	if (Endpoint.Samples.Num() < HttpExecutor::MaxLatencySamples)
+	{
+		Endpoint.Samples.Add(Seconds);
+	}
+	else
+	{
+		Endpoint.Samples[Endpoint.Next] = Seconds;
+	}
+	Endpoint.Next = (Endpoint.Next + 1) % HttpExecutor::MaxLatencySamples;
+}
+
+void FHttpExecutor::ResetLatency()
+{
+	HttpExecutor::Latencies().Empty();
+}
@@ -0,0 +1,98 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+#pragma once
+#include "CoreMinimal.h"
+#include "Interfaces/IHttpRequest.h"
+#include "Interfaces/IHttpResponse.h"
+#include "Util/Async.h"
+#include "Http/RequestPolicy.h"
+#include "Http/RequestScheduler.h"
+#include "Http/RequestTracer.h"
+
+/* Same shape as FHttpRequestCompleteDelegate so existing completion lambdas can be handed over as is */
+using FHttpCompleteCallback = TFunction<void (FHttpRequestPtr, FHttpResponsePtr, bool)>;
+
+using FHttpHeaders = TArray<TPair<FString, FString>>;
+
+/**
+ * Everything needed to (re)create an HTTP request, a new IHttpRequest is built from it for every attempt
+ */
+struct SEQUENCEPLUGIN_API FHttpRequestDescriptor
+{
+	FString Url;
+	FString Verb = "POST";
+
+	/* Prebuilt header set shared between requests (see FHttpHeaderSets), applied before Headers */
+	TSharedPtr<const FHttpHeaders> SharedHeaders;
+	FHttpHeaders Headers;
+	FString Content;
+
+	/*
+	* Idempotent calls (reads) may be retried after the server has seen them and may be hedged,
+	* other calls are only retried when the connection could not be established
+	*/
+	bool bIdempotent = false;
+
+	/* Lane the request waits in when the scheduler is at capacity */
+	ERequestPriority Priority = ERequestPriority::Interactive;
+
+	/* Service the request belongs to, used for trace sampling */
+	ERequestCategory Category = ERequestCategory::Other;
+
+	/*
+	* Restores the defaults while keeping string & array allocations for reuse
+	*/
+	void Reset();
+};
+
+/**
+ * Runs HTTP calls under the FRequestPolicy registered for their url:
+ * per attempt timeouts, retries with exponential backoff and jitter, and hedging of idempotent calls.
+ * Every attempt takes a token from FRateLimiter, then is admitted by FRequestScheduler according to the descriptor's priority.
+ * OnComplete is called exactly once with the winning attempt, or the last attempt if every attempt failed.
+ * Must be used from the game thread.
+ */
+class SEQUENCEPLUGIN_API FHttpExecutor
+{
+public:
+	static void Execute(const FHttpRequestDescriptor& Descriptor, const FHttpCompleteCallback& OnComplete);
+	static void Execute(const FHttpRequestDescriptor& Descriptor, const FRequestPolicy& Policy, const FHttpCompleteCallback& OnComplete);
+
+	/*
+	* Runs a descriptor obtained from FHttpRequestPool without copying it
+	*/
+	static void Execute(const TSharedRef<const FHttpRequestDescriptor>& Descriptor, const FHttpCompleteCallback& OnComplete);
+	static void Execute(const TSharedRef<const FHttpRequestDescriptor>& Descriptor, const FRequestPolicy& Policy, const FHttpCompleteCallback& OnComplete);
+
+	/*
+	* Runs the descriptor and hands the body of any response to OnSuccess, transport failures go to OnFailure
+	*/
+	static void ExecuteAndThen(const TSharedRef<const FHttpRequestDescriptor>& Descriptor, const FRequestPolicy& Policy, const TSuccessCallback<FString>& OnSuccess, const FFailureCallback& OnFailure);
+
+	/*
+	* Runs the descriptor and hands any response to OnSuccess, transport failures go to OnFailure
+	*/
+	static void ExecuteAndThen(const TSharedRef<const FHttpRequestDescriptor>& Descriptor, const FRequestPolicy& Policy, const TSuccessCallback<FHttpResponsePtr>& OnSuccess, const FFailureCallback& OnFailure);
+
+	/*
+	* Builds a single request from the descriptor without any retry logic
+	*/
+	static FHttpRequestRef CreateRequest(const FHttpRequestDescriptor& Descriptor, float TimeoutSeconds);
+
+	/*
+	* Same as above, with the attempt timeout and body compression taken from Policy
+	*/
+	static FHttpRequestRef CreateRequest(const FHttpRequestDescriptor& Descriptor, const FRequestPolicy& Policy);
+
+	/*
+	* @return true if the outcome of an attempt is worth another attempt
+	*/
+	static bool IsRetryable(const FHttpRequestPtr& Request, const FHttpResponsePtr& Response, bool bWasSuccessful, bool bIdempotent);
+
+	/*
+	* Latency samples are kept per endpoint (url without query string) for the most recent calls
+	* @return the requested percentile in seconds, unset while there are too few samples
+	*/
+	static TOptional<float> GetLatencyPercentile(const FString& Url, float Percentile);
+	static void RecordLatency(const FString& Url, float Seconds);
+	static void ResetLatency();
+};
@@ -0,0 +1,90 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+#include "Http/HttpRequestPool.h"
+#include "Misc/ScopeLock.h"
+
+namespace HttpRequestPool
+{
+	static FCriticalSection& Lock()
+	{
+		static FCriticalSection CriticalSection;
+		return CriticalSection;
+	}
+
+	//descriptors are made with MakeShared so the object & its reference controller are one allocation,
+	//a slot is idle when the pool holds its only reference
+	static TArray<TSharedRef<FHttpRequestDescriptor>>& Slots()
+	{
+		static TArray<TSharedRef<FHttpRequestDescriptor>> Descriptors;
+		return Descriptors;
+	}
+
+	static int64 Allocations = 0;
+}
+
+TSharedRef<FHttpRequestDescriptor> FHttpRequestPool::Acquire()
+{
+	FScopeLock ScopeLock(&HttpRequestPool::Lock());
+	for (const TSharedRef<FHttpRequestDescriptor>& Descriptor : HttpRequestPool::Slots())
+	{
+		if (Descriptor.GetSharedReferenceCount() == 1)
+		{
+			Descriptor->Reset();
+			return Descriptor;
+		}
+	}
+
+	HttpRequestPool::Allocations++;
+	const TSharedRef<FHttpRequestDescriptor> Descriptor = MakeShared<FHttpRequestDescriptor>();
+	if (HttpRequestPool::Slots().Num() < MaxPooled)
+	{
+		HttpRequestPool::Slots().Add(Descriptor);
+	}
+	return Descriptor;
+}
+
+int32 FHttpRequestPool::GetPooledCount()
+{
+	FScopeLock ScopeLock(&HttpRequestPool::Lock());
+	int32 Idle = 0;
+	for (const TSharedRef<FHttpRequestDescriptor>& Descriptor : HttpRequestPool::Slots())
+	{
+		if (Descriptor.GetSharedReferenceCount() == 1)
+		{
+			Idle++;
+		}
+	}
+	return Idle;
+}
+
+int64 FHttpRequestPool::GetAllocationCount()
+{
+	FScopeLock ScopeLock(&HttpRequestPool::Lock());
+	return HttpRequestPool::Allocations;
+}
+
+TSharedRef<const FHttpHeaders> FHttpHeaderSets::Json()
+{
+	static const TSharedRef<const FHttpHeaders> Headers = MakeShared<FHttpHeaders>(FHttpHeaders{
+		TPair<FString, FString>("Content-type", "application/json"),
+		TPair<FString, FString>("Accept", "application/json")
+	});
+	return Headers;
+}
+
+TSharedRef<const FHttpHeaders> FHttpHeaderSets::JsonWithAccessKey(const FString& AccessKey)
+{
+	static FCriticalSection CriticalSection;
+	static TMap<FString, TSharedRef<const FHttpHeaders>> ByKey;
+
+	FScopeLock ScopeLock(&CriticalSection);
+	if (const TSharedRef<const FHttpHeaders>* Headers = ByKey.Find(AccessKey))
+	{
+		return *Headers;
+	}
+
+	FHttpHeaders Headers = *Json();
+	Headers.Add(TPair<FString, FString>("X-Access-Key", AccessKey));
+	const TSharedRef<const FHttpHeaders> Set = MakeShared<FHttpHeaders>(MoveTemp(Headers));
+	ByKey.Add(AccessKey, Set);
+	return Set;
+}
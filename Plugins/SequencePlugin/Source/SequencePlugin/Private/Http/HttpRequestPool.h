@@ -0,0 +1,50 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+#pragma once
+#include "CoreMinimal.h"
+#include "Http/HttpExecutor.h"
+
+/**
+ * Recycles request descriptors so their url, header & content buffers are reused between calls.
+ * The pool keeps a reference to each descriptor it hands out, a descriptor is reused once every
+ * other reference is dropped, which for an executed descriptor is when the call completes.
+ * Neither the descriptor nor its shared reference controller is allocated again on reuse,
+ * the IHttpRequest each attempt runs on is still created per attempt.
+ */
+class SEQUENCEPLUGIN_API FHttpRequestPool
+{
+public:
+	/* Descriptors kept around for reuse, any acquired while all of them are in use are freed when released */
+	static constexpr int32 MaxPooled = 64;
+
+	/*
+	* @return a descriptor in its default state, only allocated when every pooled descriptor is in use
+	*/
+	static TSharedRef<FHttpRequestDescriptor> Acquire();
+
+	/*
+	* @return the number of idle descriptors waiting for reuse
+	*/
+	static int32 GetPooledCount();
+
+	/*
+	* @return how many descriptors were ever heap allocated, each counts the descriptor & its reference controller together
+	*/
+	static int64 GetAllocationCount();
+};
+
+/**
+ * Header sets shared by every request to the same kind of endpoint, built once instead of per request
+ */
+class SEQUENCEPLUGIN_API FHttpHeaderSets
+{
+public:
+	/*
+	* Content-type & Accept set to application/json
+	*/
+	static TSharedRef<const FHttpHeaders> Json();
+
+	/*
+	* The Json() headers plus X-Access-Key, one set is kept per key
+	*/
+	static TSharedRef<const FHttpHeaders> JsonWithAccessKey(const FString& AccessKey);
+};
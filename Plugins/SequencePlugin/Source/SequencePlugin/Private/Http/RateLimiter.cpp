@@ -0,0 +1,277 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+#include "Http/RateLimiter.h"
+#include "Containers/Ticker.h"
+#include "Util/Log.h"
+
+FRateLimiter::FRateLimiter()
+{
+}
+
+FRateLimiter& FRateLimiter::Get()
+{
+	static FRateLimiter Limiter;
+	return Limiter;
+}
+
+FString FRateLimiter::BucketKey(const FString& Host, const FString& AccessKey)
+{
+	return Host + "|" + AccessKey;
+}
+
+double FRateLimiter::Now() const
+{
+	return this->Clock ? this->Clock() : FPlatformTime::Seconds();
+}
+
+FRateLimiter::FBucket& FRateLimiter::FindOrAddBucket(const FString& Host, const FString& AccessKey)
+{
+	const FString Key = BucketKey(Host, AccessKey);
+	if (FBucket* Bucket = this->Buckets.Find(Key))
+	{
+		return *Bucket;
+	}
+
+	FBucket& Bucket = this->Buckets.Add(Key);
+	Bucket.Host = Host;
+	Bucket.AccessKey = AccessKey;
+	Bucket.Limit = this->HostLimits.Contains(Host) ? this->HostLimits[Host] : this->DefaultLimit;
+	Bucket.Tokens = Bucket.Limit.Burst;
+	Bucket.RefilledSeconds = this->Now();
+	return Bucket;
+}
+
+void FRateLimiter::Refill(FBucket& Bucket, const double NowSeconds) const
+{
+	//nothing accrues while the server has asked us to back off
+	const double From = FMath::Max(Bucket.RefilledSeconds, Bucket.PausedUntilSeconds);
+	if (NowSeconds > From && Bucket.Limit.RequestsPerSecond > 0.0f)
+	{
+		Bucket.Tokens = FMath::Min(Bucket.Limit.Burst, Bucket.Tokens + static_cast<float>((NowSeconds - From) * Bucket.Limit.RequestsPerSecond));
+	}
+	Bucket.RefilledSeconds = FMath::Max(Bucket.RefilledSeconds, NowSeconds);
+}
+
+float FRateLimiter::TokensNeeded(const FBucket& Bucket, const ERequestPriority Priority)
+{
+	if (Priority != ERequestPriority::Background)
+	{
+		return 1.0f;
+	}
+	return FMath::Clamp(1.0f + Bucket.Limit.BackgroundReserve * Bucket.Limit.Burst, 1.0f, FMath::Max(Bucket.Limit.Burst, 1.0f));
+}
+
+bool FRateLimiter::CanTake(const FBucket& Bucket, const ERequestPriority Priority, const double NowSeconds)
+{
+	if (NowSeconds < Bucket.PausedUntilSeconds)
+	{
+		return false;
+	}
+	return Bucket.Limit.RequestsPerSecond <= 0.0f || Bucket.Tokens >= TokensNeeded(Bucket, Priority);
+}
+
+void FRateLimiter::Drain(FBucket& Bucket, TArray<TFunction<void ()>>& Ready)
+{
+	const double NowSeconds = this->Now();
+	this->Refill(Bucket, NowSeconds);
+
+	//lanes are served in priority order, a lane that has to wait holds back every lane below it
+	for (int32 Priority = 0; Priority < 3; Priority++)
+	{
+		TArray<TFunction<void ()>>& Lane = Bucket.Waiting[Priority];
+		while (Lane.Num() > 0 && CanTake(Bucket, static_cast<ERequestPriority>(Priority), NowSeconds))
+		{
+			Bucket.Tokens = FMath::Max(Bucket.Tokens - 1.0f, 0.0f);
+			Ready.Add(Lane[0]);
+			Lane.RemoveAt(0);
+		}
+
+		if (Lane.Num() > 0)
+		{
+			return;
+		}
+	}
+}
+
+void FRateLimiter::ScheduleWake()
+{
+	const double NowSeconds = this->Now();
+	TOptional<double> Earliest;
+
+	for (TPair<FString, FBucket>& Entry : this->Buckets)
+	{
+		const FBucket& Bucket = Entry.Value;
+		for (int32 Priority = 0; Priority < 3; Priority++)
+		{
+			if (Bucket.Waiting[Priority].Num() == 0)
+			{
+				continue;
+			}
+
+			double At = Bucket.PausedUntilSeconds;
+			if (Bucket.Limit.RequestsPerSecond > 0.0f)
+			{
+				const float Missing = FMath::Max(TokensNeeded(Bucket, static_cast<ERequestPriority>(Priority)) - Bucket.Tokens, 0.0f);
+				At = FMath::Max(At, NowSeconds) + Missing / Bucket.Limit.RequestsPerSecond;
+			}
+			Earliest = FMath::Min(Earliest.Get(At), At);
+			break;
+		}
+	}
+
+	if (!Earliest.IsSet())
+	{
+		return;
+	}
+
+	//an earlier ticker is already pending, it reschedules when it fires
+	if (this->WakeSeconds > 0.0 && this->WakeSeconds <= Earliest.GetValue())
+	{
+		return;
+	}
+
+	this->WakeSeconds = Earliest.GetValue();
+	const TWeakPtr<int32> WeakLifetime = this->Lifetime;
+	const float Delay = static_cast<float>(FMath::Max(Earliest.GetValue() - NowSeconds, 0.0));
+	FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([this, WeakLifetime](float)
+	{
+		if (WeakLifetime.IsValid())
+		{
+			this->WakeSeconds = 0.0;
+			this->Update();
+		}
+		return false;
+	}), Delay);
+}
+
+void FRateLimiter::Update()
+{
+	TArray<TFunction<void ()>> Ready;
+	for (TPair<FString, FBucket>& Entry : this->Buckets)
+	{
+		this->Drain(Entry.Value, Ready);
+	}
+
+	this->ScheduleWake();
+	for (const TFunction<void ()>& Start : Ready)
+	{
+		Start();
+	}
+}
+
+void FRateLimiter::Acquire(const FString& Url, const FString& AccessKey, const ERequestPriority Priority, const TFunction<void ()>& Start)
+{
+	FBucket& Bucket = this->FindOrAddBucket(FRequestScheduler::HostOf(Url), AccessKey);
+	Bucket.Waiting[static_cast<int32>(Priority)].Add(Start);
+
+	//Start may enqueue more attempts, the buckets must not be touched while they run
+	TArray<TFunction<void ()>> Ready;
+	this->Drain(Bucket, Ready);
+	this->ScheduleWake();
+	for (const TFunction<void ()>& ReadyStart : Ready)
+	{
+		ReadyStart();
+	}
+}
+
+void FRateLimiter::OnThrottled(const FString& Url, const FString& AccessKey, const TOptional<float>& RetryAfterSeconds)
+{
+	FBucket& Bucket = this->FindOrAddBucket(FRequestScheduler::HostOf(Url), AccessKey);
+	const double NowSeconds = this->Now();
+	const float Delay = FMath::Clamp(RetryAfterSeconds.Get(DefaultRetryAfterSeconds), 0.0f, 300.0f);
+
+	this->Refill(Bucket, NowSeconds);
+	Bucket.Tokens = 0.0f;
+	Bucket.PausedUntilSeconds = FMath::Max(Bucket.PausedUntilSeconds, NowSeconds + Delay);
+	Bucket.Throttled++;
+	SEQ_LOG(Warning, TEXT("Rate limited by %s, holding requests for %.2fs"), *Bucket.Host, Delay);
+
+	this->ScheduleWake();
+}
+
+void FRateLimiter::SetDefaultLimit(const FRateLimit& Limit)
+{
+	this->DefaultLimit = Limit;
+	for (TPair<FString, FBucket>& Entry : this->Buckets)
+	{
+		if (!this->HostLimits.Contains(Entry.Value.Host))
+		{
+			this->Refill(Entry.Value, this->Now());
+			Entry.Value.Limit = Limit;
+			Entry.Value.Tokens = FMath::Min(Entry.Value.Tokens, Limit.Burst);
+		}
+	}
+	this->Update();
+}
+
+void FRateLimiter::SetHostLimit(const FString& Host, const FRateLimit& Limit)
+{
+	this->HostLimits.Add(Host, Limit);
+	for (TPair<FString, FBucket>& Entry : this->Buckets)
+	{
+		if (Entry.Value.Host == Host)
+		{
+			this->Refill(Entry.Value, this->Now());
+			Entry.Value.Limit = Limit;
+			Entry.Value.Tokens = FMath::Min(Entry.Value.Tokens, Limit.Burst);
+		}
+	}
+	this->Update();
+}
+
+FRateBudget FRateLimiter::ToBudget(FBucket& Bucket, const double NowSeconds) const
+{
+	this->Refill(Bucket, NowSeconds);
+
+	FRateBudget Budget;
+	Budget.Host = Bucket.Host;
+	Budget.AccessKey = Bucket.AccessKey;
+	Budget.Tokens = Bucket.Tokens;
+	Budget.RequestsPerSecond = Bucket.Limit.RequestsPerSecond;
+	Budget.Burst = Bucket.Limit.Burst;
+	Budget.RetryAfterSeconds = static_cast<float>(FMath::Max(Bucket.PausedUntilSeconds - NowSeconds, 0.0));
+	Budget.Queued = Bucket.Waiting[0].Num() + Bucket.Waiting[1].Num() + Bucket.Waiting[2].Num();
+	Budget.Throttled = Bucket.Throttled;
+	return Budget;
+}
+
+FRateBudget FRateLimiter::GetBudget(const FString& Url, const FString& AccessKey)
+{
+	return this->ToBudget(this->FindOrAddBucket(FRequestScheduler::HostOf(Url), AccessKey), this->Now());
+}
+
+TArray<FRateBudget> FRateLimiter::GetBudgets()
+{
+	const double NowSeconds = this->Now();
+	TArray<FRateBudget> Budgets;
+	for (TPair<FString, FBucket>& Entry : this->Buckets)
+	{
+		Budgets.Add(this->ToBudget(Entry.Value, NowSeconds));
+	}
+	return Budgets;
+}
+
+void FRateLimiter::SetClock(const TFunction<double ()>& ClockIn)
+{
+	this->Clock = ClockIn;
+}
+
+TOptional<float> FRateLimiter::ParseRetryAfter(const FString& Value, const FDateTime& Now)
+{
+	const FString Trimmed = Value.TrimStartAndEnd();
+	if (Trimmed.IsEmpty())
+	{
+		return TOptional<float>();
+	}
+
+	if (Trimmed.IsNumeric())
+	{
+		return FMath::Max(FCString::Atof(*Trimmed), 0.0f);
+	}
+
+	FDateTime Date;
+	if (FDateTime::ParseHttpDate(Trimmed, Date))
+	{
+		return static_cast<float>(FMath::Max((Date - Now).GetTotalSeconds(), 0.0));
+	}
+	return TOptional<float>();
+}
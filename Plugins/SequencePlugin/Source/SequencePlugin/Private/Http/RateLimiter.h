@@ -0,0 +1,126 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+#pragma once
+#include "CoreMinimal.h"
+#include "Http/RequestScheduler.h"
+
+/**
+ * Token bucket settings of one host
+ */
+struct SEQUENCEPLUGIN_API FRateLimit
+{
+	/* Tokens added per second, 0 or less disables the limit */
+	float RequestsPerSecond = 20.0f;
+
+	/* Bucket size, the largest burst sent without waiting */
+	float Burst = 40.0f;
+
+	/*
+	* Fraction [0, 1] of the bucket Background requests leave untouched,
+	* so bulk traffic is the first to wait when the budget runs low
+	*/
+	float BackgroundReserve = 0.5f;
+};
+
+/**
+ * Current state of one bucket
+ */
+struct SEQUENCEPLUGIN_API FRateBudget
+{
+	FString Host;
+	FString AccessKey;
+	float Tokens = 0.0f;
+	float RequestsPerSecond = 0.0f;
+	float Burst = 0.0f;
+
+	/* Seconds left before the server accepts requests again, 0 when not throttled */
+	float RetryAfterSeconds = 0.0f;
+	int32 Queued = 0;
+
+	/* 429 responses received so far */
+	int32 Throttled = 0;
+};
+
+/**
+ * Client side rate limiting of HTTP attempts, one token bucket per (host, access key).
+ * Every attempt takes a token before it is handed to FRequestScheduler, attempts that find the bucket
+ * empty wait in priority order until it refills. Background attempts also wait while the bucket is
+ * below its reserve so interactive traffic keeps its budget during bursts.
+ * A 429 empties the bucket and holds every attempt for its Retry-After. Game thread only.
+ */
+class SEQUENCEPLUGIN_API FRateLimiter
+{
+	struct FBucket
+	{
+		FString Host;
+		FString AccessKey;
+		FRateLimit Limit;
+		float Tokens = 0.0f;
+		double RefilledSeconds = 0.0;
+		double PausedUntilSeconds = 0.0;
+		int32 Throttled = 0;
+		TArray<TFunction<void ()>> Waiting[3];
+	};
+
+	TMap<FString, FBucket> Buckets;
+	TMap<FString, FRateLimit> HostLimits;
+	FRateLimit DefaultLimit;
+
+	TFunction<double ()> Clock;
+	/* Time of the earliest pending ticker, 0 when none is pending */
+	double WakeSeconds = 0.0;
+
+	/* Tickers hold a weak reference to this so they die with the limiter */
+	TSharedRef<int32> Lifetime = MakeShared<int32>(0);
+
+	static FString BucketKey(const FString& Host, const FString& AccessKey);
+	double Now() const;
+	FBucket& FindOrAddBucket(const FString& Host, const FString& AccessKey);
+	void Refill(FBucket& Bucket, double NowSeconds) const;
+	static float TokensNeeded(const FBucket& Bucket, ERequestPriority Priority);
+	static bool CanTake(const FBucket& Bucket, ERequestPriority Priority, double NowSeconds);
+	void Drain(FBucket& Bucket, TArray<TFunction<void ()>>& Ready);
+	void ScheduleWake();
+	FRateBudget ToBudget(FBucket& Bucket, double NowSeconds) const;
+public:
+	FRateLimiter();
+
+	static FRateLimiter& Get();
+
+	/*
+	* Runs Start once a token is available for (host of Url, AccessKey), possibly immediately
+	*/
+	void Acquire(const FString& Url, const FString& AccessKey, ERequestPriority Priority, const TFunction<void ()>& Start);
+
+	/*
+	* Holds the bucket after a 429 for the server's Retry-After, or DefaultRetryAfterSeconds without one
+	*/
+	void OnThrottled(const FString& Url, const FString& AccessKey, const TOptional<float>& RetryAfterSeconds);
+
+	void SetDefaultLimit(const FRateLimit& Limit);
+
+	/*
+	* Sets the limit of every bucket of Host, see FRequestScheduler::HostOf
+	*/
+	void SetHostLimit(const FString& Host, const FRateLimit& Limit);
+
+	FRateBudget GetBudget(const FString& Url, const FString& AccessKey);
+	TArray<FRateBudget> GetBudgets();
+
+	/*
+	* Replaces the time source, public so the limiter can be driven in tests without waiting
+	*/
+	void SetClock(const TFunction<double ()>& ClockIn);
+
+	/*
+	* Starts whatever the current time allows, the limiter calls this itself from the core ticker
+	*/
+	void Update();
+
+	static constexpr float DefaultRetryAfterSeconds = 1.0f;
+
+	/*
+	* Parses a Retry-After header, either delay seconds or an HTTP date
+	* @return seconds to wait from Now, unset if the value is neither
+	*/
+	static TOptional<float> ParseRetryAfter(const FString& Value, const FDateTime& Now);
+};
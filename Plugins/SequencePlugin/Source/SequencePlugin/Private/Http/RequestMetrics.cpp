@@ -0,0 +1,356 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+#include "Http/RequestMetrics.h"
+#include "Http/HttpExecutor.h"
+#include "Containers/Ticker.h"
+#include "GenericPlatform/GenericPlatformHttp.h"
+#include "Dom/JsonObject.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "Util/Log.h"
+
+namespace RequestMetrics
+{
+	constexpr double FirstBucketSeconds = 0.001;
+
+	static TMap<FString, FEndpointMetrics>& Endpoints()
+	{
+		static TMap<FString, FEndpointMetrics> ByEndpoint;
+		return ByEndpoint;
+	}
+
+	static FTSTicker::FDelegateHandle& DumpTicker()
+	{
+		static FTSTicker::FDelegateHandle Handle;
+		return Handle;
+	}
+
+	static FString EndpointKey(const FString& Url)
+	{
+		int32 QueryStart = INDEX_NONE;
+		return Url.FindChar(TEXT('?'), QueryStart) ? Url.Left(QueryStart) : Url;
+	}
+
+	/*
+	* @return the top level "method" of a JSON-RPC body, "batch" for a batch, empty if there is none
+	*/
+	static FString RpcMethod(const FString& Content)
+	{
+		const TSharedRef<TJsonReader<TCHAR>> Reader = TJsonReaderFactory<TCHAR>::Create(Content);
+		int32 Depth = 0;
+		EJsonNotation Notation;
+		while (Reader->ReadNext(Notation))
+		{
+			switch (Notation)
+			{
+			case EJsonNotation::ArrayStart:
+				if (Depth == 0)
+				{
+					return "batch";
+				}
+				Depth++;
+				break;
+			case EJsonNotation::ObjectStart:
+				Depth++;
+				break;
+			case EJsonNotation::ArrayEnd:
+			case EJsonNotation::ObjectEnd:
+				Depth--;
+				break;
+			case EJsonNotation::String:
+				if (Depth == 1 && Reader->GetIdentifier() == TEXT("method"))
+				{
+					return Reader->GetValueAsString();
+				}
+				break;
+			default:
+				break;
+			}
+		}
+		return "";
+	}
+
+	/*
+	* Rpc calls all go to one url so they are told apart by method, media urls are unique per asset so they are grouped by host
+	*/
+	static FString EndpointKey(const FHttpRequestDescriptor& Descriptor)
+	{
+		switch (Descriptor.Category)
+		{
+		case ERequestCategory::Media:
+			return "media:" + FGenericPlatformHttp::GetUrlDomain(Descriptor.Url);
+		case ERequestCategory::Rpc:
+			{
+				const FString Method = RpcMethod(Descriptor.Content);
+				return Method.IsEmpty() ? EndpointKey(Descriptor.Url) : EndpointKey(Descriptor.Url) + "#" + Method;
+			}
+		default:
+			return EndpointKey(Descriptor.Url);
+		}
+	}
+
+	static double Milliseconds(const double Seconds)
+	{
+		return Seconds * 1000.0;
+	}
+
+	static FString StatusCodesToString(const TMap<int32, int32>& StatusCodes)
+	{
+		TArray<int32> Codes;
+		StatusCodes.GenerateKeyArray(Codes);
+		Codes.Sort();
+
+		FString Out;
+		for (const int32 Code : Codes)
+		{
+			Out += FString::Printf(TEXT("%s%d:%d"), Out.IsEmpty() ? TEXT("") : TEXT(";"), Code, StatusCodes[Code]);
+		}
+		return Out;
+	}
+
+	static TSharedRef<FJsonObject> HistogramToJson(const FMetricHistogram& Histogram)
+	{
+		const TSharedRef<FJsonObject> Json = MakeShared<FJsonObject>();
+		Json->SetNumberField(TEXT("count"), Histogram.Count);
+		Json->SetNumberField(TEXT("meanMs"), Milliseconds(Histogram.GetMean()));
+		Json->SetNumberField(TEXT("p50Ms"), Milliseconds(Histogram.GetPercentile(0.5f)));
+		Json->SetNumberField(TEXT("p95Ms"), Milliseconds(Histogram.GetPercentile(0.95f)));
+		Json->SetNumberField(TEXT("p99Ms"), Milliseconds(Histogram.GetPercentile(0.99f)));
+		Json->SetNumberField(TEXT("maxMs"), Milliseconds(Histogram.Max));
+
+		TArray<TSharedPtr<FJsonValue>> Buckets;
+		for (const int32 Bucket : Histogram.Buckets)
+		{
+			Buckets.Add(MakeShared<FJsonValueNumber>(Bucket));
+		}
+		Json->SetArrayField(TEXT("buckets"), Buckets);
+		return Json;
+	}
+}
+
+void FMetricHistogram::Add(const double Seconds)
+{
+	const double Clamped = FMath::Max(Seconds, 0.0);
+	int32 Bucket = 0;
+	while (Bucket < BucketCount - 1 && Clamped > GetBucketUpperBound(Bucket))
+	{
+		Bucket++;
+	}
+
+	this->Buckets[Bucket]++;
+	this->Min = this->Count == 0 ? Clamped : FMath::Min(this->Min, Clamped);
+	this->Max = this->Count == 0 ? Clamped : FMath::Max(this->Max, Clamped);
+	this->Sum += Clamped;
+	this->Count++;
+}
+
+double FMetricHistogram::GetMean() const
+{
+	return this->Count > 0 ? this->Sum / this->Count : 0.0;
+}
+
+double FMetricHistogram::GetPercentile(const float Percentile) const
+{
+	if (this->Count == 0)
+	{
+		return 0.0;
+	}
+
+	const int32 Rank = FMath::Clamp(FMath::CeilToInt(Percentile * this->Count), 1, this->Count);
+	int32 Seen = 0;
+	for (int32 Bucket = 0; Bucket < BucketCount; Bucket++)
+	{
+		Seen += this->Buckets[Bucket];
+		if (Seen >= Rank)
+		{
+			return FMath::Min(GetBucketUpperBound(Bucket), this->Max);
+		}
+	}
+	return this->Max;
+}
+
+double FMetricHistogram::GetBucketUpperBound(const int32 Bucket)
+{
+	return RequestMetrics::FirstBucketSeconds * static_cast<double>(1ll << Bucket);
+}
+
+void FRequestMetrics::Record(const FHttpRequestDescriptor& Descriptor, const FHttpRequestPtr& Request, const FHttpResponsePtr& Response, const bool bSucceeded, const int32 Attempts, const double QueueSeconds, const TOptional<double> TimeToFirstByteSeconds, const double TotalSeconds)
+{
+	FString Key = RequestMetrics::EndpointKey(Descriptor);
+	FEndpointMetrics* Metrics = RequestMetrics::Endpoints().Find(Key);
+	if (!Metrics)
+	{
+		//unbounded url spaces (asset ids, query like paths) must not grow the registry forever
+		if (RequestMetrics::Endpoints().Num() >= MaxEndpoints)
+		{
+			Key = OverflowEndpoint;
+			Metrics = RequestMetrics::Endpoints().Find(Key);
+		}
+		if (!Metrics)
+		{
+			Metrics = &RequestMetrics::Endpoints().Add(Key);
+			Metrics->Endpoint = Key;
+		}
+	}
+
+	const int32 StatusCode = Response.IsValid() ? Response->GetResponseCode() : 0;
+	Metrics->Category = Descriptor.Category;
+	Metrics->Calls++;
+	Metrics->Retries += FMath::Max(Attempts - 1, 0);
+	if (!bSucceeded || StatusCode < 200 || StatusCode >= 300)
+	{
+		Metrics->Errors++;
+	}
+	Metrics->StatusCodes.FindOrAdd(StatusCode)++;
+	Metrics->BytesOut += Request.IsValid() ? static_cast<int64>(Request->GetContentLength()) : 0;
+	Metrics->BytesIn += Response.IsValid() ? static_cast<int64>(Response->GetContentLength()) : 0;
+	Metrics->QueueTime.Add(QueueSeconds);
+	if (TimeToFirstByteSeconds.IsSet())
+	{
+		Metrics->TimeToFirstByte.Add(TimeToFirstByteSeconds.GetValue());
+	}
+	Metrics->TotalTime.Add(TotalSeconds);
+}
+
+FString FRequestMetrics::GetEndpointKey(const FHttpRequestDescriptor& Descriptor)
+{
+	return RequestMetrics::EndpointKey(Descriptor);
+}
+
+TOptional<FEndpointMetrics> FRequestMetrics::GetEndpoint(const FString& Endpoint)
+{
+	const FEndpointMetrics* Metrics = RequestMetrics::Endpoints().Find(RequestMetrics::EndpointKey(Endpoint));
+	return Metrics ? *Metrics : TOptional<FEndpointMetrics>();
+}
+
+TArray<FEndpointMetrics> FRequestMetrics::GetSnapshot()
+{
+	TArray<FEndpointMetrics> Snapshot;
+	RequestMetrics::Endpoints().GenerateValueArray(Snapshot);
+	Snapshot.Sort([](const FEndpointMetrics& A, const FEndpointMetrics& B)
+	{
+		return A.Endpoint < B.Endpoint;
+	});
+	return Snapshot;
+}
+
+void FRequestMetrics::Reset()
+{
+	RequestMetrics::Endpoints().Empty();
+}
+
+FString FRequestMetrics::ToCsv()
+{
+	FString Csv = "endpoint,category,calls,errors,retries,bytes_out,bytes_in,queue_p50_ms,queue_p95_ms,ttfb_p50_ms,ttfb_p95_ms,total_mean_ms,total_p50_ms,total_p95_ms,total_p99_ms,total_max_ms,status_codes\n";
+	for (const FEndpointMetrics& Metrics : GetSnapshot())
+	{
+		Csv += FString::Printf(TEXT("%s,%s,%d,%d,%d,%lld,%lld,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f,%s\n"),
+			*Metrics.Endpoint,
+			*GetCategoryName(Metrics.Category),
+			Metrics.Calls,
+			Metrics.Errors,
+			Metrics.Retries,
+			Metrics.BytesOut,
+			Metrics.BytesIn,
+			RequestMetrics::Milliseconds(Metrics.QueueTime.GetPercentile(0.5f)),
+			RequestMetrics::Milliseconds(Metrics.QueueTime.GetPercentile(0.95f)),
+			RequestMetrics::Milliseconds(Metrics.TimeToFirstByte.GetPercentile(0.5f)),
+			RequestMetrics::Milliseconds(Metrics.TimeToFirstByte.GetPercentile(0.95f)),
+			RequestMetrics::Milliseconds(Metrics.TotalTime.GetMean()),
+			RequestMetrics::Milliseconds(Metrics.TotalTime.GetPercentile(0.5f)),
+			RequestMetrics::Milliseconds(Metrics.TotalTime.GetPercentile(0.95f)),
+			RequestMetrics::Milliseconds(Metrics.TotalTime.GetPercentile(0.99f)),
+			RequestMetrics::Milliseconds(Metrics.TotalTime.Max),
+			*RequestMetrics::StatusCodesToString(Metrics.StatusCodes));
+	}
+	return Csv;
+}
+
+FString FRequestMetrics::ToJson()
+{
+	TArray<TSharedPtr<FJsonValue>> Endpoints;
+	for (const FEndpointMetrics& Metrics : GetSnapshot())
+	{
+		const TSharedRef<FJsonObject> Json = MakeShared<FJsonObject>();
+		Json->SetStringField(TEXT("endpoint"), Metrics.Endpoint);
+		Json->SetStringField(TEXT("category"), GetCategoryName(Metrics.Category));
+		Json->SetNumberField(TEXT("calls"), Metrics.Calls);
+		Json->SetNumberField(TEXT("errors"), Metrics.Errors);
+		Json->SetNumberField(TEXT("retries"), Metrics.Retries);
+		Json->SetNumberField(TEXT("bytesOut"), Metrics.BytesOut);
+		Json->SetNumberField(TEXT("bytesIn"), Metrics.BytesIn);
+		Json->SetObjectField(TEXT("queueTime"), RequestMetrics::HistogramToJson(Metrics.QueueTime));
+		Json->SetObjectField(TEXT("timeToFirstByte"), RequestMetrics::HistogramToJson(Metrics.TimeToFirstByte));
+		Json->SetObjectField(TEXT("totalTime"), RequestMetrics::HistogramToJson(Metrics.TotalTime));
+
+		const TSharedRef<FJsonObject> StatusCodes = MakeShared<FJsonObject>();
+		for (const TPair<int32, int32>& Status : Metrics.StatusCodes)
+		{
+			StatusCodes->SetNumberField(FString::FromInt(Status.Key), Status.Value);
+		}
+		Json->SetObjectField(TEXT("statusCodes"), StatusCodes);
+		Endpoints.Add(MakeShared<FJsonValueObject>(Json));
+	}
+
+	const TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+	Root->SetStringField(TEXT("timestamp"), FDateTime::UtcNow().ToIso8601());
+	Root->SetArrayField(TEXT("endpoints"), Endpoints);
+
+	FString Out;
+	FJsonSerializer::Serialize(Root, TJsonWriterFactory<>::Create(&Out));
+	return Out;
+}
+
+FString FRequestMetrics::Dump(const EMetricsDumpFormat Format)
+{
+	const bool bJson = Format == EMetricsDumpFormat::Json;
+	const FString FileName = FString::Printf(TEXT("metrics-%s.%s"), *FDateTime::UtcNow().ToString(TEXT("%Y%m%d-%H%M%S")), bJson ? TEXT("json") : TEXT("csv"));
+	const FString Path = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Sequence"), TEXT("Metrics"), FileName);
+
+	if (!FFileHelper::SaveStringToFile(bJson ? ToJson() : ToCsv(), *Path))
+	{
+		SEQ_LOG(Warning, TEXT("Failed to write metrics to %s"), *Path);
+		return "";
+	}
+	return Path;
+}
+
+void FRequestMetrics::StartPeriodicDump(const float IntervalSeconds, const EMetricsDumpFormat Format)
+{
+	StopPeriodicDump();
+	RequestMetrics::DumpTicker() = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([Format](float)
+	{
+		Dump(Format);
+		return true;
+	}), FMath::Max(IntervalSeconds, 1.0f));
+}
+
+void FRequestMetrics::StopPeriodicDump()
+{
+	if (RequestMetrics::DumpTicker().IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(RequestMetrics::DumpTicker());
+		RequestMetrics::DumpTicker().Reset();
+	}
+}
+
+FString FRequestMetrics::GetCategoryName(const ERequestCategory Category)
+{
+	switch (Category)
+	{
+	case ERequestCategory::Rpc:
+		return "Rpc";
+	case ERequestCategory::Indexer:
+		return "Indexer";
+	case ERequestCategory::Marketplace:
+		return "Marketplace";
+	case ERequestCategory::Waas:
+		return "Waas";
+	case ERequestCategory::Media:
+		return "Media";
+	default:
+		return "Other";
+	}
+}
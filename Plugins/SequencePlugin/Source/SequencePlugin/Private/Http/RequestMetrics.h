@@ -0,0 +1,115 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+#pragma once
+#include "CoreMinimal.h"
+#include "Interfaces/IHttpRequest.h"
+#include "Interfaces/IHttpResponse.h"
+#include "Http/RequestTracer.h"
+
+struct FHttpRequestDescriptor;
+
+/**
+ * Log scale histogram of durations in seconds, bucket N holds samples up to 1ms * 2^N
+ */
+struct SEQUENCEPLUGIN_API FMetricHistogram
+{
+	static constexpr int32 BucketCount = 18;
+
+	int32 Buckets[BucketCount] = {};
+	int32 Count = 0;
+	double Sum = 0.0;
+	double Min = 0.0;
+	double Max = 0.0;
+
+	void Add(double Seconds);
+	double GetMean() const;
+
+	/*
+	* @return the upper bound of the bucket holding the requested percentile, capped at Max
+	*/
+	double GetPercentile(float Percentile) const;
+
+	static double GetBucketUpperBound(int32 Bucket);
+};
+
+/**
+ * Everything recorded for one endpoint: the url without query string, plus the method for Rpc calls
+ * ("url#eth_call") and only the host for Media ("media:host")
+ */
+struct SEQUENCEPLUGIN_API FEndpointMetrics
+{
+	FString Endpoint;
+	ERequestCategory Category = ERequestCategory::Other;
+	int32 Calls = 0;
+	int32 Errors = 0;
+	/* Attempts beyond the first one, hedges included */
+	int32 Retries = 0;
+	int64 BytesOut = 0;
+	int64 BytesIn = 0;
+	/* Time the winning attempt waited in the scheduler */
+	FMetricHistogram QueueTime;
+	/* Winning attempt from being sent until its response headers arrived */
+	FMetricHistogram TimeToFirstByte;
+	/* Whole call including retries and backoff */
+	FMetricHistogram TotalTime;
+	/* Calls per HTTP status, 0 counts calls that got no response */
+	TMap<int32, int32> StatusCodes;
+};
+
+enum class EMetricsDumpFormat : uint8
+{
+	Csv,
+	Json
+};
+
+/**
+ * Registry of per endpoint latency, throughput and error metrics for every call run by FHttpExecutor.
+ * Can be queried at any time, or dumped to Saved/Sequence/Metrics as CSV or JSON once or periodically.
+ * Game thread only.
+ */
+class SEQUENCEPLUGIN_API FRequestMetrics
+{
+public:
+	/* Endpoints tracked separately, calls to further endpoints are all recorded under OverflowEndpoint */
+	static constexpr int32 MaxEndpoints = 256;
+	static constexpr const TCHAR* OverflowEndpoint = TEXT("(other)");
+
+	/*
+	* Called by FHttpExecutor once per completed call
+	*/
+	static void Record(const FHttpRequestDescriptor& Descriptor, const FHttpRequestPtr& Request, const FHttpResponsePtr& Response, bool bSucceeded, int32 Attempts, double QueueSeconds, TOptional<double> TimeToFirstByteSeconds, double TotalSeconds);
+
+	/*
+	* @return the key the call described by Descriptor is recorded under
+	*/
+	static FString GetEndpointKey(const FHttpRequestDescriptor& Descriptor);
+
+	/*
+	* @param Endpoint A key from GetEndpointKey, or the url of an endpoint that is keyed by url alone
+	* @return the metrics of the endpoint, unset if nothing was recorded for it
+	*/
+	static TOptional<FEndpointMetrics> GetEndpoint(const FString& Endpoint);
+
+	/*
+	* @return the metrics of every endpoint, sorted by endpoint
+	*/
+	static TArray<FEndpointMetrics> GetSnapshot();
+
+	static void Reset();
+
+	static FString ToCsv();
+	static FString ToJson();
+
+	/*
+	* Writes the current metrics to Saved/Sequence/Metrics
+	* @return the path written to, empty if the file could not be written
+	*/
+	static FString Dump(EMetricsDumpFormat Format);
+
+	/*
+	* Dumps every IntervalSeconds until StopPeriodicDump, replaces any running periodic dump
+	*/
+	static void StartPeriodicDump(float IntervalSeconds, EMetricsDumpFormat Format);
+	static void StopPeriodicDump();
+
+	static FString GetCategoryName(ERequestCategory Category);
+};
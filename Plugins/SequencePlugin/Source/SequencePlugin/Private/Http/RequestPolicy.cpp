@@ -0,0 +1,84 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+#include "Http/RequestPolicy.h"
+#include "Misc/ScopeLock.h"
+
+float FRequestPolicy::GetBackoffSeconds(const int32 Retry, const float Random) const
+{
+	const int32 Exponent = FMath::Clamp(Retry - 1, 0, 30);
+	const float Backoff = FMath::Min(this->BaseBackoffSeconds * static_cast<float>(1 << Exponent), this->MaxBackoffSeconds);
+	const float Jitter = FMath::Clamp(this->JitterFraction, 0.0f, 1.0f) * FMath::Clamp(Random, 0.0f, 1.0f);
+	return FMath::Max(Backoff * (1.0f - Jitter), 0.0f);
+}
+
+float FRequestPolicy::GetHedgeDelaySeconds(const TOptional<float>& P95Seconds) const
+{
+	if (this->HedgeDelaySeconds > 0.0f)
+	{
+		return this->HedgeDelaySeconds;
+	}
+
+	return P95Seconds.IsSet() ? P95Seconds.GetValue() : this->FallbackHedgeDelaySeconds;
+}
+
+namespace RequestPolicies
+{
+	static FCriticalSection& Lock()
+	{
+		static FCriticalSection CriticalSection;
+		return CriticalSection;
+	}
+
+	static FRequestPolicy& Default()
+	{
+		static FRequestPolicy Policy;
+		return Policy;
+	}
+
+	static TMap<FString, FRequestPolicy>& ByPrefix()
+	{
+		static TMap<FString, FRequestPolicy> Policies;
+		return Policies;
+	}
+}
+
+void FRequestPolicies::SetDefaultPolicy(const FRequestPolicy& Policy)
+{
+	FScopeLock ScopeLock(&RequestPolicies::Lock());
+	RequestPolicies::Default() = Policy;
+}
+
+FRequestPolicy FRequestPolicies::GetDefaultPolicy()
+{
+	FScopeLock ScopeLock(&RequestPolicies::Lock());
+	return RequestPolicies::Default();
+}
+
+void FRequestPolicies::SetPolicy(const FString& UrlPrefix, const FRequestPolicy& Policy)
+{
+	FScopeLock ScopeLock(&RequestPolicies::Lock());
+	RequestPolicies::ByPrefix().Add(UrlPrefix, Policy);
+}
+
+void FRequestPolicies::ClearPolicy(const FString& UrlPrefix)
+{
+	FScopeLock ScopeLock(&RequestPolicies::Lock());
+	RequestPolicies::ByPrefix().Remove(UrlPrefix);
+}
+
+FRequestPolicy FRequestPolicies::GetPolicy(const FString& Url)
+{
+	FScopeLock ScopeLock(&RequestPolicies::Lock());
+
+	const FRequestPolicy* Best = nullptr;
+	int32 BestLength = -1;
+	for (const TPair<FString, FRequestPolicy>& Entry : RequestPolicies::ByPrefix())
+	{
+		if (Entry.Key.Len() > BestLength && Url.StartsWith(Entry.Key))
+		{
+			Best = &Entry.Value;
+			BestLength = Entry.Key.Len();
+		}
+	}
+
+	return Best ? *Best : RequestPolicies::Default();
+}
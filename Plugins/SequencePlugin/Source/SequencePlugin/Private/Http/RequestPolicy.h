@@ -0,0 +1,79 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+#pragma once
+#include "CoreMinimal.h"
+
+/**
+ * How a single HTTP call is attempted: how many times, how long each attempt may take,
+ * how long to wait between attempts and whether an idempotent call may be hedged.
+ */
+struct SEQUENCEPLUGIN_API FRequestPolicy
+{
+	/* Total attempts including the first one, 1 disables retries */
+	int32 MaxAttempts = 3;
+
+	/* Timeout applied to every individual attempt */
+	float AttemptTimeoutSeconds = 15.0f;
+
+	/* Backoff before retry N is BaseBackoffSeconds * 2^(N-1), capped at MaxBackoffSeconds */
+	float BaseBackoffSeconds = 0.25f;
+	float MaxBackoffSeconds = 4.0f;
+
+	/* Fraction [0, 1] of the backoff that is randomised so clients don't retry in lock step */
+	float JitterFraction = 0.5f;
+
+	/*
+	* When set, idempotent calls that have not completed after the hedge delay get a second
+	* copy sent, whichever returns first wins and the other is cancelled
+	*/
+	bool bHedge = false;
+
+	/* Fixed hedge delay, 0 or less uses the observed p95 latency of the endpoint */
+	float HedgeDelaySeconds = 0.0f;
+
+	/* Hedge delay used while the endpoint has too few latency samples for a p95 */
+	float FallbackHedgeDelaySeconds = 1.0f;
+
+	/* Advertise gzip through Accept-Encoding, responses that still arrive encoded are decoded by FHttpCompression */
+	bool bAcceptCompressed = false;
+
+	/*
+	* Request bodies of at least this many bytes are sent gzip compressed, 0 disables.
+	* Only enable for servers that accept Content-Encoding: gzip on requests
+	*/
+	int32 CompressRequestsAboveBytes = 0;
+
+	/*
+	* @param Retry 1 for the first retry, 2 for the second...
+	* @param Random uniform random value in [0, 1] used for jitter
+	* @return seconds to wait before sending the retry
+	*/
+	float GetBackoffSeconds(int32 Retry, float Random) const;
+
+	/*
+	* @param P95Seconds observed p95 latency of the endpoint if known
+	* @return seconds to wait before hedging a call
+	*/
+	float GetHedgeDelaySeconds(const TOptional<float>& P95Seconds) const;
+};
+
+/**
+ * Registry of request policies keyed by url prefix (usually scheme + host).
+ * The policy with the longest prefix matching a url wins, urls without a match use the default policy.
+ */
+class SEQUENCEPLUGIN_API FRequestPolicies
+{
+public:
+	static void SetDefaultPolicy(const FRequestPolicy& Policy);
+	static FRequestPolicy GetDefaultPolicy();
+
+	/*
+	* Sets the policy used for every url starting with UrlPrefix
+	*/
+	static void SetPolicy(const FString& UrlPrefix, const FRequestPolicy& Policy);
+	static void ClearPolicy(const FString& UrlPrefix);
+
+	/*
+	* @return the policy to use for Url
+	*/
+	static FRequestPolicy GetPolicy(const FString& Url);
+};
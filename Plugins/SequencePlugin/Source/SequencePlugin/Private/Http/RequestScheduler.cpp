@@ -0,0 +1,166 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+#include "Http/RequestScheduler.h"
+#include "GenericPlatform/GenericPlatformHttp.h"
+
+FRequestScheduler& FRequestScheduler::Get()
+{
+	static FRequestScheduler Scheduler;
+	return Scheduler;
+}
+
+FString FRequestScheduler::HostOf(const FString& Url)
+{
+	return FGenericPlatformHttp::GetUrlDomain(Url);
+}
+
+bool FRequestScheduler::HasCapacity(const ERequestPriority Priority, const FString& Host) const
+{
+	switch (Priority)
+	{
+	case ERequestPriority::Critical:
+		//critical requests only answer to the global cap, the reserved slots guarantee room under it
+		return this->InFlight < this->GlobalLimit;
+	case ERequestPriority::Interactive:
+		return this->InFlight < this->GlobalLimit - this->ReservedCriticalSlots
+			&& this->InFlightByHost.FindRef(Host) < this->HostLimit;
+	default:
+		return this->InFlight < this->GlobalLimit - this->ReservedCriticalSlots
+			&& this->Lanes[static_cast<int32>(ERequestPriority::Background)].InFlight < this->BackgroundLimit
+			&& this->InFlightByHost.FindRef(Host) < this->HostLimit;
+	}
+}
+
+bool FRequestScheduler::DispatchOne(const ERequestPriority Priority)
+{
+	FLane& Lane = this->Lanes[static_cast<int32>(Priority)];
+	const int32 HostCount = Lane.HostOrder.Num();
+
+	for (int32 Offset = 0; Offset < HostCount; Offset++)
+	{
+		const int32 HostIndex = (Lane.NextHost + Offset) % HostCount;
+		const FString Host = Lane.HostOrder[HostIndex];
+		if (!this->HasCapacity(Priority, Host))
+		{
+			continue;
+		}
+
+		TArray<FQueuedRequest>& Queue = Lane.ByHost.FindChecked(Host);
+		const FQueuedRequest Request = Queue[0];
+		Queue.RemoveAt(0);
+		Lane.Queued--;
+
+		if (Queue.Num() == 0)
+		{
+			Lane.ByHost.Remove(Host);
+			Lane.HostOrder.RemoveAt(HostIndex);
+			Lane.NextHost = Lane.HostOrder.Num() > 0 ? HostIndex % Lane.HostOrder.Num() : 0;
+		}
+		else
+		{
+			Lane.NextHost = (HostIndex + 1) % Lane.HostOrder.Num();
+		}
+
+		Lane.InFlight++;
+		this->InFlight++;
+		this->InFlightByHost.FindOrAdd(Host)++;
+		Request.Start();
+		return true;
+	}
+	return false;
+}
+
+void FRequestScheduler::Dispatch()
+{
+	//Start may complete synchronously and release, the outer loop picks up whatever that freed
+	if (this->bDispatching)
+	{
+		return;
+	}
+	this->bDispatching = true;
+
+	bool bStarted = true;
+	while (bStarted)
+	{
+		bStarted = false;
+		for (int32 Priority = 0; Priority < 3 && !bStarted; Priority++)
+		{
+			bStarted = this->DispatchOne(static_cast<ERequestPriority>(Priority));
+		}
+	}
+
+	this->bDispatching = false;
+}
+
+void FRequestScheduler::Enqueue(const FString& Url, const ERequestPriority Priority, const TFunction<void ()>& Start)
+{
+	const FString Host = HostOf(Url);
+	FLane& Lane = this->Lanes[static_cast<int32>(Priority)];
+
+	TArray<FQueuedRequest>* Queue = Lane.ByHost.Find(Host);
+	if (!Queue)
+	{
+		Queue = &Lane.ByHost.Add(Host);
+		Lane.HostOrder.Add(Host);
+	}
+	Queue->Add({Host, Start});
+	Lane.Queued++;
+
+	this->Dispatch();
+}
+
+void FRequestScheduler::Release(const FString& Url, const ERequestPriority Priority)
+{
+	const FString Host = HostOf(Url);
+	if (int32* HostInFlight = this->InFlightByHost.Find(Host))
+	{
+		if (--(*HostInFlight) <= 0)
+		{
+			this->InFlightByHost.Remove(Host);
+		}
+	}
+
+	FLane& Lane = this->Lanes[static_cast<int32>(Priority)];
+	Lane.InFlight = FMath::Max(Lane.InFlight - 1, 0);
+	this->InFlight = FMath::Max(this->InFlight - 1, 0);
+
+	this->Dispatch();
+}
+
+void FRequestScheduler::SetGlobalLimit(const int32 Limit)
+{
+	this->GlobalLimit = FMath::Max(Limit, 1);
+	this->Dispatch();
+}
+
+void FRequestScheduler::SetHostLimit(const int32 Limit)
+{
+	this->HostLimit = FMath::Max(Limit, 1);
+	this->Dispatch();
+}
+
+void FRequestScheduler::SetBackgroundLimit(const int32 Limit)
+{
+	this->BackgroundLimit = FMath::Max(Limit, 1);
+	this->Dispatch();
+}
+
+void FRequestScheduler::SetReservedCriticalSlots(const int32 Slots)
+{
+	this->ReservedCriticalSlots = FMath::Clamp(Slots, 0, this->GlobalLimit - 1);
+	this->Dispatch();
+}
+
+int32 FRequestScheduler::GetInFlight() const
+{
+	return this->InFlight;
+}
+
+int32 FRequestScheduler::GetInFlight(const ERequestPriority Priority) const
+{
+	return this->Lanes[static_cast<int32>(Priority)].InFlight;
+}
+
+int32 FRequestScheduler::GetQueued(const ERequestPriority Priority) const
+{
+	return this->Lanes[static_cast<int32>(Priority)].Queued;
+}
@@ -0,0 +1,79 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+#pragma once
+#include "CoreMinimal.h"
+
+/**
+ * Priority class of an HTTP request, lower values are dispatched first
+ */
+enum class ERequestPriority : uint8
+{
+	//Auth & transaction intents, never queued behind other traffic
+	Critical = 0,
+	//Reads the user is waiting on
+	Interactive = 1,
+	//Prefetching, images and other bulk traffic
+	Background = 2,
+};
+
+/**
+ * Central gate every HTTP attempt passes through before it is sent.
+ * Requests wait in one lane per priority, lanes are drained in priority order and within a lane
+ * hosts are served round robin so one busy host can't starve the others.
+ * Concurrency is capped globally and per host, Background traffic has its own lower cap and
+ * a few slots are held back that only Critical requests may use. Game thread only.
+ */
+class SEQUENCEPLUGIN_API FRequestScheduler
+{
+	struct FQueuedRequest
+	{
+		FString Host;
+		TFunction<void ()> Start;
+	};
+
+	struct FLane
+	{
+		TMap<FString, TArray<FQueuedRequest>> ByHost;
+		TArray<FString> HostOrder;
+		int32 NextHost = 0;
+		int32 Queued = 0;
+		int32 InFlight = 0;
+	};
+
+	FLane Lanes[3];
+	TMap<FString, int32> InFlightByHost;
+	int32 InFlight = 0;
+
+	int32 GlobalLimit = 16;
+	int32 HostLimit = 6;
+	int32 BackgroundLimit = 4;
+	int32 ReservedCriticalSlots = 2;
+	bool bDispatching = false;
+
+	bool HasCapacity(ERequestPriority Priority, const FString& Host) const;
+	bool DispatchOne(ERequestPriority Priority);
+	void Dispatch();
+public:
+	static FRequestScheduler& Get();
+
+	static FString HostOf(const FString& Url);
+
+	/*
+	* Queues Start to run once the request fits under the caps, possibly immediately.
+	* Every started request must be matched by a call to Release with the same Url
+	*/
+	void Enqueue(const FString& Url, ERequestPriority Priority, const TFunction<void ()>& Start);
+
+	/*
+	* Frees the slot held by a finished request and starts whatever can run next
+	*/
+	void Release(const FString& Url, ERequestPriority Priority);
+
+	void SetGlobalLimit(int32 Limit);
+	void SetHostLimit(int32 Limit);
+	void SetBackgroundLimit(int32 Limit);
+	void SetReservedCriticalSlots(int32 Slots);
+
+	int32 GetInFlight() const;
+	int32 GetInFlight(ERequestPriority Priority) const;
+	int32 GetQueued(ERequestPriority Priority) const;
+};
@@ -0,0 +1,249 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+#include "Http/RequestTracer.h"
+#include "Http/HttpExecutor.h"
+#include "Interfaces/IHttpRequest.h"
+#include "Util/Log.h"
+#include <atomic>
+
+namespace RequestTracer
+{
+	constexpr int32 CategoryCount = static_cast<int32>(ERequestCategory::Count);
+
+	struct FSlot
+	{
+		/* odd while the record is being written */
+		std::atomic<uint32> Sequence{0};
+		FRequestTraceRecord Record;
+	};
+
+	static FSlot Slots[FRequestTracer::Capacity];
+
+	/* records written since the last reset, the next one goes to Slots[Written % Capacity] */
+	static std::atomic<uint64> Written{0};
+
+	struct FState
+	{
+		float SampleRates[CategoryCount];
+		TMap<int32, FRequestTraceSink> Sinks;
+		int32 NextHandle = 1;
+		bool bLogSink = false;
+		bool bLogBody = false;
+	};
+
+	static FState& State()
+	{
+		static FState Current = []()
+		{
+			FState Initial;
+			for (float& Rate : Initial.SampleRates)
+			{
+				Rate = 1.0f;
+			}
+			Initial.bLogSink = WITH_EDITOR;
+			return Initial;
+		}();
+		return Current;
+	}
+
+	template<int32 Size>
+	static void CopyTruncated(ANSICHAR (&Destination)[Size], const FString& Source)
+	{
+		const int32 Length = FMath::Min(Source.Len(), Size - 1);
+		for (int32 i = 0; i < Length; i++)
+		{
+			const TCHAR Char = Source[i];
+			Destination[i] = Char < 128 ? static_cast<ANSICHAR>(Char) : '?';
+		}
+		Destination[Length] = '\0';
+	}
+
+	static FString FindHeader(const FHttpRequestDescriptor& Descriptor, const FString& Name)
+	{
+		for (const TPair<FString, FString>& Header : Descriptor.Headers)
+		{
+			if (Header.Key.Equals(Name, ESearchCase::IgnoreCase))
+			{
+				return Header.Value;
+			}
+		}
+
+		if (Descriptor.SharedHeaders.IsValid())
+		{
+			for (const TPair<FString, FString>& Header : *Descriptor.SharedHeaders)
+			{
+				if (Header.Key.Equals(Name, ESearchCase::IgnoreCase))
+				{
+					return Header.Value;
+				}
+			}
+		}
+		return "";
+	}
+
+	static void LogSink(const FRequestTraceEvent& Event, const bool bIncludeBody)
+	{
+#if WITH_EDITOR
+		if (LogSequenceEditor.IsSuppressed(ELogVerbosity::Log))
+		{
+			return;
+		}
+
+		SEQ_LOG_EDITOR(Log, TEXT("curl -X %s \"%s\" -H \"Content-Type: application/json\" -H \"Accept: application/json\" -H \"X-Access-Key: %s\" --data \"%s\""),
+			*Event.Descriptor.Verb,
+			*Event.Descriptor.Url,
+			*FindHeader(Event.Descriptor, "X-Access-Key"),
+			*Event.Descriptor.Content.Replace(TEXT("\""), TEXT("\\\"")));
+
+		SEQ_LOG_EDITOR(Log, TEXT("%s %s -> %d in %.0f ms, %d attempt(s), %lld bytes"),
+			*Event.Descriptor.Verb,
+			*Event.Descriptor.Url,
+			Event.Record.StatusCode,
+			Event.Record.TotalSeconds * 1000.0f,
+			Event.Record.Attempts,
+			Event.Record.ResponseBytes);
+
+		if (bIncludeBody && Event.Response.IsValid())
+		{
+			SEQ_LOG_EDITOR(Log, TEXT("%s"), *Event.Response->GetContentAsString());
+		}
+#endif
+	}
+}
+
+FString FRequestTraceRecord::GetVerb() const
+{
+	return FString(this->Verb);
+}
+
+FString FRequestTraceRecord::GetUrl() const
+{
+	return FString(this->Url);
+}
+
+void FRequestTracer::SetSampleRate(const ERequestCategory Category, const float Rate)
+{
+	RequestTracer::State().SampleRates[static_cast<int32>(Category)] = FMath::Clamp(Rate, 0.0f, 1.0f);
+}
+
+float FRequestTracer::GetSampleRate(const ERequestCategory Category)
+{
+	return RequestTracer::State().SampleRates[static_cast<int32>(Category)];
+}
+
+int32 FRequestTracer::AddSink(const FRequestTraceSink& Sink)
+{
+	RequestTracer::FState& State = RequestTracer::State();
+	const int32 Handle = State.NextHandle++;
+	State.Sinks.Add(Handle, Sink);
+	return Handle;
+}
+
+void FRequestTracer::RemoveSink(const int32 Handle)
+{
+	RequestTracer::State().Sinks.Remove(Handle);
+}
+
+bool FRequestTracer::HasSinks()
+{
+	const RequestTracer::FState& State = RequestTracer::State();
+	return State.bLogSink || State.Sinks.Num() > 0;
+}
+
+void FRequestTracer::SetLogSinkEnabled(const bool bEnabled, const bool bIncludeBody)
+{
+	RequestTracer::FState& State = RequestTracer::State();
+	State.bLogSink = bEnabled;
+	State.bLogBody = bIncludeBody;
+}
+
+void FRequestTracer::Trace(const FHttpRequestDescriptor& Descriptor, const FHttpRequestPtr& Request, const FHttpResponsePtr& Response, const bool bSucceeded, const int32 Attempts, const double StartSeconds, const float QueueSeconds)
+{
+	RequestTracer::FState& State = RequestTracer::State();
+	const float Rate = State.SampleRates[static_cast<int32>(Descriptor.Category)];
+	if (Rate <= 0.0f || (Rate < 1.0f && FMath::FRand() >= Rate))
+	{
+		return;
+	}
+
+	const uint64 Index = RequestTracer::Written.load(std::memory_order_relaxed);
+
+	FRequestTraceRecord Record;
+	Record.Id = Index + 1;
+	Record.Category = Descriptor.Category;
+	RequestTracer::CopyTruncated(Record.Verb, Descriptor.Verb);
+	RequestTracer::CopyTruncated(Record.Url, Descriptor.Url);
+	Record.StatusCode = Response.IsValid() ? Response->GetResponseCode() : 0;
+	Record.Attempts = Attempts;
+	Record.bSucceeded = bSucceeded;
+	Record.RequestBytes = Request.IsValid() ? static_cast<int64>(Request->GetContentLength()) : 0;
+	Record.ResponseBytes = Response.IsValid() ? static_cast<int64>(Response->GetContentLength()) : 0;
+	Record.StartSeconds = StartSeconds;
+	Record.QueueSeconds = QueueSeconds;
+	Record.TotalSeconds = static_cast<float>(FPlatformTime::Seconds() - StartSeconds);
+
+	RequestTracer::FSlot& Slot = RequestTracer::Slots[Index % Capacity];
+	const uint32 Sequence = Slot.Sequence.load(std::memory_order_relaxed);
+	Slot.Sequence.store(Sequence + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	Slot.Record = Record;
+	Slot.Sequence.store(Sequence + 2, std::memory_order_release);
+	RequestTracer::Written.store(Index + 1, std::memory_order_release);
+
+	if (!HasSinks())
+	{
+		return;
+	}
+
+	const FRequestTraceEvent Event{ Record, Descriptor, Response };
+	if (State.bLogSink)
+	{
+		RequestTracer::LogSink(Event, State.bLogBody);
+	}
+
+	//a sink may remove itself while being called
+	TArray<FRequestTraceSink> Sinks;
+	State.Sinks.GenerateValueArray(Sinks);
+	for (const FRequestTraceSink& Sink : Sinks)
+	{
+		Sink(Event);
+	}
+}
+
+void FRequestTracer::GetRecent(TArray<FRequestTraceRecord>& OutRecords, const int32 MaxRecords)
+{
+	OutRecords.Reset();
+	const uint64 Written = RequestTracer::Written.load(std::memory_order_acquire);
+	const int32 Count = static_cast<int32>(FMath::Min<uint64>(Written, FMath::Min(MaxRecords, Capacity)));
+	OutRecords.Reserve(Count);
+
+	for (int32 i = 0; i < Count; i++)
+	{
+		const RequestTracer::FSlot& Slot = RequestTracer::Slots[(Written - 1 - i) % Capacity];
+		const uint32 Before = Slot.Sequence.load(std::memory_order_acquire);
+		if (Before & 1)
+		{
+			continue;
+		}
+
+		const FRequestTraceRecord Copy = Slot.Record;
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (Slot.Sequence.load(std::memory_order_relaxed) != Before)
+		{
+			continue;
+		}
+		OutRecords.Add(Copy);
+	}
+}
+
+void FRequestTracer::Reset()
+{
+	RequestTracer::FState& State = RequestTracer::State();
+	for (float& Rate : State.SampleRates)
+	{
+		Rate = 1.0f;
+	}
+	State.Sinks.Empty();
+	State.bLogSink = false;
+	State.bLogBody = false;
+	RequestTracer::Written.store(0, std::memory_order_release);
+}
@@ -0,0 +1,110 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+#pragma once
+#include "CoreMinimal.h"
+#include "Interfaces/IHttpRequest.h"
+#include "Interfaces/IHttpResponse.h"
+
+struct FHttpRequestDescriptor;
+
+/**
+ * Which SDK service issued a request, used for trace sampling and metrics
+ */
+enum class ERequestCategory : uint8
+{
+	Rpc = 0,
+	Indexer,
+	Marketplace,
+	Waas,
+	Media,
+	Other,
+	Count
+};
+
+/**
+ * Fixed size record of one completed HTTP call, cheap to copy and safe to read while being overwritten
+ */
+struct SEQUENCEPLUGIN_API FRequestTraceRecord
+{
+	static constexpr int32 MaxUrlLength = 160;
+
+	uint64 Id = 0;
+	ERequestCategory Category = ERequestCategory::Other;
+	ANSICHAR Verb[8] = {};
+	/* Truncated to MaxUrlLength - 1 characters */
+	ANSICHAR Url[MaxUrlLength] = {};
+	int32 StatusCode = 0;
+	int32 Attempts = 0;
+	bool bSucceeded = false;
+	int64 RequestBytes = 0;
+	int64 ResponseBytes = 0;
+	/* FPlatformTime::Seconds() when the call was started */
+	double StartSeconds = 0.0;
+	/* Time the winning attempt waited in the scheduler */
+	float QueueSeconds = 0.0f;
+	/* Start of the call until its completion, including retries & backoff */
+	float TotalSeconds = 0.0f;
+
+	FString GetVerb() const;
+	FString GetUrl() const;
+};
+
+/**
+ * Everything a sink gets to see, Descriptor & Response are only valid during the callback
+ */
+struct FRequestTraceEvent
+{
+	const FRequestTraceRecord& Record;
+	const FHttpRequestDescriptor& Descriptor;
+	const FHttpResponsePtr& Response;
+};
+
+using FRequestTraceSink = TFunction<void (const FRequestTraceEvent&)>;
+
+/**
+ * Structured tracing of completed HTTP calls.
+ * Each category is sampled at its own rate, sampled calls land in a ring buffer of recent
+ * records and are handed to every registered sink. Nothing is formatted by the tracer itself,
+ * sinks (like the log sink, which rebuilds the curl command) only run when registered.
+ * Records are written from the game thread only, GetRecent may be called from any thread:
+ * each slot is guarded by a sequence counter so readers never block the writer and
+ * simply skip slots that were overwritten mid read.
+ */
+class SEQUENCEPLUGIN_API FRequestTracer
+{
+public:
+	static constexpr int32 Capacity = 256;
+
+	/*
+	* @param Rate fraction [0, 1] of calls in Category that are traced, 1 by default
+	*/
+	static void SetSampleRate(ERequestCategory Category, float Rate);
+	static float GetSampleRate(ERequestCategory Category);
+
+	/*
+	* @return handle for RemoveSink
+	*/
+	static int32 AddSink(const FRequestTraceSink& Sink);
+	static void RemoveSink(int32 Handle);
+	static bool HasSinks();
+
+	/*
+	* Logs each traced call as a curl command followed by its outcome to LogSequenceEditor,
+	* with bIncludeBody the response body is logged as well. On by default in editor builds
+	*/
+	static void SetLogSinkEnabled(bool bEnabled, bool bIncludeBody = false);
+
+	/*
+	* Called by FHttpExecutor once per completed call
+	*/
+	static void Trace(const FHttpRequestDescriptor& Descriptor, const FHttpRequestPtr& Request, const FHttpResponsePtr& Response, bool bSucceeded, int32 Attempts, double StartSeconds, float QueueSeconds);
+
+	/*
+	* Copies up to MaxRecords of the most recent records, newest first
+	*/
+	static void GetRecent(TArray<FRequestTraceRecord>& OutRecords, int32 MaxRecords = Capacity);
+
+	/*
+	* Drops every record and sink, restores full sampling and turns the log sink off
+	*/
+	static void Reset();
+};
@@ -8,6 +8,10 @@
 #include "Util/SequenceSupport.h"
 #include "HttpManager.h"
 #include "Util/Log.h"
+#include "Util/InFlightRequests.h"
+#include "Http/HttpRequestPool.h"
+#include "Http/HttpCompression.h"
+#include "Types/BinaryData.h"
 
 UIndexer::UIndexer(){}
 
@@ -40,62 +44,68 @@ FString UIndexer::HostName(const int64 ChainID)
 
 /*
 	Here we construct a post request and parse out a response if valid.
-*/void UIndexer::HTTPPost(const int64& ChainID, const FString& Endpoint, const FString& Args, const TSuccessCallback<FString>& OnSuccess, const FFailureCallback& OnFailure) const
+*/void UIndexer::HTTPPost(const int64& ChainID, const FString& Endpoint, const FString& Args, const TSuccessCallback<TSharedPtr<FJsonObject>>& OnSuccess, const FFailureCallback& OnFailure) const
+{
+	HTTPPost(ChainID, Endpoint, Args, false, [OnSuccess](const FIndexerFetchedResponse& Response)
+	{
+		OnSuccess(Response.Json);
+	}, OnFailure);
+}
+
+void UIndexer::HTTPPost(const int64& ChainID, const FString& Endpoint, const FString& Args, const bool bKeepBody, const TSuccessCallback<FIndexerFetchedResponse>& OnSuccess, const FFailureCallback& OnFailure) const
 {
 	const FString Url = *this->Url(ChainID, Endpoint);
-	const TSharedRef<IHttpRequest> HTTP_Post_Req = FHttpModule::Get().CreateRequest();
 	FString AccessKey = UConfigFetcher::GetConfigVar(UConfigFetcher::ProjectAccessKey);
 
-	HTTP_Post_Req->SetVerb("POST");
-	HTTP_Post_Req->SetHeader("Content-Type", "application/json"); // Two differing headers for the request
-	HTTP_Post_Req->SetHeader("Accept", "application/json");
-	HTTP_Post_Req->SetHeader("X-Access-Key", AccessKey);
-	HTTP_Post_Req->SetTimeout(30);
-	HTTP_Post_Req->SetURL(Url);
-	HTTP_Post_Req->SetContentAsString(Args);
-
-	FString CurlCommand = FString::Printf(
-		TEXT("curl -X %s \"%s\" -H \"Content-Type: application/json\" -H \"Accept: application/json\" -H \"X-Access-Key: %s\" --data \"%s\""),
-		*HTTP_Post_Req->GetVerb(),
-		*HTTP_Post_Req->GetURL(),
-		*HTTP_Post_Req->GetHeader("X-Access-Key"),
-		*FString::Printf(TEXT("%s"), *FString(UTF8_TO_TCHAR(HTTP_Post_Req->GetContent().GetData())).Replace(TEXT("\""), TEXT("\\\"")))
-	);
-	SEQ_LOG_EDITOR(Log, TEXT("%s"), *CurlCommand);
-
-	HTTP_Post_Req->OnProcessRequestComplete().BindLambda([OnSuccess, OnFailure](const FHttpRequestPtr& Request, FHttpResponsePtr Response, const bool bWasSuccessful)
+	const TSharedRef<FHttpRequestDescriptor> Descriptor = FHttpRequestPool::Acquire();
+	Descriptor->Url = Url;
+	Descriptor->SharedHeaders = FHttpHeaderSets::JsonWithAccessKey(AccessKey);
+	Descriptor->Content = Args;
+	Descriptor->bIdempotent = true;
+	Descriptor->Category = ERequestCategory::Indexer;
+
+	FHttpExecutor::Execute(Descriptor, [bKeepBody, OnSuccess, OnFailure](const FHttpRequestPtr& Request, FHttpResponsePtr Response, const bool bWasSuccessful)
 		{
 			if (bWasSuccessful && Response.IsValid())
 			{
 				const int32 ResponseCode = Response->GetResponseCode();
-				const FString Content = Response->GetContentAsString();
-
-				SEQ_LOG_EDITOR(Log, TEXT("%s"), *Response->GetContentAsString());
+				TArray<uint8> Decoded;
+				const TArray<uint8>& Content = FHttpCompression::GetContent(Response, Decoded);
 
 				if (ResponseCode >= 200 && ResponseCode < 300 )
 				{
-					TSharedPtr<FJsonObject> JsonResponse;
-					if (FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Content), JsonResponse) && JsonResponse->HasField(TEXT("error")))
+					//token balance and history pages can run to megabytes, so the body is parsed as UTF-8 in place
+					const TSharedPtr<FJsonObject> JsonResponse = URPCCaller::Parse(Content);
+					if (!JsonResponse)
+					{
+						OnFailure(FSequenceError(ResponseParseError, "Failed to parse response: " + UTF8BytesToString(Content)));
+					}
+					else if (JsonResponse->HasField(TEXT("error")))
 					{
 						const FString ErrorMessage = JsonResponse->GetStringField(TEXT("error"));
 						OnFailure(FSequenceError(RequestFail, "API Error: " + ErrorMessage));
 					}
 					else
 					{
-						OnSuccess(Content);
+						FIndexerFetchedResponse Fetched;
+						Fetched.Json = JsonResponse;
+						if (bKeepBody)
+						{
+							Fetched.Body = UTF8BytesToString(Content);
+						}
+						OnSuccess(Fetched);
 					}
 				}
 				else
 				{
-					OnFailure(FSequenceError(RequestFail, FString::Printf(TEXT("HTTP Error: %d. Response: %s"), ResponseCode, *Content)));
+					OnFailure(FSequenceError(RequestFail, FString::Printf(TEXT("HTTP Error: %d. Response: %s"), ResponseCode, *UTF8BytesToString(Content))));
 				}
 			}
 			else
 			{
 				if (Request.IsValid() && Response.IsValid())
 				{
-					const FString Content = Response->GetContentAsString();
-					OnFailure(FSequenceError(RequestFail, "Request failed: " + Content));
+					OnFailure(FSequenceError(RequestFail, "Request failed: " + FHttpCompression::GetContentAsString(Response)));
 				}
 				else
 				{
@@ -103,8 +113,6 @@ FString UIndexer::HostName(const int64 ChainID)
 				}
 			}
 		});
-
-	HTTP_Post_Req->ProcessRequest();
 }
 
 /*
@@ -130,19 +138,11 @@ template < typename T> FString UIndexer::BuildArgs(T StructIn)
 }
 
 //generic
-template<typename T> T UIndexer::BuildResponse(const FString Text)
+template<typename T> T UIndexer::BuildResponse(const TSharedPtr<FJsonObject>& JSON_Step)
 {
-	//Take the FString and convert it to a JSON object first!
-	TSharedPtr<FJsonObject> JSON_Step;
-	//Then take the json object we make and convert it to a USTRUCT of type T then we return that!
+	//take the json object and convert it to a USTRUCT of type T then we return that!
 	T Ret_Struct;
 
-	if (!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Text), JSON_Step))
-	{
-		UE_LOG(LogTemp, Display, TEXT("Failed to convert String: %s to Json object"), *Text);
-		return T();
-	}
-
 	//this next line with throw an exception in null is used as an entry in json attributes! we need to remove null entries
 	if (Ret_Struct.customConstructor) 
 	{//use the custom constructor!
@@ -152,7 +152,7 @@ template<typename T> T UIndexer::BuildResponse(const FString Text)
 	{//use unreal parsing!
 		if (!FJsonObjectConverter::JsonObjectToUStruct<T>(JSON_Step.ToSharedRef(), &Ret_Struct))
 		{
-			UE_LOG(LogTemp, Display, TEXT("Failed to convert Json Object: %s to USTRUCT of type T"), *Text);
+			UE_LOG(LogTemp, Display, TEXT("Failed to convert Json Object to USTRUCT of type T"));
 			return T();
 		}
 	}
@@ -160,82 +160,262 @@ template<typename T> T UIndexer::BuildResponse(const FString Text)
 	return Ret_Struct;
 }
 
+template<typename T> void UIndexer::HTTPPostAndBuild(const int64& ChainID, const FString& Endpoint, const FString& Args, const TSuccessCallback<T>& OnSuccess, const FFailureCallback& OnFailure)
+{
+	static TInFlightRequests<T> InFlight;
+	const FString Key = this->Url(ChainID, Endpoint) + Args;
+
+	if (InFlight.Join(Key, OnSuccess, OnFailure))
+	{
+		return;
+	}
+
+	HTTPPost(ChainID, Endpoint, Args, [this, Key](const TSharedPtr<FJsonObject>& Json)
+	{
+		InFlight.Resolve(Key, this->BuildResponse<T>(Json));
+	}, [Key](const FSequenceError& Error)
+	{
+		InFlight.Reject(Key, Error);
+	});
+}
+
+template<typename T> void UIndexer::HTTPPostCached(const int64& ChainID, const FString& Endpoint, const FString& Args, const TSuccessCallback<T>& OnSuccess, const TSuccessCallback<T>& OnUpdate, const FFailureCallback& OnFailure)
+{
+	FIndexerCache& Cache = FIndexerCache::Get();
+	const FIndexerCachePolicy Policy = Cache.GetPolicy(Endpoint);
+	if (!Policy.IsEnabled())
+	{
+		HTTPPostAndBuild<T>(ChainID, Endpoint, Args, OnSuccess, OnFailure);
+		return;
+	}
+
+	const FString Key = FIndexerCache::MakeKey(ChainID, Endpoint, Args);
+	const FIndexerCacheHit Hit = Cache.Find(Key, Policy);
+	if (Hit.State == EIndexerCacheLookup::Fresh)
+	{
+		OnSuccess(this->BuildResponse<T>(Hit.Response));
+		return;
+	}
+
+	if (Hit.State == EIndexerCacheLookup::Stale)
+	{
+		OnSuccess(this->BuildResponse<T>(Hit.Response));
+		FetchForCache(ChainID, Endpoint, Args, Key, [this, Hit, OnUpdate](const FIndexerFetchedResponse& Response)
+		{
+			if (OnUpdate && Response.Body != Hit.Response)
+			{
+				OnUpdate(this->BuildResponse<T>(Response.Json));
+			}
+		}, [Key](const FSequenceError& Error)
+		{
+			SEQ_LOG(Verbose, TEXT("Revalidating %s failed, keeping the cached response: %s"), *Key, *Error.Message);
+		});
+		return;
+	}
+
+	FetchForCache(ChainID, Endpoint, Args, Key, [this, OnSuccess](const FIndexerFetchedResponse& Response)
+	{
+		OnSuccess(this->BuildResponse<T>(Response.Json));
+	}, [this, Key, Hit, OnSuccess, OnFailure](const FSequenceError& Error)
+	{
+		if (Hit.State == EIndexerCacheLookup::Miss)
+		{
+			OnFailure(Error);
+			return;
+		}
+		SEQ_LOG(Warning, TEXT("Serving an expired response for %s: %s"), *Key, *Error.Message);
+		OnSuccess(this->BuildResponse<T>(Hit.Response));
+	});
+}
+
+void UIndexer::FetchForCache(const int64& ChainID, const FString& Endpoint, const FString& Args, const FString& Key, const TSuccessCallback<FIndexerFetchedResponse>& OnSuccess, const FFailureCallback& OnFailure) const
+{
+	static TInFlightRequests<FIndexerFetchedResponse> InFlight;
+	if (InFlight.Join(Key, OnSuccess, OnFailure))
+	{
+		return;
+	}
+
+	HTTPPost(ChainID, Endpoint, Args, true, [Key](const FIndexerFetchedResponse& Response)
+	{
+		FIndexerCache::Get().Store(Key, Response.Body);
+		InFlight.Resolve(Key, Response);
+	}, [Key](const FSequenceError& Error)
+	{
+		InFlight.Reject(Key, Error);
+	});
+}
+
+void UIndexer::SetCachePolicy(const FString& Endpoint, const float FreshSeconds, const float StaleSeconds)
+{
+	FIndexerCache::Get().SetPolicy(Endpoint, FIndexerCachePolicy(FreshSeconds, StaleSeconds));
+}
+
+void UIndexer::ClearCache()
+{
+	FIndexerCache::Get().Clear();
+}
+
+void UIndexer::InvalidateBalances(const int64 ChainID)
+{
+	FIndexerCache::Get().Invalidate(ChainID, "GetEtherBalance");
+	FIndexerCache::Get().Invalidate(ChainID, "GetTokenBalances");
+}
+
 void UIndexer::Ping(const int64 ChainID, TSuccessCallback<bool> OnSuccess, const FFailureCallback& OnFailure)
 {
-	HTTPPost(ChainID, "Ping", "", [this,OnSuccess](const FString& Content) {
-		OnSuccess(this->BuildResponse<FSeqPingReturn>(Content).status);
+	HTTPPostAndBuild<FSeqPingReturn>(ChainID, "Ping", "", [OnSuccess](const FSeqPingReturn& Response)
+	{
+		OnSuccess(Response.status);
 	}, OnFailure);
 }
 
 void UIndexer::Version(const int64 ChainID, TSuccessCallback<FSeqVersion> OnSuccess, const FFailureCallback& OnFailure)
 {
-	HTTPPost(ChainID, "Version", "", [this,OnSuccess](const FString& Content)
+	Version(ChainID, OnSuccess, nullptr, OnFailure);
+}
+
+void UIndexer::Version(const int64 ChainID, TSuccessCallback<FSeqVersion> OnSuccess, TSuccessCallback<FSeqVersion> OnUpdate, const FFailureCallback& OnFailure)
+{
+	HTTPPostCached<FSeqVersionReturn>(ChainID, "Version", "", [OnSuccess](const FSeqVersionReturn& Response)
 	{
-		OnSuccess(this->BuildResponse<FSeqVersionReturn>(Content).version);
+		OnSuccess(Response.version);
+	}, [OnUpdate](const FSeqVersionReturn& Response)
+	{
+		if (OnUpdate)
+		{
+			OnUpdate(Response.version);
+		}
 	}, OnFailure);
 }
 
 void UIndexer::RunTimeStatus(const int64 ChainID, TSuccessCallback<FSeqRuntimeStatus> OnSuccess, const FFailureCallback& OnFailure)
 {
-	HTTPPost(ChainID, "RuntimeStatus", "", [this,OnSuccess](const FString& Content)
+	RunTimeStatus(ChainID, OnSuccess, nullptr, OnFailure);
+}
+
+void UIndexer::RunTimeStatus(const int64 ChainID, TSuccessCallback<FSeqRuntimeStatus> OnSuccess, TSuccessCallback<FSeqRuntimeStatus> OnUpdate, const FFailureCallback& OnFailure)
+{
+	HTTPPostCached<FSeqRuntimeStatusReturn>(ChainID, "RuntimeStatus", "", [OnSuccess](const FSeqRuntimeStatusReturn& Response)
 	{
-		OnSuccess(this->BuildResponse<FSeqRuntimeStatusReturn>(Content).status);
+		OnSuccess(Response.status);
+	}, [OnUpdate](const FSeqRuntimeStatusReturn& Response)
+	{
+		if (OnUpdate)
+		{
+			OnUpdate(Response.status);
+		}
 	}, OnFailure);
 }
 
 void UIndexer::GetChainID(const int64 ChainID, TSuccessCallback<int64> OnSuccess, const FFailureCallback& OnFailure)
 {
-	HTTPPost(ChainID, "GetChainID", "", [this,OnSuccess](const FString& Content)
+	HTTPPostAndBuild<FSeqGetChainIDReturn>(ChainID, "GetChainID", "", [OnSuccess](const FSeqGetChainIDReturn& Response)
 	{
-		OnSuccess(this->BuildResponse<FSeqGetChainIDReturn>(Content).chainID);
+		OnSuccess(Response.chainID);
 	}, OnFailure);
 }
 
 void UIndexer::GetEtherBalance(const int64 ChainID, FString AccountAddr, TSuccessCallback<FSeqEtherBalance> OnSuccess, const FFailureCallback& OnFailure)
+{
+	GetEtherBalance(ChainID, AccountAddr, OnSuccess, nullptr, OnFailure);
+}
+
+void UIndexer::GetEtherBalance(const int64 ChainID, FString AccountAddr, TSuccessCallback<FSeqEtherBalance> OnSuccess, TSuccessCallback<FSeqEtherBalance> OnUpdate, const FFailureCallback& OnFailure)
 {//since we are given a raw accountAddress we compose the json arguments here to put in the request manually
 	FString JSON_Arg = "{\"accountAddress\":\"";
 	JSON_Arg.Append(AccountAddr);
 	JSON_Arg.Append("\"}");
 
-	HTTPPost(ChainID, "GetEtherBalance", JSON_Arg, [this,OnSuccess](const FString& Content)
+	HTTPPostCached<FSeqGetEtherBalanceReturn>(ChainID, "GetEtherBalance", JSON_Arg, [OnSuccess](const FSeqGetEtherBalanceReturn& Response)
 	{
-		const FSeqGetEtherBalanceReturn Response = this->BuildResponse<FSeqGetEtherBalanceReturn>(Content);
 		OnSuccess(Response.balance);
+	}, [OnUpdate](const FSeqGetEtherBalanceReturn& Response)
+	{
+		if (OnUpdate)
+		{
+			OnUpdate(Response.balance);
+		}
 	}, OnFailure);
 }
 
 void UIndexer::GetTokenBalances(const int64 ChainID, const FSeqGetTokenBalancesArgs& Args, TSuccessCallback<FSeqGetTokenBalancesReturn> OnSuccess, const FFailureCallback& OnFailure)
+{
+	GetTokenBalances(ChainID, Args, OnSuccess, nullptr, OnFailure);
+}
+
+void UIndexer::GetTokenBalances(const int64 ChainID, const FSeqGetTokenBalancesArgs& Args, TSuccessCallback<FSeqGetTokenBalancesReturn> OnSuccess, TSuccessCallback<FSeqGetTokenBalancesReturn> OnUpdate, const FFailureCallback& OnFailure)
 {
 	const FString Endpoint = "GetTokenBalances";
-	HTTPPost(ChainID, Endpoint, BuildArgs<FSeqGetTokenBalancesArgs>(Args), [this,OnSuccess](const FString& Content)
-	{
-		const FSeqGetTokenBalancesReturn Response = this->BuildResponse<FSeqGetTokenBalancesReturn>(Content);
-		OnSuccess(Response);
-	}, OnFailure);
+	HTTPPostCached<FSeqGetTokenBalancesReturn>(ChainID, Endpoint, BuildArgs<FSeqGetTokenBalancesArgs>(Args), OnSuccess, OnUpdate, OnFailure);
 }
 
 void UIndexer::GetTokenSupplies(const int64 ChainID, const FSeqGetTokenSuppliesArgs& Args, TSuccessCallback<FSeqGetTokenSuppliesReturn> OnSuccess, const FFailureCallback& OnFailure)
 {
-	HTTPPost(ChainID, "GetTokenSupplies", BuildArgs<FSeqGetTokenSuppliesArgs>(Args), [this,OnSuccess](const FString& Content)
-	{
-		OnSuccess(this->BuildResponse<FSeqGetTokenSuppliesReturn>(Content));
-	}, OnFailure);
+	GetTokenSupplies(ChainID, Args, OnSuccess, nullptr, OnFailure);
+}
+
+void UIndexer::GetTokenSupplies(const int64 ChainID, const FSeqGetTokenSuppliesArgs& Args, TSuccessCallback<FSeqGetTokenSuppliesReturn> OnSuccess, TSuccessCallback<FSeqGetTokenSuppliesReturn> OnUpdate, const FFailureCallback& OnFailure)
+{
+	HTTPPostCached<FSeqGetTokenSuppliesReturn>(ChainID, "GetTokenSupplies", BuildArgs<FSeqGetTokenSuppliesArgs>(Args), OnSuccess, OnUpdate, OnFailure);
 }
 
 void UIndexer::GetTokenSuppliesMap(const int64 ChainID, const FSeqGetTokenSuppliesMapArgs& Args, TSuccessCallback<FSeqGetTokenSuppliesMapReturn> OnSuccess, const FFailureCallback& OnFailure)
 {
-	HTTPPost(ChainID, "GetTokenSuppliesMap", BuildArgs<FSeqGetTokenSuppliesMapArgs>(Args), [this,OnSuccess](const FString& Content)
-	{
-		OnSuccess(this->BuildResponse<FSeqGetTokenSuppliesMapReturn>(Content));
-	}, OnFailure);
+	GetTokenSuppliesMap(ChainID, Args, OnSuccess, nullptr, OnFailure);
+}
+
+void UIndexer::GetTokenSuppliesMap(const int64 ChainID, const FSeqGetTokenSuppliesMapArgs& Args, TSuccessCallback<FSeqGetTokenSuppliesMapReturn> OnSuccess, TSuccessCallback<FSeqGetTokenSuppliesMapReturn> OnUpdate, const FFailureCallback& OnFailure)
+{
+	HTTPPostCached<FSeqGetTokenSuppliesMapReturn>(ChainID, "GetTokenSuppliesMap", BuildArgs<FSeqGetTokenSuppliesMapArgs>(Args), OnSuccess, OnUpdate, OnFailure);
 }
 
 void UIndexer::GetTransactionHistory(const int64 ChainID, const FSeqGetTransactionHistoryArgs& Args, TSuccessCallback<FSeqGetTransactionHistoryReturn> OnSuccess, const FFailureCallback& OnFailure)
 {
-	HTTPPost(ChainID, "GetTransactionHistory", BuildArgs<FSeqGetTransactionHistoryArgs>(Args), [this,OnSuccess](const FString& Content)
+	HTTPPostAndBuild<FSeqGetTransactionHistoryReturn>(ChainID, "GetTransactionHistory", BuildArgs<FSeqGetTransactionHistoryArgs>(Args), OnSuccess, OnFailure);
+}
+
+TSharedRef<FTokenBalancesIterator> UIndexer::IterateTokenBalances(const int64 ChainID, const FSeqGetTokenBalancesArgs& Args)
+{
+	const TWeakObjectPtr<UIndexer> WeakThis(this);
+	return MakeShared<FTokenBalancesIterator>(Args, &FSeqGetTokenBalancesReturn::balances, [WeakThis, ChainID](const FSeqGetTokenBalancesArgs& PageArgs)
 	{
-		OnSuccess(this->BuildResponse<FSeqGetTransactionHistoryReturn>(Content));
-	}, OnFailure);
+		return SeqFuture::FromCallback<FSeqGetTokenBalancesReturn>([WeakThis, ChainID, PageArgs](const TSuccessCallback<FSeqGetTokenBalancesReturn>& OnSuccess, const FFailureCallback& OnFailure)
+		{
+			if (UIndexer* Indexer = WeakThis.Get())
+			{
+				Indexer->GetTokenBalances(ChainID, PageArgs, OnSuccess, OnFailure);
+			}
+			else
+			{
+				OnFailure(FSequenceError(RequestFail, "Indexer was destroyed while paging"));
+			}
+		});
+	});
+}
+
+TSharedRef<FTransactionHistoryIterator> UIndexer::IterateTransactionHistory(const int64 ChainID, const FSeqGetTransactionHistoryArgs& Args)
+{
+	const TWeakObjectPtr<UIndexer> WeakThis(this);
+	return MakeShared<FTransactionHistoryIterator>(Args, &FSeqGetTransactionHistoryReturn::transactions, [WeakThis, ChainID](const FSeqGetTransactionHistoryArgs& PageArgs)
+	{
+		return SeqFuture::FromCallback<FSeqGetTransactionHistoryReturn>([WeakThis, ChainID, PageArgs](const TSuccessCallback<FSeqGetTransactionHistoryReturn>& OnSuccess, const FFailureCallback& OnFailure)
+		{
+			if (UIndexer* Indexer = WeakThis.Get())
+			{
+				Indexer->GetTransactionHistory(ChainID, PageArgs, OnSuccess, OnFailure);
+			}
+			else
+			{
+				OnFailure(FSequenceError(RequestFail, "Indexer was destroyed while paging"));
+			}
+		});
+	});
+}
+
+TSharedRef<FPortfolioQuery> UIndexer::GetPortfolio(const FString& AccountAddr, const TArray<int64>& ChainIds, const int32 MaxConcurrentChains, const bool bIncludeMetaData, const FPortfolioChainCallback& OnChain, TSuccessCallback<FSeqPortfolio> OnSuccess)
+{
+	return FPortfolioQuery::Run(this, AccountAddr, ChainIds, MaxConcurrentChains, bIncludeMetaData, OnChain, OnSuccess);
 }
 
 TMap<int64, FSeqTokenBalance> UIndexer::GetTokenBalancesAsMap(TArray<FSeqTokenBalance> Balances)
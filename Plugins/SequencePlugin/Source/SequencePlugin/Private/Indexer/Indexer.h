@@ -5,9 +5,22 @@
 #include "Util/Async.h"
 #include "Indexer/Structs/Struct_Data.h"
 #include "Dom/JsonObject.h"
+#include "RPCCaller.h"
+#include "Indexer/PortfolioQuery.h"
+#include "Indexer/IndexerPageIterator.h"
+#include "Indexer/IndexerCache.h"
 #include "Engine/Texture2D.h"
 #include "Indexer.generated.h"
 
+/**
+ * An indexer response as fetched for FIndexerCache, the decoded body that gets cached and the json parsed from it
+ */
+struct FIndexerFetchedResponse
+{
+	FString Body;
+	TSharedPtr<FJsonObject> Json;
+};
+
 /**
  * 
  */
@@ -34,9 +47,34 @@ private:
 
 	/*
 		Used to send an HTTPPost req to a the sequence app
-		@return the content of the post response
+		@return the post response, parsed straight from its UTF-8 body
+	*/
+	void HTTPPost(const int64& ChainID,const FString& Endpoint,const FString& Args, const TSuccessCallback<TSharedPtr<FJsonObject>>& OnSuccess, const FFailureCallback& OnFailure) const;
+
+	/*
+		Same as HTTPPost, the response also carries the decoded body it was parsed from when bKeepBody is set
+	*/
+	void HTTPPost(const int64& ChainID, const FString& Endpoint, const FString& Args, bool bKeepBody, const TSuccessCallback<FIndexerFetchedResponse>& OnSuccess, const FFailureCallback& OnFailure) const;
+
+	/*
+		Posts to the given endpoint and builds a response of type T from the result.
+		Identical calls (same chain, endpoint & args) already in flight share one request
+		and every caller receives the same parsed response
 	*/
-	void HTTPPost(const int64& ChainID,const FString& Endpoint,const FString& Args, const TSuccessCallback<FString>& OnSuccess, const FFailureCallback& OnFailure) const;
+	template < typename T > void HTTPPostAndBuild(const int64& ChainID, const FString& Endpoint, const FString& Args, const TSuccessCallback<T>& OnSuccess, const FFailureCallback& OnFailure);
+
+	/*
+		Same as HTTPPostAndBuild but goes through FIndexerCache when the endpoint has a cache policy.
+		Fresh responses are served without a request, stale ones are served at once and revalidated, OnUpdate
+		receives the revalidated response if it differs. Should a request fail any cached response is served instead
+	*/
+	template < typename T > void HTTPPostCached(const int64& ChainID, const FString& Endpoint, const FString& Args, const TSuccessCallback<T>& OnSuccess, const TSuccessCallback<T>& OnUpdate, const FFailureCallback& OnFailure);
+
+	/*
+		Posts to the given endpoint and stores the decoded body in FIndexerCache under Key,
+		callers build from the json parsed for validation so the body is only parsed once
+	*/
+	void FetchForCache(const int64& ChainID, const FString& Endpoint, const FString& Args, const FString& Key, const TSuccessCallback<FIndexerFetchedResponse>& OnSuccess, const FFailureCallback& OnFailure) const;
 
 	//end of private functions
 public:
@@ -49,7 +87,22 @@ public:
 	NOTE: Because unreal doesn't support nested TArrays and TMaps I had to use special implementations
 	for some data structures inorder for them to parse properly
 	*/
-	template < typename T > T BuildResponse(FString Text);
+	template < typename T > T BuildResponse(FString Text)
+	{
+		//Take the FString and convert it to a JSON object first!
+		const TSharedPtr<FJsonObject> Json = URPCCaller::Parse(Text);
+		if (!Json)
+		{
+			UE_LOG(LogTemp, Display, TEXT("Failed to convert String: %s to Json object"), *Text);
+			return T();
+		}
+		return BuildResponse<T>(Json);
+	}
+
+	/*
+	Same as above for an already parsed response
+	*/
+	template < typename T > T BuildResponse(const TSharedPtr<FJsonObject>& Json);
 
 	/*
 	Here we take in a struct and convert it straight into a json object String
@@ -69,11 +122,13 @@ public:
 		Used to get version data back from the Chain
 	*/
 	void Version(int64 ChainID, TSuccessCallback<FSeqVersion> OnSuccess, const FFailureCallback& OnFailure);
+	void Version(int64 ChainID, TSuccessCallback<FSeqVersion> OnSuccess, TSuccessCallback<FSeqVersion> OnUpdate, const FFailureCallback& OnFailure);
 
 	/*
 		Used to get the runtime status of the Chain
 	*/
 	void RunTimeStatus(int64 ChainID, TSuccessCallback<FSeqRuntimeStatus> OnSuccess, const FFailureCallback& OnFailure);
+	void RunTimeStatus(int64 ChainID, TSuccessCallback<FSeqRuntimeStatus> OnSuccess, TSuccessCallback<FSeqRuntimeStatus> OnUpdate, const FFailureCallback& OnFailure);
 
 	/*
 		Used to get the chainID from the Chain
@@ -87,27 +142,67 @@ public:
 		@return the Balance ASYNC calls
 	*/
 	void GetEtherBalance(int64 ChainID, FString AccountAddr, TSuccessCallback<FSeqEtherBalance> OnSuccess, const FFailureCallback& OnFailure);
+	void GetEtherBalance(int64 ChainID, FString AccountAddr, TSuccessCallback<FSeqEtherBalance> OnSuccess, TSuccessCallback<FSeqEtherBalance> OnUpdate, const FFailureCallback& OnFailure);
 
 	/*
 		Gets the token balances from the Chain
 	*/
 	void GetTokenBalances(int64 ChainID, const FSeqGetTokenBalancesArgs& Args, TSuccessCallback<FSeqGetTokenBalancesReturn> OnSuccess, const FFailureCallback& OnFailure);
+	void GetTokenBalances(int64 ChainID, const FSeqGetTokenBalancesArgs& Args, TSuccessCallback<FSeqGetTokenBalancesReturn> OnSuccess, TSuccessCallback<FSeqGetTokenBalancesReturn> OnUpdate, const FFailureCallback& OnFailure);
 
 	/*
 		gets the token supplies from the Chain
 	*/
 	void GetTokenSupplies(int64 ChainID, const FSeqGetTokenSuppliesArgs& Args, TSuccessCallback<FSeqGetTokenSuppliesReturn> OnSuccess, const FFailureCallback& OnFailure);
+	void GetTokenSupplies(int64 ChainID, const FSeqGetTokenSuppliesArgs& Args, TSuccessCallback<FSeqGetTokenSuppliesReturn> OnSuccess, TSuccessCallback<FSeqGetTokenSuppliesReturn> OnUpdate, const FFailureCallback& OnFailure);
 
 	/*
 		gets the token supplies map from the Chain
 	*/
 	void GetTokenSuppliesMap(int64 ChainID, const FSeqGetTokenSuppliesMapArgs& Args, TSuccessCallback<FSeqGetTokenSuppliesMapReturn> OnSuccess, const FFailureCallback& OnFailure);
+	void GetTokenSuppliesMap(int64 ChainID, const FSeqGetTokenSuppliesMapArgs& Args, TSuccessCallback<FSeqGetTokenSuppliesMapReturn> OnSuccess, TSuccessCallback<FSeqGetTokenSuppliesMapReturn> OnUpdate, const FFailureCallback& OnFailure);
 	
 	/*
 		get transaction history from the Chain
 	*/
 	void GetTransactionHistory(int64 ChainID, const FSeqGetTransactionHistoryArgs& Args, TSuccessCallback<FSeqGetTransactionHistoryReturn> OnSuccess, const FFailureCallback& OnFailure);
+
+	/*
+		Pages through the token balances from the Chain, starting at the page set in Args, see TIndexerPageIterator
+	*/
+	TSharedRef<FTokenBalancesIterator> IterateTokenBalances(int64 ChainID, const FSeqGetTokenBalancesArgs& Args);
+
+	/*
+		Pages through the transaction history from the Chain, starting at the page set in Args, see TIndexerPageIterator
+	*/
+	TSharedRef<FTransactionHistoryIterator> IterateTransactionHistory(int64 ChainID, const FSeqGetTransactionHistoryArgs& Args);
+
+	/*
+		Reads the ether and token balances of AccountAddr on several chains at once, see FPortfolioQuery
+		@param ChainIds the chains to read, empty reads every network Sequence supports
+		@param OnChain called with each chain as it completes and the portfolio gathered so far
+		@param OnSuccess called once every chain completed, chains that failed are marked in the portfolio
+		@return the running query, to cancel it
+	*/
+	TSharedRef<FPortfolioQuery> GetPortfolio(const FString& AccountAddr, const TArray<int64>& ChainIds, int32 MaxConcurrentChains, bool bIncludeMetaData, const FPortfolioChainCallback& OnChain, TSuccessCallback<FSeqPortfolio> OnSuccess);
 	
+	/*
+		Sets how long responses of Endpoint (e.g. "GetTokenBalances") are reused, for every UIndexer.
+		The overloads taking OnUpdate are told when a response they were served from the cache is outdated,
+		the others only ever see the first response. A zero policy turns caching of Endpoint off
+	*/
+	static void SetCachePolicy(const FString& Endpoint, float FreshSeconds, float StaleSeconds);
+
+	/*
+		Drops every cached indexer response
+	*/
+	static void ClearCache();
+
+	/*
+		Drops the cached balances on ChainID, called once a transaction of the wallet went through
+	*/
+	static void InvalidateBalances(int64 ChainID);
+
 	/*
 	 *	Converts a TArray<FTokenBalance> Into a TMap<int64, FTokenBalance>
 	 *	where the key is the TokenID
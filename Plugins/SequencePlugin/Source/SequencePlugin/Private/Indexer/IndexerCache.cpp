@@ -0,0 +1,181 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+#include "Indexer/IndexerCache.h"
+#include "Dom/JsonValue.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+namespace IndexerCache
+{
+	static void WriteCanonical(const TSharedPtr<FJsonValue>& Value, FString& Out)
+	{
+		switch (Value->Type)
+		{
+		case EJson::Object:
+			{
+				const TSharedPtr<FJsonObject> Object = Value->AsObject();
+				TArray<FString> Keys;
+				Object->Values.GetKeys(Keys);
+				Keys.Sort();
+
+				Out += "{";
+				for (int32 Index = 0; Index < Keys.Num(); Index++)
+				{
+					Out += (Index > 0 ? ",\"" : "\"") + Keys[Index].ReplaceCharWithEscapedChar() + "\":";
+					WriteCanonical(Object->Values[Keys[Index]], Out);
+				}
+				Out += "}";
+				break;
+			}
+		case EJson::Array:
+			{
+				const TArray<TSharedPtr<FJsonValue>>& Items = Value->AsArray();
+				Out += "[";
+				for (int32 Index = 0; Index < Items.Num(); Index++)
+				{
+					if (Index > 0)
+					{
+						Out += ",";
+					}
+					WriteCanonical(Items[Index], Out);
+				}
+				Out += "]";
+				break;
+			}
+		case EJson::String:
+			{
+				//addresses and hashes are case insensitive
+				FString Text = Value->AsString();
+				if (Text.StartsWith("0x", ESearchCase::IgnoreCase))
+				{
+					Text.ToLowerInline();
+				}
+				Out += "\"" + Text.ReplaceCharWithEscapedChar() + "\"";
+				break;
+			}
+		case EJson::Number:
+			Out += Value->AsString();
+			break;
+		case EJson::Boolean:
+			Out += Value->AsBool() ? "true" : "false";
+			break;
+		default:
+			Out += "null";
+			break;
+		}
+	}
+}
+
+FIndexerCache::FIndexerCache(const int64 MaxBytes) : Responses(MaxBytes), Clock([]() { return FPlatformTime::Seconds(); })
+{
+	this->Responses.SetOnEvicted([this](const FString& Key)
+	{
+		this->StoredAt.Remove(Key);
+	});
+
+	//only what rarely changes is cached by default, balances change with the player's own transactions
+	this->SetPolicy("Version", FIndexerCachePolicy(300.0f, 3600.0f));
+	this->SetPolicy("RuntimeStatus", FIndexerCachePolicy(5.0f, 60.0f));
+	this->SetPolicy("GetTokenSupplies", FIndexerCachePolicy(30.0f, 300.0f));
+	this->SetPolicy("GetTokenSuppliesMap", FIndexerCachePolicy(30.0f, 300.0f));
+}
+
+FIndexerCache& FIndexerCache::Get()
+{
+	static FIndexerCache Cache(DefaultMaxBytes);
+	return Cache;
+}
+
+FString FIndexerCache::CanonicalArgs(const FString& Args)
+{
+	TSharedPtr<FJsonValue> Json;
+	if (Args.IsEmpty() || !FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Args), Json) || !Json.IsValid())
+	{
+		return Args;
+	}
+
+	FString Out;
+	IndexerCache::WriteCanonical(Json, Out);
+	return Out;
+}
+
+FString FIndexerCache::MakeKey(const int64 ChainID, const FString& Endpoint, const FString& Args)
+{
+	return FString::Printf(TEXT("%lld|%s|%s"), ChainID, *Endpoint, *CanonicalArgs(Args));
+}
+
+void FIndexerCache::SetPolicy(const FString& Endpoint, const FIndexerCachePolicy& Policy)
+{
+	this->Policies.Add(Endpoint, Policy);
+}
+
+FIndexerCachePolicy FIndexerCache::GetPolicy(const FString& Endpoint) const
+{
+	const FIndexerCachePolicy* Policy = this->Policies.Find(Endpoint);
+	return Policy ? *Policy : FIndexerCachePolicy();
+}
+
+FIndexerCacheHit FIndexerCache::Find(const FString& Key, const FIndexerCachePolicy& Policy)
+{
+	FIndexerCacheHit Hit;
+	const double* Stored = this->StoredAt.Find(Key);
+	if (!Stored)
+	{
+		return Hit;
+	}
+
+	const double Age = this->Clock() - *Stored;
+	Hit.Response = this->Responses.Find(Key).GetValue();
+	Hit.State = Age <= Policy.FreshSeconds ? EIndexerCacheLookup::Fresh
+		: Age <= Policy.FreshSeconds + Policy.StaleSeconds ? EIndexerCacheLookup::Stale
+		: EIndexerCacheLookup::Expired;
+	return Hit;
+}
+
+void FIndexerCache::Store(const FString& Key, const FString& Response)
+{
+	//StoredAt only holds keys the response cache has, evictions remove theirs through OnEvicted
+	if (this->Responses.Add(Key, Response))
+	{
+		this->StoredAt.Add(Key, this->Clock());
+	}
+	else
+	{
+		this->Responses.Remove(Key);
+		this->StoredAt.Remove(Key);
+	}
+}
+
+void FIndexerCache::Invalidate(const int64 ChainID, const FString& Endpoint)
+{
+	const FString Prefix = FString::Printf(TEXT("%lld|%s|"), ChainID, *Endpoint);
+	for (auto It = this->StoredAt.CreateIterator(); It; ++It)
+	{
+		if (It.Key().StartsWith(Prefix, ESearchCase::CaseSensitive))
+		{
+			this->Responses.Remove(It.Key());
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void FIndexerCache::Clear()
+{
+	this->Responses.Clear();
+	this->StoredAt.Reset();
+}
+
+void FIndexerCache::SetMaxBytes(const int64 MaxBytes)
+{
+	this->Responses.SetMaxBytes(MaxBytes);
+}
+
+int32 FIndexerCache::Num() const
+{
+	return this->Responses.Num();
+}
+
+void FIndexerCache::SetClock(const TFunction<double ()>& ClockIn)
+{
+	this->Clock = ClockIn;
+}
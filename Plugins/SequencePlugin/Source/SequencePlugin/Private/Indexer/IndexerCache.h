@@ -0,0 +1,90 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+#pragma once
+#include "CoreMinimal.h"
+#include "Util/ResponseCache.h"
+
+/**
+ * How long the responses of one indexer endpoint are reused
+ */
+struct SEQUENCEPLUGIN_API FIndexerCachePolicy
+{
+	/* Responses younger than this are served without a request */
+	float FreshSeconds = 0.0f;
+
+	/* Responses up to FreshSeconds + StaleSeconds old are served at once and revalidated in the background */
+	float StaleSeconds = 0.0f;
+
+	FIndexerCachePolicy() {}
+	FIndexerCachePolicy(const float FreshSecondsIn, const float StaleSecondsIn) : FreshSeconds(FreshSecondsIn), StaleSeconds(StaleSecondsIn) {}
+
+	bool IsEnabled() const
+	{
+		return this->FreshSeconds > 0.0f || this->StaleSeconds > 0.0f;
+	}
+};
+
+enum class EIndexerCacheLookup : uint8
+{
+	Miss,
+	/* Serve, no request */
+	Fresh,
+	/* Serve, then revalidate */
+	Stale,
+	/* Too old to serve unless the request fails */
+	Expired
+};
+
+struct FIndexerCacheHit
+{
+	EIndexerCacheLookup State = EIndexerCacheLookup::Miss;
+	FString Response;
+};
+
+/**
+ * Stale while revalidate cache of raw indexer responses, shared by every UIndexer.
+ * Entries are keyed by chain, endpoint and the canonical form of the arguments so the same query
+ * written with different key order or address case shares one entry. Responses are held in a memory
+ * bounded FResponseCache, endpoints without a policy are not cached at all. Game thread only.
+ */
+class SEQUENCEPLUGIN_API FIndexerCache
+{
+	FResponseCache Responses;
+	TMap<FString, double> StoredAt;
+	TMap<FString, FIndexerCachePolicy> Policies;
+	TFunction<double ()> Clock;
+public:
+	/**
+	 * Starts with the default policies of the shared cache, endpoints can be enabled or disabled with SetPolicy
+	 */
+	explicit FIndexerCache(int64 MaxBytes);
+
+	static FIndexerCache& Get();
+
+	/**
+	 * @return Args as json with sorted keys, no whitespace and lower case hex strings, Args itself if it is not json
+	 */
+	static FString CanonicalArgs(const FString& Args);
+
+	static FString MakeKey(int64 ChainID, const FString& Endpoint, const FString& Args);
+
+	void SetPolicy(const FString& Endpoint, const FIndexerCachePolicy& Policy);
+	FIndexerCachePolicy GetPolicy(const FString& Endpoint) const;
+
+	FIndexerCacheHit Find(const FString& Key, const FIndexerCachePolicy& Policy);
+	void Store(const FString& Key, const FString& Response);
+
+	/**
+	 * Drops every cached response of Endpoint on ChainID, e.g. balances after a transaction of the account
+	 */
+	void Invalidate(int64 ChainID, const FString& Endpoint);
+	void Clear();
+	void SetMaxBytes(int64 MaxBytes);
+	int32 Num() const;
+
+	/**
+	 * Replaces the clock entries are aged with, public so expiry can be tested without waiting
+	 */
+	void SetClock(const TFunction<double ()>& ClockIn);
+
+	static constexpr int64 DefaultMaxBytes = 16 * 1024 * 1024;
+};
@@ -0,0 +1,209 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+#pragma once
+#include "CoreMinimal.h"
+#include "Util/Async.h"
+#include "Util/Future.h"
+#include "Indexer/Structs/Struct_Data.h"
+
+/**
+ * Walks a paged indexer query page by page. As soon as a page arrives the request for the next one
+ * is sent, so fetching the next page overlaps with the caller's processing of the current one.
+ * Every page still costs its own round trip. No page is prefetched past the cap ReadAll was given,
+ * a caller stopping ForEachPage early drops the page already in flight.
+ * Args must have a page field taking an FSeqPage, Return a page field holding the cursor of the next page
+ * and the items in ItemsField. Game thread only.
+ */
+template <typename TArgs, typename TReturn, typename TItem>
+class TIndexerPageIterator : public TSharedFromThis<TIndexerPageIterator<TArgs, TReturn, TItem>>
+{
+public:
+	using FPageFetch = TFunction<TSeqFuture<TReturn> (const TArgs&)>;
+private:
+	FPageFetch Fetch;
+	TArray<TItem> TReturn::* ItemsField;
+	TArgs Args;
+	TOptional<TSeqFuture<TReturn>> Prefetched;
+	int32 PagesRead = 0;
+	/* Pages ReadAll will take, 0 for no limit, nothing is prefetched beyond it */
+	int32 MaxPages = 0;
+	bool bMore = true;
+	bool bFetching = false;
+	bool bCancelled = false;
+	bool bPrefetch = true;
+	bool bStoppedEarly = false;
+public:
+	/**
+	 * @param FetchIn Sends one request, public so the iterator can be driven without an indexer
+	 */
+	TIndexerPageIterator(const TArgs& FirstPage, TArray<TItem> TReturn::* ItemsFieldIn, const FPageFetch& FetchIn)
+		: Fetch(FetchIn), ItemsField(ItemsFieldIn), Args(FirstPage)
+	{
+	}
+
+	/**
+	 * Turns prefetching off, the next page is then only requested by Next
+	 */
+	void SetPrefetch(const bool bPrefetchIn)
+	{
+		this->bPrefetch = bPrefetchIn;
+	}
+
+	/**
+	 * @return false once the last page was read or the iterator was cancelled
+	 */
+	bool HasMore() const
+	{
+		return this->bMore && !this->bCancelled;
+	}
+
+	/**
+	 * @return true if ForEachPage, ForEachItem or ReadAll stopped while the indexer still had pages left
+	 */
+	bool StoppedEarly() const
+	{
+		return this->bStoppedEarly;
+	}
+
+	int32 GetPagesRead() const
+	{
+		return this->PagesRead;
+	}
+
+	bool IsPrefetching() const
+	{
+		return this->Prefetched.IsSet();
+	}
+
+	/**
+	 * Delivers the next page and requests the one after it.
+	 * A failed page is not skipped, calling Next again asks for it once more.
+	 * Nothing is delivered after Cancel.
+	 */
+	void Next(const TSuccessCallback<TReturn>& OnSuccess, const FFailureCallback& OnFailure)
+	{
+		if (!this->HasMore())
+		{
+			OnFailure(FSequenceError(EmptyResponse, "No more pages"));
+			return;
+		}
+		if (this->bFetching)
+		{
+			OnFailure(FSequenceError(RequestFail, "Already waiting for a page"));
+			return;
+		}
+
+		this->bFetching = true;
+		const TSeqFuture<TReturn> Page = this->Prefetched.IsSet() ? this->Prefetched.GetValue() : this->Fetch(this->Args);
+		this->Prefetched.Reset();
+
+		const TSharedRef<TIndexerPageIterator> Iterator = this->AsShared();
+		Page.Then([Iterator, OnSuccess](const TReturn& Read)
+		{
+			Iterator->bFetching = false;
+			if (Iterator->bCancelled)
+			{
+				return;
+			}
+
+			Iterator->PagesRead++;
+			Iterator->bMore = Read.page.more;
+			if (Iterator->bMore)
+			{
+				Iterator->Args.page = Read.page;
+				if (Iterator->bPrefetch && (Iterator->MaxPages <= 0 || Iterator->PagesRead < Iterator->MaxPages))
+				{
+					Iterator->Prefetched = Iterator->Fetch(Iterator->Args);
+				}
+			}
+			OnSuccess(Read);
+		}, [Iterator, OnFailure](const FSequenceError& Error)
+		{
+			Iterator->bFetching = false;
+			if (!Iterator->bCancelled)
+			{
+				OnFailure(Error);
+			}
+		});
+	}
+
+	/**
+	 * Hands every page to OnPage until the last one, or until OnPage returns false
+	 * @param OnDone called once no further page will be delivered, not called after Cancel
+	 */
+	void ForEachPage(const TFunction<bool (const TReturn&)>& OnPage, const TFunction<void ()>& OnDone, const FFailureCallback& OnFailure)
+	{
+		if (!this->HasMore())
+		{
+			if (!this->bCancelled)
+			{
+				OnDone();
+			}
+			return;
+		}
+
+		const TSharedRef<TIndexerPageIterator> Iterator = this->AsShared();
+		this->Next([Iterator, OnPage, OnDone, OnFailure](const TReturn& Page)
+		{
+			if (!OnPage(Page))
+			{
+				Iterator->bStoppedEarly = Iterator->bMore;
+				Iterator->Cancel();
+				OnDone();
+				return;
+			}
+			Iterator->ForEachPage(OnPage, OnDone, OnFailure);
+		}, OnFailure);
+	}
+
+	/**
+	 * Hands the items of every page to OnItem one at a time, pages are dropped once their items were handed out
+	 * so a long history never has to fit in memory at once. Stops early once OnItem returns false.
+	 */
+	void ForEachItem(const TFunction<bool (const TItem&)>& OnItem, const TFunction<void ()>& OnDone, const FFailureCallback& OnFailure)
+	{
+		TArray<TItem> TReturn::* Items = this->ItemsField;
+		this->ForEachPage([Items, OnItem](const TReturn& Page)
+		{
+			for (const TItem& Item : Page.*Items)
+			{
+				if (!OnItem(Item))
+				{
+					return false;
+				}
+			}
+			return true;
+		}, OnDone, OnFailure);
+	}
+
+	/**
+	 * Reads every page and hands all items over at once
+	 * @param MaxPagesIn Stops after this many pages, 0 reads until the last page
+	 */
+	void ReadAll(const int32 MaxPagesIn, const TSuccessCallback<TArray<TItem>>& OnSuccess, const FFailureCallback& OnFailure)
+	{
+		this->MaxPages = MaxPagesIn;
+		const TSharedRef<TArray<TItem>> Collected = MakeShared<TArray<TItem>>();
+		const TSharedRef<TIndexerPageIterator> Iterator = this->AsShared();
+		TArray<TItem> TReturn::* Items = this->ItemsField;
+		this->ForEachPage([Iterator, Collected, Items](const TReturn& Page)
+		{
+			Collected->Append(Page.*Items);
+			return Iterator->MaxPages <= 0 || Iterator->PagesRead < Iterator->MaxPages;
+		}, [Collected, OnSuccess]()
+		{
+			OnSuccess(*Collected);
+		}, OnFailure);
+	}
+
+	/**
+	 * Stops the iteration, a page still in flight is dropped when it arrives
+	 */
+	void Cancel()
+	{
+		this->bCancelled = true;
+		this->Prefetched.Reset();
+	}
+};
+
+using FTokenBalancesIterator = TIndexerPageIterator<FSeqGetTokenBalancesArgs, FSeqGetTokenBalancesReturn, FSeqTokenBalance>;
+using FTransactionHistoryIterator = TIndexerPageIterator<FSeqGetTransactionHistoryArgs, FSeqGetTransactionHistoryReturn, FSeqTransaction>;
@@ -0,0 +1,168 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+#include "Indexer/PortfolioQuery.h"
+#include "Indexer/Indexer.h"
+#include "Util/SequenceSupport.h"
+#include "Util/Log.h"
+
+namespace PortfolioQuery
+{
+	static FSequenceError IndexerGone()
+	{
+		return FSequenceError(RequestFail, "Indexer was destroyed before the portfolio was read");
+	}
+}
+
+FPortfolioQuery::FPortfolioQuery(const FString& AccountAddress, const TArray<int64>& ChainIds, const int32 MaxConcurrentChainsIn, const FChainFetch& FetchIn)
+	: Fetch(FetchIn), MaxConcurrentChains(FMath::Max(1, MaxConcurrentChainsIn))
+{
+	this->Portfolio.accountAddress = AccountAddress;
+	for (const int64 ChainId : ChainIds)
+	{
+		FSeqChainPortfolio Chain;
+		Chain.chainId = ChainId;
+		Chain.networkName = USequenceSupport::GetNetworkName(ChainId);
+		this->Portfolio.chains.Add(Chain);
+	}
+}
+
+TSharedRef<FPortfolioQuery> FPortfolioQuery::Run(UIndexer* Indexer, const FString& AccountAddress, const TArray<int64>& ChainIds, const int32 MaxConcurrentChains, const bool bIncludeMetaData, const FPortfolioChainCallback& OnChain, const TSuccessCallback<FSeqPortfolio>& OnComplete)
+{
+	const TWeakObjectPtr<UIndexer> WeakIndexer(Indexer);
+	const TSharedRef<FPortfolioQuery> Query = MakeShared<FPortfolioQuery>(AccountAddress, ChainIds.Num() > 0 ? ChainIds : USequenceSupport::GetAllNetworkIds(), MaxConcurrentChains, [WeakIndexer, AccountAddress, bIncludeMetaData](const int64 ChainId)
+	{
+		return FetchChain(WeakIndexer, AccountAddress, ChainId, bIncludeMetaData);
+	});
+	Query->Start(OnChain, OnComplete);
+	return Query;
+}
+
+TSeqFuture<FSeqChainPortfolio> FPortfolioQuery::FetchChain(TWeakObjectPtr<UIndexer> Indexer, const FString& AccountAddress, const int64 ChainId, const bool bIncludeMetaData)
+{
+	const TSeqFuture<FSeqEtherBalance> Ether = SeqFuture::FromCallback<FSeqEtherBalance>([Indexer, AccountAddress, ChainId](const TSuccessCallback<FSeqEtherBalance>& OnSuccess, const FFailureCallback& OnFailure)
+	{
+		if (UIndexer* Live = Indexer.Get())
+		{
+			Live->GetEtherBalance(ChainId, AccountAddress, OnSuccess, OnFailure);
+		}
+		else
+		{
+			OnFailure(PortfolioQuery::IndexerGone());
+		}
+	});
+
+	FSeqGetTokenBalancesArgs Args;
+	Args.accountAddress = AccountAddress;
+	Args.includeMetaData = bIncludeMetaData;
+	const TSharedRef<bool> Truncated = MakeShared<bool>(false);
+	const TSeqFuture<TArray<FSeqTokenBalance>> Tokens = SeqFuture::FromCallback<TArray<FSeqTokenBalance>>([Indexer, ChainId, Args, Truncated](const TSuccessCallback<TArray<FSeqTokenBalance>>& OnSuccess, const FFailureCallback& OnFailure)
+	{
+		if (UIndexer* Live = Indexer.Get())
+		{
+			const TSharedRef<FTokenBalancesIterator> Iterator = Live->IterateTokenBalances(ChainId, Args);
+			Iterator->ReadAll(MaxBalancePages, [Iterator, Truncated, OnSuccess](const TArray<FSeqTokenBalance>& Balances)
+			{
+				*Truncated = Iterator->StoppedEarly();
+				OnSuccess(Balances);
+			}, OnFailure);
+		}
+		else
+		{
+			OnFailure(PortfolioQuery::IndexerGone());
+		}
+	});
+
+	return SeqFuture::WhenAll(Ether, Tokens).Then([ChainId, Truncated](const TTuple<FSeqEtherBalance, TArray<FSeqTokenBalance>>& Read)
+	{
+		FSeqChainPortfolio Chain;
+		Chain.chainId = ChainId;
+		Chain.succeeded = true;
+		Chain.truncated = *Truncated;
+		Chain.etherBalance = Read.Get<0>();
+		Chain.balances = Read.Get<1>();
+		return Chain;
+	});
+}
+
+void FPortfolioQuery::Start(const FPortfolioChainCallback& OnChainIn, const TSuccessCallback<FSeqPortfolio>& OnCompleteIn)
+{
+	if (this->bStarted)
+	{
+		return;
+	}
+	this->bStarted = true;
+	this->OnChain = OnChainIn;
+	this->OnComplete = OnCompleteIn;
+
+	if (this->Portfolio.IsComplete())
+	{
+		this->OnComplete(this->Portfolio);
+		return;
+	}
+	this->StartNext();
+}
+
+void FPortfolioQuery::StartNext()
+{
+	while (!this->bCancelled && this->Running < this->MaxConcurrentChains && this->NextChain < this->Portfolio.chains.Num())
+	{
+		const int32 Index = this->NextChain++;
+		const FSeqChainPortfolio Pending = this->Portfolio.chains[Index];
+		this->Running++;
+
+		//the query keeps itself alive until its running chains are back, callers need not hold on to it
+		const TSharedRef<FPortfolioQuery> Self = this->AsShared();
+		const TFunction<void (FSeqChainPortfolio)> Finish = [Self, Index, Pending](FSeqChainPortfolio Chain)
+		{
+			if (Self->bCancelled)
+			{
+				return;
+			}
+			Self->Running--;
+
+			Chain.chainId = Pending.chainId;
+			Chain.networkName = Pending.networkName;
+			Chain.completed = true;
+			Self->Portfolio.chains[Index] = Chain;
+			Self->Portfolio.completedChains++;
+			if (!Chain.succeeded)
+			{
+				Self->Portfolio.failedChains++;
+			}
+
+			if (Self->OnChain)
+			{
+				Self->OnChain(Chain, Self->Portfolio);
+			}
+			if (Self->Portfolio.IsComplete())
+			{
+				Self->OnComplete(Self->Portfolio);
+				return;
+			}
+			Self->StartNext();
+		};
+
+		this->Fetch(Pending.chainId).Then(Finish, [Finish, Pending](const FSequenceError& Error)
+		{
+			SEQ_LOG(Warning, TEXT("Portfolio read on chain %lld failed: %s"), Pending.chainId, *Error.Message);
+			FSeqChainPortfolio Failed = Pending;
+			Failed.succeeded = false;
+			Failed.error = Error.Message;
+			Finish(Failed);
+		});
+	}
+}
+
+void FPortfolioQuery::Cancel()
+{
+	this->bCancelled = true;
+}
+
+const FSeqPortfolio& FPortfolioQuery::GetPortfolio() const
+{
+	return this->Portfolio;
+}
+
+int32 FPortfolioQuery::GetRunning() const
+{
+	return this->Running;
+}
@@ -0,0 +1,70 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+#pragma once
+#include "CoreMinimal.h"
+#include "Util/Async.h"
+#include "Util/Future.h"
+#include "Indexer/Structs/SeqPortfolio.h"
+
+class UIndexer;
+
+using FPortfolioChainCallback = TFunction<void (const FSeqChainPortfolio&, const FSeqPortfolio&)>;
+
+/**
+ * Reads the balances of one account on several chains at once. Chains are fetched side by side,
+ * at most MaxConcurrentChains at a time, and every chain is handed to OnChain together with the
+ * portfolio gathered so far the moment it is done, so a UI can fill in as the chains come back.
+ * A chain that fails is recorded as failed in the portfolio, it never fails the whole query.
+ * Game thread only.
+ */
+class SEQUENCEPLUGIN_API FPortfolioQuery : public TSharedFromThis<FPortfolioQuery>
+{
+public:
+	using FChainFetch = TFunction<TSeqFuture<FSeqChainPortfolio> (int64 ChainId)>;
+private:
+	FChainFetch Fetch;
+	FSeqPortfolio Portfolio;
+	int32 MaxConcurrentChains;
+	int32 NextChain = 0;
+	int32 Running = 0;
+	bool bStarted = false;
+	bool bCancelled = false;
+	FPortfolioChainCallback OnChain;
+	TSuccessCallback<FSeqPortfolio> OnComplete;
+
+	void StartNext();
+public:
+	/**
+	 * @param FetchIn Reads one chain, public so the fan out can be driven without an indexer
+	 */
+	FPortfolioQuery(const FString& AccountAddress, const TArray<int64>& ChainIds, int32 MaxConcurrentChainsIn, const FChainFetch& FetchIn);
+
+	/**
+	 * Queries ChainIds through the indexer
+	 * @param ChainIds Chains to read, empty reads every network Sequence supports
+	 * @param bIncludeMetaData Passed on to GetTokenBalances
+	 * @return the running query, to Cancel it
+	 */
+	static TSharedRef<FPortfolioQuery> Run(UIndexer* Indexer, const FString& AccountAddress, const TArray<int64>& ChainIds, int32 MaxConcurrentChains, bool bIncludeMetaData, const FPortfolioChainCallback& OnChain, const TSuccessCallback<FSeqPortfolio>& OnComplete);
+
+	/**
+	 * Reads the ether balance and every page of token balances of one chain
+	 */
+	static TSeqFuture<FSeqChainPortfolio> FetchChain(TWeakObjectPtr<UIndexer> Indexer, const FString& AccountAddress, int64 ChainId, bool bIncludeMetaData);
+
+	void Start(const FPortfolioChainCallback& OnChainIn, const TSuccessCallback<FSeqPortfolio>& OnCompleteIn);
+
+	/**
+	 * Stops starting further chains and drops the results of those still running, no callback fires afterwards
+	 */
+	void Cancel();
+
+	const FSeqPortfolio& GetPortfolio() const;
+
+	int32 GetRunning() const;
+
+	/* Chains fetched at the same time unless the caller asks otherwise */
+	static constexpr int32 DefaultMaxConcurrentChains = 4;
+
+	/* Pages of token balances read per chain before the chain is cut short and marked truncated */
+	static constexpr int32 MaxBalancePages = 20;
+};
@@ -0,0 +1,84 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+
+#include "Integrators/SequenceMetricsBP.h"
+#include "Http/RequestMetrics.h"
+#include "Http/RateLimiter.h"
+
+USequenceMetricsBP::USequenceMetricsBP() { }
+
+void USequenceMetricsBP::Deinitialize()
+{
+	FRequestMetrics::StopPeriodicDump();
+	Super::Deinitialize();
+}
+
+TArray<FSequenceEndpointMetrics> USequenceMetricsBP::GetEndpointMetrics() const
+{
+	TArray<FSequenceEndpointMetrics> Out;
+	for (const FEndpointMetrics& Metrics : FRequestMetrics::GetSnapshot())
+	{
+		FSequenceEndpointMetrics Entry;
+		Entry.Endpoint = Metrics.Endpoint;
+		Entry.Category = FRequestMetrics::GetCategoryName(Metrics.Category);
+		Entry.Calls = Metrics.Calls;
+		Entry.Errors = Metrics.Errors;
+		Entry.Retries = Metrics.Retries;
+		Entry.BytesOut = Metrics.BytesOut;
+		Entry.BytesIn = Metrics.BytesIn;
+		Entry.QueueP95Ms = static_cast<float>(Metrics.QueueTime.GetPercentile(0.95f) * 1000.0);
+		Entry.TimeToFirstByteP50Ms = static_cast<float>(Metrics.TimeToFirstByte.GetPercentile(0.5f) * 1000.0);
+		Entry.TotalP50Ms = static_cast<float>(Metrics.TotalTime.GetPercentile(0.5f) * 1000.0);
+		Entry.TotalP95Ms = static_cast<float>(Metrics.TotalTime.GetPercentile(0.95f) * 1000.0);
+		Entry.TotalP99Ms = static_cast<float>(Metrics.TotalTime.GetPercentile(0.99f) * 1000.0);
+		Entry.StatusCodes = Metrics.StatusCodes;
+		Out.Add(Entry);
+	}
+	return Out;
+}
+
+void USequenceMetricsBP::ResetMetrics()
+{
+	FRequestMetrics::Reset();
+}
+
+FString USequenceMetricsBP::DumpMetrics(const bool bAsJson)
+{
+	return FRequestMetrics::Dump(bAsJson ? EMetricsDumpFormat::Json : EMetricsDumpFormat::Csv);
+}
+
+void USequenceMetricsBP::StartPeriodicMetricsDump(const float IntervalSeconds, const bool bAsJson)
+{
+	FRequestMetrics::StartPeriodicDump(IntervalSeconds, bAsJson ? EMetricsDumpFormat::Json : EMetricsDumpFormat::Csv);
+}
+
+void USequenceMetricsBP::StopPeriodicMetricsDump()
+{
+	FRequestMetrics::StopPeriodicDump();
+}
+
+TArray<FSequenceRateBudget> USequenceMetricsBP::GetRateBudgets() const
+{
+	TArray<FSequenceRateBudget> Out;
+	for (const FRateBudget& Budget : FRateLimiter::Get().GetBudgets())
+	{
+		FSequenceRateBudget Entry;
+		Entry.Host = Budget.Host;
+		Entry.Tokens = Budget.Tokens;
+		Entry.RequestsPerSecond = Budget.RequestsPerSecond;
+		Entry.Burst = Budget.Burst;
+		Entry.RetryAfterSeconds = Budget.RetryAfterSeconds;
+		Entry.Queued = Budget.Queued;
+		Entry.Throttled = Budget.Throttled;
+		Out.Add(Entry);
+	}
+	return Out;
+}
+
+void USequenceMetricsBP::SetDefaultRateLimit(const float RequestsPerSecond, const float Burst, const float BackgroundReserve)
+{
+	FRateLimit Limit;
+	Limit.RequestsPerSecond = RequestsPerSecond;
+	Limit.Burst = FMath::Max(Burst, 1.0f);
+	Limit.BackgroundReserve = FMath::Clamp(BackgroundReserve, 0.0f, 1.0f);
+	FRateLimiter::Get().SetDefaultLimit(Limit);
+}
@@ -3,7 +3,7 @@
 #include "Integrators/SequenceSessionsBP.h"
 #include "PlayFabResponseIntent.h"
 #include "PlayFabSendIntent.h"
-#include "RequestHandler.h"
+#include "Http/HttpRequestPool.h"
 #include "Engine/Engine.h"
 #include "Engine/GameInstance.h"
 #include "Native/NativeOAuth.h"
@@ -338,13 +338,12 @@ void USequenceSessionsBP::PlayFabLoginRpcAsync(const FString& UsernameIn, const
 
 void USequenceSessionsBP::PlayFabRpcAsync(const FString& Url, const FString& Content, const TSuccessCallback<FString>& OnSuccess, const FFailureCallback& OnFailure)
 {
-	NewObject<URequestHandler>()
-		->PrepareRequest()
-		->WithUrl(Url)
-		->WithHeader("Content-type", "application/json")
-		->WithVerb("POST")
-		->WithContentAsString(Content)
-		->ProcessAndThen(OnSuccess, OnFailure);
+	const TSharedRef<FHttpRequestDescriptor> Descriptor = FHttpRequestPool::Acquire();
+	Descriptor->Url = Url;
+	Descriptor->SharedHeaders = FHttpHeaderSets::Json();
+	Descriptor->Content = Content;
+	Descriptor->Priority = ERequestPriority::Critical;
+	FHttpExecutor::ExecuteAndThen(Descriptor, FRequestPolicies::GetPolicy(Url), OnSuccess, OnFailure);
 }
 
 void USequenceSessionsBP::CallEmailLoginRequiresCode() const
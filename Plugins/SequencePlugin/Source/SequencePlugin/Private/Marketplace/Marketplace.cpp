@@ -7,6 +7,8 @@
 #include "Util/SequenceSupport.h"
 #include "ConfigFetcher.h"
 #include "HttpManager.h"
+#include "Http/HttpRequestPool.h"
+#include "Http/HttpCompression.h"
 
 
 UMarketplace::UMarketplace(){}
@@ -35,8 +37,6 @@ void UMarketplace::HTTPPost(const int64& ChainID, const FString& Endpoint, const
 {
 	const FString RequestURL = this->Url(ChainID, Endpoint);
 
-	const TSharedRef<IHttpRequest> HTTP_Post_Req = FHttpModule::Get().CreateRequest();
-
 	FString AccessKey = UConfigFetcher::GetConfigVar("ProjectAccessKey");
 	if (AccessKey.IsEmpty())
 	{
@@ -44,33 +44,24 @@ void UMarketplace::HTTPPost(const int64& ChainID, const FString& Endpoint, const
 		return;  
 	}
 
-	HTTP_Post_Req->SetVerb("POST");
-	HTTP_Post_Req->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
-	HTTP_Post_Req->SetHeader(TEXT("Accept"), TEXT("application/json"));
-	
-
-	HTTP_Post_Req->SetHeader(TEXT("X-Access-Key"), *AccessKey);	
-	HTTP_Post_Req->SetTimeout(30);
-	HTTP_Post_Req->SetURL(RequestURL);
-	HTTP_Post_Req->SetContentAsString(Args);
-	 
-	UE_LOG(LogTemp, Display, TEXT("body: %s"), *Args);  
-	UE_LOG(LogTemp, Display, TEXT("request: %s"), *RequestURL);  
+	const TSharedRef<FHttpRequestDescriptor> Descriptor = FHttpRequestPool::Acquire();
+	Descriptor->Url = RequestURL;
+	Descriptor->SharedHeaders = FHttpHeaderSets::JsonWithAccessKey(AccessKey);
+	Descriptor->Content = Args;
+	Descriptor->bIdempotent = true;
+	Descriptor->Category = ERequestCategory::Marketplace;
 
-
-	HTTP_Post_Req->OnProcessRequestComplete().BindLambda([OnSuccess, OnFailure](const FHttpRequestPtr& Request, FHttpResponsePtr Response, const bool bWasSuccessful)
+	FHttpExecutor::Execute(Descriptor, [OnSuccess, OnFailure](const FHttpRequestPtr& Request, FHttpResponsePtr Response, const bool bWasSuccessful)
 		{
 			if (bWasSuccessful)
 			{
-				const FString Content = Response->GetContentAsString();
-				UE_LOG(LogTemp, Display, TEXT("Response: %s"), *Content);  
-				OnSuccess(Content);
+				OnSuccess(FHttpCompression::GetContentAsString(Response));
 			}
 			else
 			{
 				if (Request.IsValid() && Response.IsValid())
 				{
-					const FString ErrorMessage = Response->GetContentAsString();
+					const FString ErrorMessage = FHttpCompression::GetContentAsString(Response);
 					UE_LOG(LogTemp, Error, TEXT("Request failed: %s"), *ErrorMessage);  
 					OnFailure(FSequenceError(RequestFail, "Request failed: " + ErrorMessage));
 				}
@@ -81,9 +72,6 @@ void UMarketplace::HTTPPost(const int64& ChainID, const FString& Endpoint, const
 				}
 			}
 		});
-
-	// Process the request
-	HTTP_Post_Req->ProcessRequest();
 }
 
 void UMarketplace::GetCollectibleListings(const int64 ChainID, const FSeqGetCollectiblesWithLowestListingsArgs& Args, TSuccessCallback<FSeqGetCollectiblesWithLowestListingsReturn> OnSuccess, const FFailureCallback& OnFailure)
@@ -0,0 +1,232 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+#include "NonceManager.h"
+#include "Provider.h"
+#include "Util/Log.h"
+
+static TMap<FString, TSharedRef<FNonceManager>>& Managers()
+{
+	static TMap<FString, TSharedRef<FNonceManager>> Registry;
+	return Registry;
+}
+
+FNonceManager::FNonceManager(const FString& UrlIn, const FAddress& AddressIn) : Url(UrlIn), Address(AddressIn)
+{
+}
+
+TSharedRef<FNonceManager> FNonceManager::Get(const FString& Url, const FAddress& Address)
+{
+	const FString Key = Url + "|" + Address.ToHex();
+	if (const TSharedRef<FNonceManager>* Manager = Managers().Find(Key))
+	{
+		return *Manager;
+	}
+
+	const TSharedRef<FNonceManager> Manager = MakeShared<FNonceManager>(Url, Address);
+	Managers().Add(Key, Manager);
+	return Manager;
+}
+
+void FNonceManager::Acquire(const TSuccessCallback<uint64>& OnNonce, const FFailureCallback& OnFailure)
+{
+	if (this->IsSeeded())
+	{
+		OnNonce(this->HandOut());
+		return;
+	}
+
+	this->Waiting.Add(FWaiting{ OnNonce, OnFailure });
+	if (!this->bSeeding)
+	{
+		this->Seed();
+	}
+}
+
+void FNonceManager::Prepare(const TFunction<void ()>& OnReady, const FFailureCallback& OnFailure)
+{
+	if (this->IsSeeded())
+	{
+		OnReady();
+		return;
+	}
+
+	this->Waiting.Add(FWaiting{ nullptr, OnFailure, OnReady });
+	if (!this->bSeeding)
+	{
+		this->Seed();
+	}
+}
+
+bool FNonceManager::IsSeeded() const
+{
+	return this->Next.IsSet() && !this->bSeeding;
+}
+
+void FNonceManager::Confirm(const uint64 Nonce)
+{
+	this->InFlight.Remove(Nonce);
+	this->Unsettled.Remove(Nonce);
+}
+
+void FNonceManager::Release(const uint64 Nonce)
+{
+	this->Unsettled.Remove(Nonce);
+	if (this->InFlight.Remove(Nonce) == 0)
+	{
+		return;
+	}
+
+	if (this->Next.IsSet() && Nonce + 1 == this->Next.GetValue())
+	{
+		this->Next = Nonce;
+
+		//released nonces right below the new end are folded back in as well
+		while (this->Released.Num() > 0 && this->Released.Last() + 1 == this->Next.GetValue())
+		{
+			this->Next = this->Released.Pop();
+		}
+		return;
+	}
+
+	this->Released.Add(Nonce);
+	this->Released.Sort();
+}
+
+void FNonceManager::Unresolved(const uint64 Nonce)
+{
+	if (this->InFlight.Contains(Nonce))
+	{
+		this->Unsettled.Add(Nonce);
+	}
+	this->Resync();
+}
+
+void FNonceManager::Resync()
+{
+	if (!this->bSeeding)
+	{
+		this->Seed();
+	}
+}
+
+void FNonceManager::Seed(const uint64 NextNonce)
+{
+	this->Next = NextNonce;
+	this->Released.Empty();
+}
+
+int32 FNonceManager::NumInFlight() const
+{
+	return this->InFlight.Num();
+}
+
+void FNonceManager::Seed()
+{
+	this->bSeeding = true;
+
+	const TWeakPtr<FNonceManager> WeakThis = AsShared();
+	UProvider::Make(this->Url)->TransactionCount(this->Address, EBlockTag::EPending, [WeakThis](const uint64 Count)
+	{
+		if (const TSharedPtr<FNonceManager> Manager = WeakThis.Pin())
+		{
+			Manager->OnSeeded(Count);
+		}
+	}, [WeakThis](const FSequenceError& Error)
+	{
+		const TSharedPtr<FNonceManager> Manager = WeakThis.Pin();
+		if (!Manager)
+		{
+			return;
+		}
+
+		Manager->bSeeding = false;
+		const TArray<FWaiting> Failed = MoveTemp(Manager->Waiting);
+		Manager->Waiting.Reset();
+		for (const FWaiting& Waiting : Failed)
+		{
+			Waiting.OnFailure(Error);
+		}
+	});
+}
+
+void FNonceManager::OnSeeded(const uint64 PendingCount)
+{
+	this->bSeeding = false;
+
+	//the pool already holds every accepted nonce below PendingCount, unsettled sends at or above it never got there
+	for (const uint64 Nonce : this->Unsettled)
+	{
+		this->InFlight.Remove(Nonce);
+	}
+
+	//sends still in flight may sit above the count
+	uint64 NextNonce = PendingCount;
+	for (const uint64 Nonce : this->InFlight)
+	{
+		NextNonce = FMath::Max(NextNonce, Nonce + 1);
+	}
+
+	if (this->Next.IsSet() && this->Next.GetValue() != NextNonce)
+	{
+		SEQ_LOG(Log, TEXT("Nonce of 0x%s resynced from %llu to %llu"), *this->Address.ToHex(), this->Next.GetValue(), NextNonce);
+	}
+	this->Next = NextNonce;
+
+	for (const uint64 Nonce : this->Unsettled)
+	{
+		if (Nonce >= PendingCount && Nonce < NextNonce)
+		{
+			this->Released.AddUnique(Nonce);
+		}
+	}
+	this->Unsettled.Reset();
+
+	//only gaps between the count and Next are handed out again, anything else would be given out twice
+	this->Released.RemoveAll([PendingCount, NextNonce](const uint64 Nonce)
+	{
+		return Nonce < PendingCount || Nonce >= NextNonce;
+	});
+	this->Released.Sort();
+
+	const TArray<FWaiting> Ready = MoveTemp(this->Waiting);
+	this->Waiting.Reset();
+	for (const FWaiting& Waiting : Ready)
+	{
+		if (Waiting.OnNonce)
+		{
+			Waiting.OnNonce(this->HandOut());
+		}
+		else
+		{
+			Waiting.OnReady();
+		}
+	}
+}
+
+uint64 FNonceManager::HandOut()
+{
+	uint64 Nonce;
+	if (this->Released.Num() > 0)
+	{
+		Nonce = this->Released[0];
+		this->Released.RemoveAt(0);
+	}
+	else
+	{
+		Nonce = this->Next.GetValue();
+		this->Next = Nonce + 1;
+	}
+
+	this->InFlight.Add(Nonce);
+	return Nonce;
+}
+
+bool FNonceManager::IsNonceTooLow(const FSequenceError& Error)
+{
+	//geth: "nonce too low", hardhat: "Nonce too low. Expected nonce to be ..."
+	return Error.Message.Contains("nonce too low") || Error.Message.Contains("nonce has already been used");
+}
+
+FBlockNonce FNonceManager::ToBlockNonce(const uint64 Nonce)
+{
+	return FBlockNonce::From(FString::Printf(TEXT("%016llx"), Nonce));
+}
@@ -0,0 +1,104 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+#pragma once
+#include "CoreMinimal.h"
+#include "Types/BinaryData.h"
+#include "Util/Async.h"
+
+/**
+ * Hands out nonces for one signer on one chain without a round trip per transaction.
+ * The pending transaction count is fetched once, nonces are then given out locally so many
+ * transactions can be signed and sent back to back. Nonces of sends that never reached the pool
+ * are released and handed out again first so no gap stalls the signer.
+ * On a "nonce too low" rejection call Resync, the count is fetched again before the next nonce.
+ * When a send fails without an answer from the node call Unresolved, the next count tells whether it got through.
+ * There is one manager per (Url, address), shared by every provider. Game thread only.
+ */
+class SEQUENCEPLUGIN_API FNonceManager : public TSharedFromThis<FNonceManager>
+{
+	struct FWaiting
+	{
+		/* Unset for callers of Prepare, who only wait for the seed */
+		TSuccessCallback<uint64> OnNonce;
+		FFailureCallback OnFailure;
+		TFunction<void ()> OnReady;
+	};
+
+	FString Url;
+	FAddress Address;
+
+	/* Next never used nonce, unset until seeded */
+	TOptional<uint64> Next;
+	/* Handed out, neither confirmed nor released yet */
+	TSet<uint64> InFlight;
+	/* Released below Next, handed out again lowest first */
+	TArray<uint64> Released;
+	/* In flight nonces whose send failed in transport, settled by the next seed */
+	TSet<uint64> Unsettled;
+
+	TArray<FWaiting> Waiting;
+	bool bSeeding = false;
+
+	void Seed();
+	uint64 HandOut();
+public:
+	FNonceManager(const FString& UrlIn, const FAddress& AddressIn);
+
+	/**
+	 * Gets the shared manager of Address on the chain served by Url, creating it on first use
+	 */
+	static TSharedRef<FNonceManager> Get(const FString& Url, const FAddress& Address);
+
+	/**
+	 * Reserves the next nonce, synchronously once the manager is seeded.
+	 * Every nonce acquired must be given back through Confirm or Release.
+	 */
+	void Acquire(const TSuccessCallback<uint64>& OnNonce, const FFailureCallback& OnFailure);
+
+	/**
+	 * Seeds the manager if needed without reserving a nonce, so the seed can be fetched
+	 * alongside other requests and the nonce still be acquired as late as possible
+	 */
+	void Prepare(const TFunction<void ()>& OnReady, const FFailureCallback& OnFailure);
+
+	bool IsSeeded() const;
+
+	/**
+	 * The transaction using Nonce was accepted by the node
+	 */
+	void Confirm(const uint64 Nonce);
+
+	/**
+	 * The transaction using Nonce was never accepted, the nonce is free again
+	 */
+	void Release(const uint64 Nonce);
+
+	/**
+	 * The send using Nonce failed before the node answered (timeout, connection error, 5xx) so it may or may
+	 * not have reached the pool. The nonce stays in flight and the pending count is fetched again, a count
+	 * above Nonce confirms it, otherwise it is released.
+	 */
+	void Unresolved(const uint64 Nonce);
+
+	/**
+	 * Fetches the pending count again before the next nonce is handed out,
+	 * nonces still in flight are never handed out twice
+	 */
+	void Resync();
+
+	/* Result of a fetch of the pending count, public so resyncs can be driven without a node */
+	void OnSeeded(const uint64 PendingCount);
+
+	/**
+	 * Seeds the manager with a known next nonce, skipping the fetch
+	 */
+	void Seed(const uint64 NextNonce);
+
+	int32 NumInFlight() const;
+
+	/**
+	 * @return true if the node rejected a transaction because its nonce was already used
+	 */
+	static bool IsNonceTooLow(const FSequenceError& Error);
+
+	static FBlockNonce ToBlockNonce(const uint64 Nonce);
+};
@@ -1,6 +1,8 @@
 // Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
 #include "ObjectHandler.h"
 #include "TextureResource.h"
+#include "Http/HttpRequestPool.h"
+#include "Http/HttpCompression.h"
 
 TMap<FString, UTexture2D*> UObjectHandler::GetProcessedImages()
 {
@@ -58,7 +60,8 @@ void UObjectHandler::HandleRequestRaw(FHttpRequestPtr Request, FHttpResponsePtr
 	{//Parse the json response
 		Response = Request.Get()->GetResponse();//allows for more independence!
 		//cache our response first!
-		TArray<uint8> response_data = Response.Get()->GetContent();
+		TArray<uint8> decoded_data;
+		const TArray<uint8>& response_data = FHttpCompression::GetContent(Response, decoded_data);
 		FString response_url = Request.Get()->GetURL();
 		if (this->UseRawCache)
 			this->AddToCache(response_url, response_data);//cache it if we need it!
@@ -172,13 +175,25 @@ bool UObjectHandler::RequestRawBase(FString URL)
 			return true; //we are done here!
 		}
 	}
-	TSharedRef<IHttpRequest> http_post_req = FHttpModule::Get().CreateRequest();
-	http_post_req->SetVerb("GET");
-	http_post_req->SetURL(URL);
-	http_post_req->SetTimeout(15);
-	http_post_req->OnProcessRequestComplete().BindUObject(this, &UObjectHandler::HandleRequestRaw);
-	http_post_req->ProcessRequest();
-	return http_post_req.Get().GetStatus() == EHttpRequestStatus::Processing || http_post_req.Get().GetStatus() == EHttpRequestStatus::Succeeded;
+	const TSharedRef<FHttpRequestDescriptor> Descriptor = FHttpRequestPool::Acquire();
+	Descriptor->Url = URL;
+	Descriptor->Verb = "GET";
+	Descriptor->bIdempotent = true;
+	Descriptor->Priority = ERequestPriority::Background;//bulk image loads must never hold up auth or transactions
+	Descriptor->Category = ERequestCategory::Media;
+
+	FRequestPolicy Policy = FRequestPolicies::GetPolicy(URL);
+	Policy.AttemptTimeoutSeconds = 15;
+
+	TWeakObjectPtr<UObjectHandler> WeakThis(this);
+	FHttpExecutor::Execute(Descriptor, Policy, [WeakThis](FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
+	{
+		if (WeakThis.IsValid())
+		{
+			WeakThis->HandleRequestRaw(Request, Response, bWasSuccessful);
+		}
+	});
+	return true;
 }
 
 void UObjectHandler::RequestImage(FString URL)
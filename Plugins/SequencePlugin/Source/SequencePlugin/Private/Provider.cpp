@@ -5,12 +5,24 @@
 #include "Types/BinaryData.h"
 #include "Util/HexUtility.h"
 #include "Util/JsonBuilder.h"
-#include "RequestHandler.h"
+#include "Http/HttpRequestPool.h"
+#include "Http/HttpCompression.h"
+#include "ProviderBatch.h"
+#include "BlockHeadTracker.h"
+#include "ProviderSubscriptions.h"
+#include "ReceiptWatcher.h"
+#include "NonceManager.h"
+#include "GasOracle.h"
+#include "TransactionPipeline.h"
+#include "ProviderEndpoints.h"
 #include "Types/Header.h"
+#include "RpcExtractors.h"
+#include "Util/Log.h"
 
 void UProvider::Init(const FString& UrlIn)
 {
 	this->Url = UrlIn;
+	this->Endpoints = FProviderEndpoints::Get(UrlIn);
 }
 
 UProvider* UProvider::Make(const FString& UrlIn)
@@ -20,12 +32,250 @@ UProvider* UProvider::Make(const FString& UrlIn)
 	return ProviderObj;
 }
 
+UProvider* UProvider::Make(const TArray<FString>& Urls)
+{
+	if (Urls.Num() == 0)
+	{
+		SEQ_LOG(Error, TEXT("Cannot make a provider without RPC urls"));
+		return nullptr;
+	}
+
+	FProviderEndpoints::Register(Urls);
+	return Make(Urls[0]);
+}
+
 void UProvider::UpdateUrl(const FString& UrlIn)
 {
-	this->Url = UrlIn;
+	this->Init(UrlIn);
+	this->ClearImmutableCache();
+}
+
+void UProvider::UpdateUrls(const TArray<FString>& Urls)
+{
+	if (Urls.Num() == 0)
+	{
+		SEQ_LOG(Error, TEXT("Ignoring an empty list of RPC urls, keeping %s"), *this->Url);
+		return;
+	}
+
+	FProviderEndpoints::Register(Urls);
+	this->UpdateUrl(Urls[0]);
+}
+
+TSharedRef<FProviderEndpoints> UProvider::GetEndpoints() const
+{
+	return this->Endpoints.IsValid() ? this->Endpoints.ToSharedRef() : FProviderEndpoints::Get(this->Url);
+}
+
+/*
+* Sends Content to one endpoint of the set, reads that fail move on to the next best endpoint not yet tried
+*/
+static void RouteRPC(const TSharedRef<FProviderEndpoints>& Endpoints, const int32 Index, const FString& Content, const bool bIdempotent, TSet<int32> Tried, const TSuccessCallback<FString>& OnSuccess, const FFailureCallback& OnFailure)
+{
+	const FString EndpointUrl = Endpoints->GetUrl(Index);
+	Tried.Add(Index);
+
+	const TFunction<void (const FSequenceError&)> FailOver = [Endpoints, Index, Content, bIdempotent, Tried, OnSuccess, OnFailure](const FSequenceError& Error)
+	{
+		Endpoints->ReportFailure(Index);
+
+		//writes are not resent elsewhere, the next write gets pinned to a healthy node
+		const int32 Next = bIdempotent ? Endpoints->SelectForRead(Tried) : INDEX_NONE;
+		if (Next == INDEX_NONE)
+		{
+			OnFailure(Error);
+			return;
+		}
+
+		SEQ_LOG(Warning, TEXT("RPC to %s failed, failing over to %s"), *Endpoints->GetUrl(Index), *Endpoints->GetUrl(Next));
+		RouteRPC(Endpoints, Next, Content, bIdempotent, Tried, OnSuccess, OnFailure);
+	};
+
+	//with other nodes left to try, moving on beats retrying a node that is already slow or down
+	FRequestPolicy Policy = FRequestPolicies::GetPolicy(EndpointUrl);
+	if (bIdempotent && Tried.Num() < Endpoints->Num())
+	{
+		Policy.MaxAttempts = 1;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	const TSharedRef<FHttpRequestDescriptor> Descriptor = FHttpRequestPool::Acquire();
+	Descriptor->Url = EndpointUrl;
+	Descriptor->SharedHeaders = FHttpHeaderSets::Json();
+	Descriptor->Content = Content;
+	Descriptor->bIdempotent = bIdempotent;
+	Descriptor->Priority = bIdempotent ? ERequestPriority::Interactive : ERequestPriority::Critical;
+	Descriptor->Category = ERequestCategory::Rpc;
+	FHttpExecutor::ExecuteAndThen(Descriptor, Policy, [Endpoints, Index, EndpointUrl, StartTime, OnSuccess, FailOver](const FHttpResponsePtr& Response)
+		{
+			const int32 ResponseCode = Response->GetResponseCode();
+			if (ResponseCode == 429 || ResponseCode >= 500)
+			{
+				FailOver(FSequenceError(RequestFail, FString::Printf(TEXT("HTTP Error: %d from %s"), ResponseCode, *EndpointUrl)));
+				return;
+			}
+
+			Endpoints->ReportSuccess(Index, FPlatformTime::Seconds() - StartTime);
+			OnSuccess(FHttpCompression::GetContentAsString(Response));
+		}, FailOver);
+}
+
+void UProvider::PostRPC(const FString& RequestUrl, const FString& Content, const bool bIdempotent, const TSuccessCallback<FString>& OnSuccess, const FFailureCallback& OnFailure)
+{
+	const TSharedRef<FProviderEndpoints> Set = this->GetEndpoints();
+	if (Set->Num() <= 1 || !RequestUrl.Equals(Set->GetPrimaryUrl()))
+	{
+		Super::PostRPC(RequestUrl, Content, bIdempotent, OnSuccess, OnFailure);
+		return;
+	}
+
+	const int32 Index = bIdempotent ? Set->SelectForRead(TSet<int32>()) : Set->SelectForWrite();
+	RouteRPC(Set, Index, Content, bIdempotent, TSet<int32>(), OnSuccess, OnFailure);
+}
+
+TSharedRef<FBlockHeadTracker> UProvider::GetHeadTracker() const
+{
+	return FBlockHeadTracker::Get(this->Url);
+}
+
+void UProvider::SetWebSocketUrl(const FString& WebSocketUrl)
+{
+	FProviderSubscriptions::Register(this->Url, WebSocketUrl);
+}
+
+TSharedPtr<FProviderSubscriptions> UProvider::GetSubscriptions() const
+{
+	return FProviderSubscriptions::Get(this->Url);
+}
+
+int32 UProvider::SubscribeNewHeads(const TSuccessCallback<FHeader>& OnHeader, const FFailureCallback& OnFailure)
+{
+	const TSharedPtr<FProviderSubscriptions> Subscriptions = this->GetSubscriptions();
+	if (!Subscriptions)
+	{
+		OnFailure(FSequenceError(UnsupportedMethodOnChain, "No WebSocket url set for " + this->Url));
+		return INDEX_NONE;
+	}
+
+	return Subscriptions->SubscribeNewHeads([OnHeader](const TSharedPtr<FJsonValue>& Result)
+	{
+		const TSharedPtr<FJsonObject>* Json;
+		if (Result && Result->TryGetObject(Json))
+		{
+			OnHeader(JsonToHeader(*Json));
+		}
+	}, OnFailure);
+}
+
+int32 UProvider::SubscribeLogs(const FLogFilter& Filter, const TSuccessCallback<TSharedPtr<FJsonObject>>& OnLog, const FFailureCallback& OnFailure)
+{
+	const TSharedPtr<FProviderSubscriptions> Subscriptions = this->GetSubscriptions();
+	if (!Subscriptions)
+	{
+		OnFailure(FSequenceError(UnsupportedMethodOnChain, "No WebSocket url set for " + this->Url));
+		return INDEX_NONE;
+	}
+
+	return Subscriptions->SubscribeLogs(Filter, [OnLog](const TSharedPtr<FJsonValue>& Result)
+	{
+		const TSharedPtr<FJsonObject>* Json;
+		if (Result && Result->TryGetObject(Json))
+		{
+			OnLog(*Json);
+		}
+	}, OnFailure);
+}
+
+int32 UProvider::SubscribePendingTransactions(const TSuccessCallback<FHash256>& OnTransaction, const FFailureCallback& OnFailure)
+{
+	const TSharedPtr<FProviderSubscriptions> Subscriptions = this->GetSubscriptions();
+	if (!Subscriptions)
+	{
+		OnFailure(FSequenceError(UnsupportedMethodOnChain, "No WebSocket url set for " + this->Url));
+		return INDEX_NONE;
+	}
+
+	return Subscriptions->SubscribePendingTransactions([OnTransaction](const TSharedPtr<FJsonValue>& Result)
+	{
+		FString Hash;
+		if (Result && Result->TryGetString(Hash))
+		{
+			OnTransaction(FHash256::From(Hash));
+		}
+	}, OnFailure);
+}
+
+void UProvider::Unsubscribe(const int32 SubscriptionId)
+{
+	if (const TSharedPtr<FProviderSubscriptions> Subscriptions = this->GetSubscriptions())
+	{
+		Subscriptions->Unsubscribe(SubscriptionId);
+	}
+}
+
+TSharedRef<FResponseCache> UProvider::GetImmutableCache()
+{
+	if (!this->ImmutableCache.IsValid())
+	{
+		this->ImmutableCache = MakeShared<FResponseCache>(this->ImmutableCacheMaxBytes);
+	}
+	return this->ImmutableCache.ToSharedRef();
+}
+
+void UProvider::SetImmutableCacheSize(const int64 MaxBytes)
+{
+	this->ImmutableCacheMaxBytes = MaxBytes;
+	if (this->ImmutableCache.IsValid())
+	{
+		this->ImmutableCache->SetMaxBytes(MaxBytes);
+	}
+}
+
+void UProvider::ClearImmutableCache()
+{
+	if (this->ImmutableCache.IsValid())
+	{
+		this->ImmutableCache->Clear();
+	}
+}
+
+/*
+* Extractors only produce a value from a non null result, so a value read at an explicit block or hash is final
+*/
+template<typename T>
+static bool HasFinalResult(const T& Value)
+{
+	return true;
+}
+
+/*
+* Transactions & receipts are final once they have been included in a block
+*/
+static bool IsMinedTransaction(const TSharedPtr<FJsonObject>& Transaction)
+{
+	FString BlockHash;
+	return Transaction->TryGetStringField(TEXT("blockHash"), BlockHash) && !BlockHash.IsEmpty();
+}
+
+static bool IsMinedReceipt(const FTransactionReceipt& Receipt)
+{
+	//the genesis block holds no transactions
+	return Receipt.BlockNumber > 0;
+}
+
+template<typename T>
+static bool NeverFinal(const T& Value)
+{
+	return false;
+}
+
+TSharedRef<FProviderBatch> UProvider::NewBatch() const
+{
+	const TSharedRef<FProviderEndpoints> Set = this->GetEndpoints();
+	return MakeShared<FProviderBatch>(Set->GetUrl(Set->SelectForRead(TSet<int32>())));
 }
 
-void UProvider::BlockByNumberHelper(const FString& Number, const TSuccessCallback<TSharedPtr<FJsonObject>>& OnSuccess, const FFailureCallback& OnFailure)
+void UProvider::BlockByNumberHelper(const FString& Number, const bool bExplicitBlock, const TSuccessCallback<TSharedPtr<FJsonObject>>& OnSuccess, const FFailureCallback& OnFailure)
 {
 	const FString Content = FJsonBuilder().ToPtr()
 		->AddString("jsonrpc", "2.0")
@@ -37,40 +287,23 @@ void UProvider::BlockByNumberHelper(const FString& Number, const TSuccessCallbac
 			->EndArray()
 		->ToString();
 
-	const FString MyUrl = this->Url;
-	SendRPCAndExtract<TSharedPtr<FJsonObject>>(
-		Url,
+	SendCachedRPCAndExtract<TSharedPtr<FJsonObject>>(
 		Content,
+		bExplicitBlock ? &HasFinalResult<TSharedPtr<FJsonObject>> : &NeverFinal<TSharedPtr<FJsonObject>>,
 		OnSuccess,
-		[MyUrl](const FString& Json)
-		{
-			TResult<TSharedPtr<FJsonObject>> Obj = Make(MyUrl)->ExtractJsonObjectResult(Json);
-
-			if(Obj.HasValue() && Obj.GetValue() != nullptr)
-			{
-				return Obj;
-			}
-			
-			if(Obj.HasValue() && Obj.GetValue() == nullptr)
-			{
-				TResult<TSharedPtr<FJsonObject>> Val = MakeError(FSequenceError(EmptyResponse, "Json response is null"));
-				return Val;
-			}
-
-			return Obj;
-		},
+		&TRpcExtractor<TSharedPtr<FJsonObject>>::FromResponse,
 		OnFailure
 	);
 }
 
 void  UProvider::BlockByNumber(const uint64 Number, const TSuccessCallback<TSharedPtr<FJsonObject>>& OnSuccess, const FFailureCallback& OnFailure)
 {
-	BlockByNumberHelper(ConvertString(IntToHexString(Number)), OnSuccess, OnFailure);
+	BlockByNumberHelper(ConvertString(IntToHexString(Number)), true, OnSuccess, OnFailure);
 }
 
 void UProvider::BlockByNumber(const EBlockTag Tag, const TSuccessCallback<TSharedPtr<FJsonObject>>& OnSuccess, const FFailureCallback& OnFailure)
 {
-	BlockByNumberHelper(ConvertString(UEnum::GetValueAsString(Tag)), OnSuccess, OnFailure);
+	BlockByNumberHelper(ConvertString(BlockTagToString(Tag)), false, OnSuccess, OnFailure);
 }
 
 void UProvider::BlockByHash(const FHash256& Hash, const TSuccessCallback<TSharedPtr<FJsonObject>>& OnSuccess, const FFailureCallback& OnFailure)
@@ -82,39 +315,30 @@ void UProvider::BlockByHash(const FHash256& Hash, const TSuccessCallback<TShared
 	        ->EndArray()
         ->ToString();
 
-	const FString MyUrl = this->Url;
-
-	SendRPCAndExtract<TSharedPtr<FJsonObject>>(Url, Content,
+	SendCachedRPCAndExtract<TSharedPtr<FJsonObject>>(Content, &HasFinalResult<TSharedPtr<FJsonObject>>,
 		OnSuccess,
-		[MyUrl](const FString& Result)
-		{
-			return Make(MyUrl)->ExtractJsonObjectResult(Result);
-		},
+		&TRpcExtractor<TSharedPtr<FJsonObject>>::FromResponse,
 		OnFailure);
 }
 
 void UProvider::BlockNumber(const TSuccessCallback<uint64>& OnSuccess, const FFailureCallback& OnFailure)
 {
 	const FString Content = RPCBuilder("eth_blockNumber").ToString();
-	const FString MyUrl = this->Url;
-	SendRPCAndExtract<uint64>(Url, Content,
+	SendReadRPCAndExtract<uint64>(Url, Content,
 		OnSuccess,
-		[MyUrl](const FString& Result)
-		{
-			return Make(MyUrl)->ExtractUIntResult(Result);
-		},
+		&TRpcExtractor<uint64>::FromResponse,
 		OnFailure);
 }
 
-void UProvider::HeaderByNumberHelper(const FString& Number, TSuccessCallback<FHeader> OnSuccess, const FFailureCallback& OnFailure)
+void UProvider::HeaderByNumberHelper(const FString& Number, const bool bExplicitBlock, TSuccessCallback<FHeader> OnSuccess, const FFailureCallback& OnFailure)
 {
-	BlockByNumberHelper(Number, [OnSuccess](const TSharedPtr<FJsonObject>& Json)
+	BlockByNumberHelper(Number, bExplicitBlock, [OnSuccess](const TSharedPtr<FJsonObject>& Json)
 	{
 		OnSuccess(JsonToHeader(Json));
 	}, OnFailure);
 }
 
-void UProvider::NonceAtHelper(const FString& Number, TSuccessCallback<FBlockNonce> OnSuccess, const FFailureCallback& OnFailure)
+void UProvider::NonceAtHelper(const FString& Number, const bool bExplicitBlock, TSuccessCallback<FBlockNonce> OnSuccess, const FFailureCallback& OnFailure)
 {
 	const TSuccessCallback<TSharedPtr<FJsonObject>> BlockCallback = [OnSuccess](const TSharedPtr<FJsonObject>& Json)
 	{
@@ -124,17 +348,17 @@ void UProvider::NonceAtHelper(const FString& Number, TSuccessCallback<FBlockNonc
 		OnSuccess(Nonce);
 	};
 	
-	this->BlockByNumberHelper(Number, BlockCallback, OnFailure);
+	this->BlockByNumberHelper(Number, bExplicitBlock, BlockCallback, OnFailure);
 }
 
 void UProvider::HeaderByNumber(const uint64 Id, const TFunction<void (FHeader)>& OnSuccess, const FFailureCallback& OnFailure)
 {
-	HeaderByNumberHelper(ConvertString(IntToHexString(Id)), OnSuccess, OnFailure);
+	HeaderByNumberHelper(ConvertString(IntToHexString(Id)), true, OnSuccess, OnFailure);
 }
 
 void UProvider::HeaderByNumber(const EBlockTag Tag, const TFunction<void (FHeader)>& OnSuccess, const FFailureCallback& OnFailure)
 {
-	HeaderByNumberHelper(ConvertString(UEnum::GetValueAsString(Tag)), OnSuccess, OnFailure);
+	HeaderByNumberHelper(ConvertString(BlockTagToString(Tag)), false, OnSuccess, OnFailure);
 }
 
 void UProvider::HeaderByHash(const FHash256& Hash, TFunction<void (FHeader)> OnSuccess, const FFailureCallback& OnFailure)
@@ -154,13 +378,9 @@ void UProvider::TransactionByHash(const FHash256& Hash, const TFunction<void (TS
 			->EndArray()
 		->ToString();
 
-	const FString MyUrl = this->Url;
-	SendRPCAndExtract<TSharedPtr<FJsonObject>>(Url, Content,
+	SendCachedRPCAndExtract<TSharedPtr<FJsonObject>>(Content, &IsMinedTransaction,
 		OnSuccess,
-		[MyUrl](const FString& Result)
-		{
-			return Make(MyUrl)->ExtractJsonObjectResult(Result);
-		},
+		&TRpcExtractor<TSharedPtr<FJsonObject>>::FromResponse,
 		OnFailure);
 }
 
@@ -173,13 +393,9 @@ void UProvider::TransactionCount(const FAddress& Addr, const uint64 Number, cons
 			->EndArray()
 		->ToString();
 
-	const FString MyUrl = this->Url;
-	SendRPCAndExtract<uint64>(Url, Content,
+	SendReadRPCAndExtract<uint64>(Url, Content,
 		OnSuccess,
-		[MyUrl](const FString& Result)
-		{
-			return Make(MyUrl)->ExtractUIntResult(Result);
-		},
+		&TRpcExtractor<uint64>::FromResponse,
 		OnFailure);
 }
 
@@ -188,17 +404,13 @@ void UProvider::TransactionCount(const FAddress& Addr, const EBlockTag Tag, cons
 	const FString Content = RPCBuilder("eth_getTransactionCount").ToPtr()
 		->AddArray("params").ToPtr()
 			->AddString("0x" + Addr.ToHex())
-			->AddValue(ConvertString(UEnum::GetValueAsString(Tag)))
+			->AddValue(ConvertString(BlockTagToString(Tag)))
 			->EndArray()
 		->ToString();
 
-	const FString MyUrl = this->Url;
-	SendRPCAndExtract<uint64>(Url, Content,
+	SendReadRPCAndExtract<uint64>(Url, Content,
 		OnSuccess,
-		[MyUrl](const FString& Result)
-		{
-			return Make(MyUrl)->ExtractUIntResult(Result);
-		},
+		&TRpcExtractor<uint64>::FromResponse,
 		OnFailure);
 }
 
@@ -209,18 +421,31 @@ void UProvider::GetGasPrice(const TSuccessCallback<FUnsizedData>& OnSuccess, con
 			->EndArray()
 		->ToString();
 
-	const FString MyUrl = this->Url;
-	this->SendRPCAndExtract<FUnsizedData>(Url, Content, OnSuccess, [MyUrl](const FString& Response)
+	this->SendReadRPCAndExtract<FUnsizedData>(Url, Content, OnSuccess, &TRpcExtractor<FUnsizedData>::FromResponse, OnFailure);
+}
+
+void UProvider::FeeHistory(const int32 BlockCount, const EBlockTag Newest, const TArray<float>& RewardPercentiles, const TSuccessCallback<TSharedPtr<FJsonObject>>& OnSuccess, const FFailureCallback& OnFailure)
+{
+	TArray<FString> Percentiles;
+	for (const float Percentile : RewardPercentiles)
 	{
-		TResult<FString> String = Make(MyUrl)->ExtractStringResult(Response);
+		Percentiles.Add(FString::SanitizeFloat(Percentile));
+	}
 
-		if(!String.HasError())
-		{
-			return TResult<FUnsizedData>(MakeValue(HexStringToBinary(String.GetValue())));
-		}
+	const FString Content = RPCBuilder("eth_feeHistory").ToPtr()
+		->AddArray("params").ToPtr()
+			->AddValue(ConvertString(IntToHexString(BlockCount)))
+			->AddValue(ConvertString(BlockTagToString(Newest)))
+			->AddValue("[" + FString::Join(Percentiles, TEXT(",")) + "]")
+			->EndArray()
+		->ToString();
 
-		return TResult<FUnsizedData>(MakeError(FSequenceError(ResponseParseError, "")));
-	}, OnFailure);
+	this->SendReadRPCAndExtract<TSharedPtr<FJsonObject>>(Url, Content, OnSuccess, &TRpcExtractor<TSharedPtr<FJsonObject>>::FromResponse, OnFailure);
+}
+
+TSharedRef<FGasOracle> UProvider::GetGasOracle() const
+{
+	return FGasOracle::Get(this->Url);
 }
 
 void UProvider::EstimateContractCallGas(FContractCall ContractCall, const TSuccessCallback<FUnsizedData>& OnSuccess, const FFailureCallback& OnFailure)
@@ -231,18 +456,7 @@ void UProvider::EstimateContractCallGas(FContractCall ContractCall, const TSucce
 				->EndArray()
 			->ToString();
 
-	const FString MyUrl = this->Url;
-	this->SendRPCAndExtract<FUnsizedData>(Url, Content, OnSuccess, [MyUrl](const FString& Response)
-	{
-		TResult<FString> String = Make(MyUrl)->ExtractStringResult(Response);
-
-		if(!String.HasError())
-		{
-			return TResult<FUnsizedData>(MakeValue(HexStringToBinary(String.GetValue())));
-		}
-
-		return TResult<FUnsizedData>(MakeError(FSequenceError(ResponseParseError, "")));
-	}, OnFailure);
+	this->SendReadRPCAndExtract<FUnsizedData>(Url, Content, OnSuccess, &TRpcExtractor<FUnsizedData>::FromResponse, OnFailure);
 }
 
 void UProvider::EstimateDeploymentGas(const FAddress& From, const FString& Bytecode, const TSuccessCallback<FUnsizedData>& OnSuccess, const FFailureCallback& OnFailure) //byte has ox prefix
@@ -256,50 +470,32 @@ void UProvider::EstimateDeploymentGas(const FAddress& From, const FString& Bytec
 			->EndArray()
 	    ->ToString();
 
-	const FString MyUrl = this->Url;
-	this->SendRPCAndExtract<FUnsizedData>(Url, Content, OnSuccess, [MyUrl](const FString& Response)
-	{
-		TResult<FString> StringResult = Make(MyUrl)->ExtractStringResult(Response);
-
-		if(!StringResult.HasError())
-		{
-			return TResult<FUnsizedData>(MakeValue(HexStringToBinary(StringResult.GetValue())));
-		}
+	this->SendReadRPCAndExtract<FUnsizedData>(Url, Content, OnSuccess, &TRpcExtractor<FUnsizedData>::FromResponse, OnFailure);
+}
 
-		return TResult<FUnsizedData>(MakeError(FSequenceError(ResponseParseError, "")));
-	}, OnFailure);
+TSharedRef<FNonceManager> UProvider::GetNonceManager(const FAddress& Address) const
+{
+	return FNonceManager::Get(this->Url, Address);
 }
 
 void UProvider::DeployContractWithHash(const FString& Bytecode, const FPrivateKey& PrivKey, const int64 ChainId, const TSuccessCallbackTuple<FAddress, FUnsizedData>& OnSuccess, const FFailureCallback& OnFailure)
 {
-	const FAddress From = GetAddress(GetPublicKey(PrivKey));
-	const FString MyUrl = this->Url;
-	
-	TransactionCount(From, EBlockTag::ELatest, [=](uint64 Count)
-	{
-		const FBlockNonce Nonce = FBlockNonce::From(IntToHexString(Count));
+	FTransactionSendRequest Request;
+	Request.PrivateKey = PrivKey;
+	Request.ChainId = ChainId;
+	Request.Data = HexStringToBinary(Bytecode);
 
-		Make(MyUrl)->GetGasPrice([=](const FUnsizedData& GasPrice)
-		{
-			Make(MyUrl)->EstimateDeploymentGas(From, Bytecode, [=](const FUnsizedData& GasLimit)
-			{
-				const FAddress To = FAddress::From("");
-				const FUnsizedData Value = HexStringToBinary("");
-				const FUnsizedData Data = HexStringToBinary(Bytecode);
-
-				FEthTransaction Transaction = FEthTransaction{Nonce, GasPrice, GasLimit, To, Value, Data};
-				const FAddress DeployedAddress = GetContractAddress(From, Nonce);
-				const FUnsizedData SignedTransaction = Transaction.GetSignedTransaction(PrivKey, ChainId);
-
-				Make(MyUrl)->SendRawTransaction("0x" + SignedTransaction.ToHex(), [=](const FUnsizedData& Hash)
-				{
-					OnSuccess(DeployedAddress, Hash);
-				}, OnFailure);
-			}, OnFailure);
-		}, OnFailure);
+	this->SendTransaction(Request, [OnSuccess](const FTransactionSendResult& Result)
+	{
+		OnSuccess(Result.ContractAddress.GetValue(), Result.Hash);
 	}, OnFailure);
 }
 
+void UProvider::SendTransaction(const FTransactionSendRequest& Request, const TSuccessCallback<FTransactionSendResult>& OnSuccess, const FFailureCallback& OnFailure)
+{
+	FTransactionPipeline::Send(this->Url, Request, OnSuccess, OnFailure);
+}
+
 void UProvider::DeployContract(const FString& Bytecode, const FPrivateKey& PrivKey, const int64 ChainId, const TSuccessCallback<FAddress>& OnSuccess, const FFailureCallback& OnFailure)
 {
 	DeployContractWithHash(Bytecode, PrivKey, ChainId, [=](const FAddress& Address, FUnsizedData Hash)
@@ -317,31 +513,27 @@ void UProvider::TransactionReceipt(const FHash256& Hash, const TFunction<void (F
 			->EndArray()
 		->ToString();
 
-	const FString MyUrl = this->Url;
-	SendRPCAndExtract<FTransactionReceipt>(Url, Content,OnSuccess,[MyUrl](const FString& Result)
-		{
-			TResult<TSharedPtr<FJsonObject>> JSON = Make(MyUrl)->ExtractJsonObjectResult(Result);
-			
-			if(!JSON.HasError())
-			{
-				TResult<FTransactionReceipt> Res =  MakeValue(JsonToTransactionReceipt(JSON.GetValue()));
-				return Res;
-			}
+	SendCachedRPCAndExtract<FTransactionReceipt>(Content, &IsMinedReceipt, OnSuccess, &TRpcExtractor<FTransactionReceipt>::FromResponse, OnFailure);
+}
 
-			TResult<FTransactionReceipt> Res = MakeError(JSON.GetError());
-			return Res;
-		},
-		OnFailure);
+int32 UProvider::WaitForReceipt(const FHash256& Hash, const int32 Confirmations, const float TimeoutSeconds, const TSuccessCallback<FTransactionReceipt>& OnSuccess, const FFailureCallback& OnFailure)
+{
+	return FReceiptWatcher::Get(this->Url)->Watch(Hash, Confirmations, TimeoutSeconds, OnSuccess, OnFailure);
+}
+
+void UProvider::CancelWaitForReceipt(const int32 WaitId)
+{
+	FReceiptWatcher::Get(this->Url)->Cancel(WaitId);
 }
 
 void UProvider::NonceAt(const uint64 Number, const TSuccessCallback<FBlockNonce>& OnSuccess, const FFailureCallback& OnFailure)
 {
-	return NonceAtHelper(ConvertString(ConvertInt(Number)), OnSuccess, OnFailure);
+	return NonceAtHelper(ConvertString(ConvertInt(Number)), true, OnSuccess, OnFailure);
 }
 
 void UProvider::NonceAt(const EBlockTag Tag, const TSuccessCallback<FBlockNonce>& OnSuccess, const FFailureCallback& OnFailure)
 {
-	return NonceAtHelper(ConvertString(UEnum::GetValueAsString(Tag)), OnSuccess, OnFailure);
+	return NonceAtHelper(ConvertString(BlockTagToString(Tag)), false, OnSuccess, OnFailure);
 }
 
 void UProvider::SendRawTransaction(const FString& Data, const TSuccessCallback<FUnsizedData>& OnSuccess, const FFailureCallback& OnFailure)
@@ -352,38 +544,23 @@ void UProvider::SendRawTransaction(const FString& Data, const TSuccessCallback<F
 	        ->EndArray()
         ->ToString();
 
-	const FString MyUrl = this->Url;
-	this->SendRPCAndExtract<FUnsizedData>(Url, Content, OnSuccess, [MyUrl](const FString& Response)
-	{
-		TResult<FString> StringResult = Make(MyUrl)->ExtractStringResult(Response);
-
-		if(!StringResult.HasError())
-		{
-			return TResult<FUnsizedData>(MakeValue(HexStringToBinary(StringResult.GetValue())));
-		}
-
-		return TResult<FUnsizedData>(MakeError(FSequenceError(ResponseParseError, "")));
-	}, OnFailure);
+	this->SendRPCAndExtract<FUnsizedData>(Url, Content, OnSuccess, &TRpcExtractor<FUnsizedData>::FromResponse, OnFailure);
 }
 
 void UProvider::ChainId(const TSuccessCallback<uint64>& OnSuccess, const FFailureCallback& OnFailure)
 {
 	const FString Content = RPCBuilder("eth_chainId").ToString();
-	FString MyUrl = this->Url;
-	SendRPCAndExtract<uint64>(Url, Content, OnSuccess, [MyUrl](const FString& Result)
-	{
-		return Make(MyUrl)->ExtractUIntResult(Result);
-	}, OnFailure);
+	SendCachedRPCAndExtract<uint64>(Content, &HasFinalResult<uint64>, OnSuccess, &TRpcExtractor<uint64>::FromResponse, OnFailure);
 }
 
 void UProvider::Call(const FContractCall& ContractCall, const uint64 Number, const TSuccessCallback<FUnsizedData>& OnSuccess, const FFailureCallback& OnFailure) //check if eth_call
 {
-	return CallHelper(ContractCall, ConvertInt(Number), OnSuccess, OnFailure);
+	return CallHelper(ContractCall, ConvertInt(Number), true, OnSuccess, OnFailure);
 }
 
 void UProvider::Call(const FContractCall& ContractCall, const EBlockTag Number, const TSuccessCallback<FUnsizedData>& OnSuccess, const FFailureCallback& OnFailure)
 {
-	return CallHelper(ContractCall, ConvertString(UEnum::GetValueAsString(Number)), OnSuccess, OnFailure);
+	return CallHelper(ContractCall, ConvertString(BlockTagToString(Number)), false, OnSuccess, OnFailure);
 }
 
 void UProvider::NonViewCall(FEthTransaction Transaction, const FPrivateKey& PrivateKey, const int ChainID, const TSuccessCallback<FUnsizedData>& OnSuccess, const FFailureCallback& OnFailure)
@@ -392,7 +569,34 @@ void UProvider::NonViewCall(FEthTransaction Transaction, const FPrivateKey& Priv
 	return SendRawTransaction("0x" + SignedTransaction.ToHex(), OnSuccess, OnFailure);
 }
 
-void UProvider::CallHelper(FContractCall ContractCall, const FString& Number, const TSuccessCallback<FUnsizedData>& OnSuccess, const FFailureCallback& OnFailure)
+void UProvider::NonViewCall(const FAddress& To, const FUnsizedData& Value, const FUnsizedData& Data, const FUnsizedData& GasPrice, const FUnsizedData& GasLimit, const FPrivateKey& PrivateKey, const int ChainID, const TSuccessCallback<FUnsizedData>& OnSuccess, const FFailureCallback& OnFailure)
+{
+	const FAddress From = GetAddress(GetPublicKey(PrivateKey));
+	FTransactionPipeline::SendWithManagedNonce(this->Url, this->GetNonceManager(From), [=](const FBlockNonce& Nonce)
+	{
+		return FEthTransaction{Nonce, GasPrice, GasLimit, To, Value, Data};
+	}, PrivateKey, ChainID, true, nullptr, [OnSuccess](const FBlockNonce& Nonce, const FUnsizedData& Hash)
+	{
+		OnSuccess(Hash);
+	}, OnFailure);
+}
+
+void UProvider::NonViewCall(const FAddress& To, const FUnsizedData& Value, const FUnsizedData& Data, const FPrivateKey& PrivateKey, const int ChainID, const TSuccessCallback<FUnsizedData>& OnSuccess, const FFailureCallback& OnFailure)
+{
+	FTransactionSendRequest Request;
+	Request.PrivateKey = PrivateKey;
+	Request.ChainId = ChainID;
+	Request.To = To;
+	Request.Value = Value;
+	Request.Data = Data;
+
+	this->SendTransaction(Request, [OnSuccess](const FTransactionSendResult& Result)
+	{
+		OnSuccess(Result.Hash);
+	}, OnFailure);
+}
+
+void UProvider::CallHelper(FContractCall ContractCall, const FString& Number, const bool bExplicitBlock, const TSuccessCallback<FUnsizedData>& OnSuccess, const FFailureCallback& OnFailure)
 {
 	const FString Content = RPCBuilder("eth_call").ToPtr()
 		->AddArray("params").ToPtr()
@@ -401,16 +605,5 @@ void UProvider::CallHelper(FContractCall ContractCall, const FString& Number, co
 			->EndArray()
 		->ToString();
 
-	const FString MyUrl = this->Url;
-	this->SendRPCAndExtract<FUnsizedData>(Url, Content, OnSuccess, [MyUrl](const FString& Response)
-	{
-		TResult<FString> StringResult = Make(MyUrl)->ExtractStringResult(Response);
-
-		if(!StringResult.HasError())
-		{
-			return TResult<FUnsizedData>(MakeValue(HexStringToBinary(StringResult.GetValue())));
-		}
-
-		return TResult<FUnsizedData>(MakeError(FSequenceError(ResponseParseError, "")));
-	}, OnFailure);
+	this->SendCachedRPCAndExtract<FUnsizedData>(Content, bExplicitBlock ? &HasFinalResult<FUnsizedData> : &NeverFinal<FUnsizedData>, OnSuccess, &TRpcExtractor<FUnsizedData>::FromResponse, OnFailure);
 }
\ No newline at end of file
@@ -10,9 +10,18 @@
 #include "RPCCaller.h"
 #include "Types/ContractCall.h"
 #include "ProviderEnum.h"
+#include "Util/ResponseCache.h"
+#include "ProviderSubscriptions.h"
 #include "Provider.generated.h"
 
 struct FContractCall;
+class FProviderBatch;
+class FBlockHeadTracker;
+class FProviderEndpoints;
+class FNonceManager;
+class FGasOracle;
+struct FTransactionSendRequest;
+struct FTransactionSendResult;
 
 /**
  * 
@@ -24,15 +33,142 @@ class SEQUENCEPLUGIN_API UProvider : public URPCCaller
 private:
 	FString Url;
 
+	//Every node serving this chain, shared by all providers using the same primary Url
+	TSharedPtr<FProviderEndpoints> Endpoints;
+
+	//Results that can never change (hash addressed, mined or at an explicit block number)
+	TSharedPtr<FResponseCache> ImmutableCache;
+	int64 ImmutableCacheMaxBytes = 4 * 1024 * 1024;
+
+	TSharedRef<FResponseCache> GetImmutableCache();
+
+	/*
+	* Serves Content from the immutable cache synchronously if present, otherwise sends it as a read
+	* and caches the raw response when IsFinal says the extracted value can no longer change
+	*/
+	template<typename T>
+	void SendCachedRPCAndExtract(const FString& Content, const TFunction<bool (const T&)>& IsFinal, const TSuccessCallback<T>& OnSuccess, const TFunction<TResult<T> (FString)>& Extractor, const FFailureCallback& OnFailure)
+	{
+		const TSharedRef<FResponseCache> Cache = this->GetImmutableCache();
+		const TOptional<FString> Cached = Cache->Find(Content);
+		if (Cached.IsSet())
+		{
+			TResult<T> Value = Extractor(Cached.GetValue());
+			if (Value.HasValue())
+			{
+				OnSuccess(Value.GetValue());
+				return;
+			}
+			Cache->Remove(Content);
+		}
+
+		SendReadRPC(this->Url, Content, [Cache, Content, IsFinal, OnSuccess, Extractor, OnFailure](const FString& Response)
+		{
+			TResult<T> Value = Extractor(Response);
+			if (!Value.HasValue())
+			{
+				OnFailure(Value.GetError());
+				return;
+			}
+
+			if (IsFinal(Value.GetValue()))
+			{
+				Cache->Add(Content, Response);
+			}
+			OnSuccess(Value.GetValue());
+		}, OnFailure);
+	}
+
 //helpers
-	void BlockByNumberHelper(const FString& Number, const TSuccessCallback<TSharedPtr<FJsonObject>>& OnSuccess, const FFailureCallback& OnFailure);
-	void HeaderByNumberHelper(const FString& Number, TSuccessCallback<FHeader> OnSuccess, const FFailureCallback& OnFailure);
-	void NonceAtHelper(const FString& Number, TSuccessCallback<FBlockNonce> OnSuccess, const FFailureCallback& OnFailure);
-	void CallHelper(FContractCall ContractCall, const FString& Number, const TSuccessCallback<FUnsizedData>& OnSuccess, const FFailureCallback& OnFailure);
+	void BlockByNumberHelper(const FString& Number, const bool bExplicitBlock, const TSuccessCallback<TSharedPtr<FJsonObject>>& OnSuccess, const FFailureCallback& OnFailure);
+	void HeaderByNumberHelper(const FString& Number, const bool bExplicitBlock, TSuccessCallback<FHeader> OnSuccess, const FFailureCallback& OnFailure);
+	void NonceAtHelper(const FString& Number, const bool bExplicitBlock, TSuccessCallback<FBlockNonce> OnSuccess, const FFailureCallback& OnFailure);
+	void CallHelper(FContractCall ContractCall, const FString& Number, const bool bExplicitBlock, const TSuccessCallback<FUnsizedData>& OnSuccess, const FFailureCallback& OnFailure);
 	void Init(const FString& UrlIn);
+protected:
+	/*
+	* Routes reads to the fastest healthy endpoint with failover and pins writes to a single endpoint
+	*/
+	virtual void PostRPC(const FString& RequestUrl, const FString& Content, bool bIdempotent, const TSuccessCallback<FString>& OnSuccess, const FFailureCallback& OnFailure) override;
 public:
 	static UProvider* Make(const FString& UrlIn);
+
+	/**
+	 * Makes a provider backed by several RPC nodes serving the same chain.
+	 * Reads go to the fastest healthy node and fail over to the others, writes stay on one node.
+	 * @param Urls Endpoints in order of preference, the first one identifies the chain
+	 * @return nullptr if Urls is empty
+	 */
+	static UProvider* Make(const TArray<FString>& Urls);
 	void UpdateUrl(const FString& UrlIn);
+
+	/*
+	* Replaces the endpoint set, an empty list is ignored
+	*/
+	void UpdateUrls(const TArray<FString>& Urls);
+
+	/**
+	 * @return the endpoint set this provider routes its requests through
+	 */
+	TSharedRef<FProviderEndpoints> GetEndpoints() const;
+
+	/**
+	 * Creates a batch bound to this provider's Url, calls queued on it are sent
+	 * together as a single JSON-RPC request when FProviderBatch::Send is called
+	 * @return A new empty batch
+	 */
+	TSharedRef<FProviderBatch> NewBatch() const;
+
+	/**
+	 * Gets the head tracker shared by every provider pointed at this Url,
+	 * use it to follow chain progress instead of polling BlockNumber on a timer
+	 */
+	TSharedRef<FBlockHeadTracker> GetHeadTracker() const;
+
+	/**
+	 * Sets the WebSocket endpoint of this chain, shared by every provider pointed at this Url.
+	 * Subscriptions need it and the head tracker follows newHeads instead of polling once it is set.
+	 * @param WebSocketUrl e.g. ws://127.0.0.1:8545
+	 */
+	void SetWebSocketUrl(const FString& WebSocketUrl);
+
+	/**
+	 * @return the subscriptions of this chain, null until SetWebSocketUrl was called for this Url
+	 */
+	TSharedPtr<FProviderSubscriptions> GetSubscriptions() const;
+
+	/**
+	 * Subscribes to new block headers, see FProviderSubscriptions for reconnection behaviour
+	 * @return Id used to unsubscribe, INDEX_NONE if no WebSocket url is set
+	 */
+	int32 SubscribeNewHeads(const TSuccessCallback<FHeader>& OnHeader, const FFailureCallback& OnFailure);
+
+	/**
+	 * Subscribes to logs matching Filter, logs dropped by a reorg are sent again with "removed" set to true
+	 * @return Id used to unsubscribe, INDEX_NONE if no WebSocket url is set
+	 */
+	int32 SubscribeLogs(const FLogFilter& Filter, const TSuccessCallback<TSharedPtr<FJsonObject>>& OnLog, const FFailureCallback& OnFailure);
+
+	/**
+	 * Subscribes to the hashes of transactions entering the node's pool
+	 * @return Id used to unsubscribe, INDEX_NONE if no WebSocket url is set
+	 */
+	int32 SubscribePendingTransactions(const TSuccessCallback<FHash256>& OnTransaction, const FFailureCallback& OnFailure);
+
+	void Unsubscribe(const int32 SubscriptionId);
+
+	/**
+	 * Sets the memory budget of the cache holding immutable results
+	 * (blocks by hash, mined transactions & receipts, chain id, calls at an explicit block)
+	 * @param MaxBytes Budget in bytes, 0 disables caching
+	 */
+	void SetImmutableCacheSize(const int64 MaxBytes);
+
+	/**
+	 * Drops every cached immutable result
+	 */
+	void ClearImmutableCache();
+
 	void BlockByNumber(const uint64 Number, const TSuccessCallback<TSharedPtr<FJsonObject>>& OnSuccess, const FFailureCallback& OnFailure);
 	void BlockByNumber(const EBlockTag Tag, const TSuccessCallback<TSharedPtr<FJsonObject>>& OnSuccess, const FFailureCallback& OnFailure);
 	void BlockByHash(const FHash256& Hash, const TSuccessCallback<TSharedPtr<FJsonObject>>& OnSuccess, const FFailureCallback& OnFailure);
@@ -47,12 +183,41 @@ public:
 	void TransactionCount(const FAddress& Addr, const EBlockTag Tag, const TSuccessCallback<uint64>& OnSuccess, const FFailureCallback& OnFailure);
 	void TransactionReceipt(const FHash256& Hash, const TSuccessCallback<FTransactionReceipt>& OnSuccess, const FFailureCallback& OnFailure);
 
+	/**
+	 * Waits for Hash to be mined and buried under enough blocks, pending hashes of this chain are checked
+	 * together once per block, see FReceiptWatcher
+	 * @param Confirmations Depth of the receipt block required, 1 returns as soon as it is mined
+	 * @param TimeoutSeconds 0 waits forever
+	 * @param OnFailure RequestTimeExceeded, or TransactionDropped if the transaction was reorged out and not mined again in time
+	 * @return Id used to stop waiting with CancelWaitForReceipt
+	 */
+	int32 WaitForReceipt(const FHash256& Hash, const int32 Confirmations, const float TimeoutSeconds, const TSuccessCallback<FTransactionReceipt>& OnSuccess, const FFailureCallback& OnFailure);
+	void CancelWaitForReceipt(const int32 WaitId);
+
 	void GetGasPrice(const TSuccessCallback<FUnsizedData>& OnSuccess, const FFailureCallback& OnFailure);
+
+	/**
+	 * eth_feeHistory, the result holds oldestBlock, baseFeePerGas, gasUsedRatio and reward
+	 * @param RewardPercentiles Priority fee percentiles sampled in each block, ascending
+	 */
+	void FeeHistory(const int32 BlockCount, const EBlockTag Newest, const TArray<float>& RewardPercentiles, const TSuccessCallback<TSharedPtr<FJsonObject>>& OnSuccess, const FFailureCallback& OnFailure);
+
+	/**
+	 * @return the gas oracle of this chain, shared by every provider pointed at this Url
+	 */
+	TSharedRef<FGasOracle> GetGasOracle() const;
+
 	void EstimateContractCallGas(FContractCall ContractCall, const TSuccessCallback<FUnsizedData>& OnSuccess, const FFailureCallback& OnFailure);
 	void EstimateDeploymentGas(const FAddress& From, const FString& Bytecode, const TSuccessCallback<FUnsizedData>& OnSuccess, const FFailureCallback& OnFailure);
 
 	void DeployContract(const FString& Bytecode, const FPrivateKey& PrivKey, const int64 ChainId, const TSuccessCallback<FAddress>& OnSuccess, const FFailureCallback& OnFailure);
 	void DeployContractWithHash(const FString& Bytecode, const FPrivateKey& PrivKey, const int64 ChainId, const TSuccessCallbackTuple<FAddress, FUnsizedData>& OnSuccess, const FFailureCallback& OnFailure);
+
+	/**
+	 * Signs and sends a transaction through FTransactionPipeline, the nonce, gas price and gas limit
+	 * lookups left to it run side by side. The result carries the time spent in each stage.
+	 */
+	void SendTransaction(const FTransactionSendRequest& Request, const TSuccessCallback<FTransactionSendResult>& OnSuccess, const FFailureCallback& OnFailure);
 	
 	void NonceAt(const uint64 Number, const TSuccessCallback<FBlockNonce>& OnSuccess, const FFailureCallback& OnFailure);
 	void NonceAt(const EBlockTag Tag, const TSuccessCallback<FBlockNonce>& OnSuccess, const FFailureCallback& OnFailure);
@@ -63,4 +228,21 @@ public:
 	void Call(const FContractCall& ContractCall, const uint64 Number, const TSuccessCallback<FUnsizedData>& OnSuccess, const FFailureCallback& OnFailure);
 	void Call(const FContractCall& ContractCall, const EBlockTag Number, const TSuccessCallback<FUnsizedData>& OnSuccess, const FFailureCallback& OnFailure);
 	void NonViewCall(FEthTransaction Transaction, const FPrivateKey& PrivateKey, const int ChainID, const TSuccessCallback<FUnsizedData>& OnSuccess, const FFailureCallback& OnFailure);
+
+	/**
+	 * Same as above with the nonce taken from the signer's FNonceManager instead of being fetched,
+	 * so transactions of one signer can be sent back to back without waiting on each other.
+	 * A "nonce too low" rejection resyncs the manager and is retried once with a fresh nonce.
+	 */
+	void NonViewCall(const FAddress& To, const FUnsizedData& Value, const FUnsizedData& Data, const FUnsizedData& GasPrice, const FUnsizedData& GasLimit, const FPrivateKey& PrivateKey, const int ChainID, const TSuccessCallback<FUnsizedData>& OnSuccess, const FFailureCallback& OnFailure);
+
+	/**
+	 * Same as above with the gas price taken from the gas oracle and the gas limit estimated, both alongside the nonce
+	 */
+	void NonViewCall(const FAddress& To, const FUnsizedData& Value, const FUnsizedData& Data, const FPrivateKey& PrivateKey, const int ChainID, const TSuccessCallback<FUnsizedData>& OnSuccess, const FFailureCallback& OnFailure);
+
+	/**
+	 * @return the nonce manager of Address on this chain, shared by every provider pointed at this Url
+	 */
+	TSharedRef<FNonceManager> GetNonceManager(const FAddress& Address) const;
 };
\ No newline at end of file
@@ -0,0 +1,332 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+#include "ProviderBatch.h"
+#include "RPCCaller.h"
+#include "RpcExtractors.h"
+#include "Http/HttpRequestPool.h"
+#include "Http/HttpCompression.h"
+#include "Util/HexUtility.h"
+#include "Util/JsonBuilder.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+FProviderBatch::FProviderBatch(const FString& UrlIn) : Url(UrlIn)
+{
+}
+
+int32 FProviderBatch::Num() const
+{
+	return this->Entries.Num();
+}
+
+template<typename T>
+void FProviderBatch::Enqueue(const int32 Id, const FString& Content, const TFunction<TResult<T> (TSharedPtr<FJsonObject>)>& Extractor, const TSuccessCallback<T>& OnSuccess, const FFailureCallback& OnFailure)
+{
+	if (this->bSent)
+	{
+		OnFailure(FSequenceError(RequestFail, "Batch has already been sent"));
+		return;
+	}
+
+	FBatchEntry Entry;
+	Entry.Id = Id;
+	Entry.Content = Content;
+	Entry.OnFailure = OnFailure;
+	Entry.OnResponse = [Extractor, OnSuccess, OnFailure](const TSharedPtr<FJsonObject>& Json)
+	{
+		TResult<T> Value = Extractor(Json);
+
+		if (Value.HasValue())
+		{
+			OnSuccess(Value.GetValue());
+		}
+		else
+		{
+			OnFailure(Value.GetError());
+		}
+	};
+	this->Entries.Add(Entry);
+}
+
+void FProviderBatch::EnqueueUInt(const int32 Id, const FString& Content, const TSuccessCallback<uint64>& OnSuccess, const FFailureCallback& OnFailure)
+{
+	this->Enqueue<uint64>(Id, Content, &TRpcExtractor<uint64>::FromJson, OnSuccess, OnFailure);
+}
+
+void FProviderBatch::EnqueueData(const int32 Id, const FString& Content, const TSuccessCallback<FUnsizedData>& OnSuccess, const FFailureCallback& OnFailure)
+{
+	this->Enqueue<FUnsizedData>(Id, Content, &TRpcExtractor<FUnsizedData>::FromJson, OnSuccess, OnFailure);
+}
+
+void FProviderBatch::EnqueueJsonObject(const int32 Id, const FString& Content, const TSuccessCallback<TSharedPtr<FJsonObject>>& OnSuccess, const FFailureCallback& OnFailure)
+{
+	this->Enqueue<TSharedPtr<FJsonObject>>(Id, Content, &TRpcExtractor<TSharedPtr<FJsonObject>>::FromJson, OnSuccess, OnFailure);
+}
+
+void FProviderBatch::BlockNumber(const TSuccessCallback<uint64>& OnSuccess, const FFailureCallback& OnFailure)
+{
+	const int32 Id = this->NextId++;
+	const FString Content = URPCCaller::RPCBuilder("eth_blockNumber", Id).ToString();
+	this->EnqueueUInt(Id, Content, OnSuccess, OnFailure);
+}
+
+void FProviderBatch::ChainId(const TSuccessCallback<uint64>& OnSuccess, const FFailureCallback& OnFailure)
+{
+	const int32 Id = this->NextId++;
+	const FString Content = URPCCaller::RPCBuilder("eth_chainId", Id).ToString();
+	this->EnqueueUInt(Id, Content, OnSuccess, OnFailure);
+}
+
+void FProviderBatch::GetGasPrice(const TSuccessCallback<FUnsizedData>& OnSuccess, const FFailureCallback& OnFailure)
+{
+	const int32 Id = this->NextId++;
+	const FString Content = URPCCaller::RPCBuilder("eth_gasPrice", Id).ToPtr()
+		->AddArray("params").ToPtr()
+			->EndArray()
+		->ToString();
+	this->EnqueueData(Id, Content, OnSuccess, OnFailure);
+}
+
+void FProviderBatch::FeeHistory(const int32 BlockCount, const EBlockTag Newest, const TArray<float>& RewardPercentiles, const TSuccessCallback<TSharedPtr<FJsonObject>>& OnSuccess, const FFailureCallback& OnFailure)
+{
+	TArray<FString> Percentiles;
+	for (const float Percentile : RewardPercentiles)
+	{
+		Percentiles.Add(FString::SanitizeFloat(Percentile));
+	}
+
+	const int32 Id = this->NextId++;
+	const FString Content = URPCCaller::RPCBuilder("eth_feeHistory", Id).ToPtr()
+		->AddArray("params").ToPtr()
+			->AddValue(ConvertString(IntToHexString(BlockCount)))
+			->AddValue(ConvertString(BlockTagToString(Newest)))
+			->AddValue("[" + FString::Join(Percentiles, TEXT(",")) + "]")
+			->EndArray()
+		->ToString();
+	this->EnqueueJsonObject(Id, Content, OnSuccess, OnFailure);
+}
+
+void FProviderBatch::BlockByNumberHelper(const FString& Number, const TSuccessCallback<TSharedPtr<FJsonObject>>& OnSuccess, const FFailureCallback& OnFailure)
+{
+	const int32 Id = this->NextId++;
+	const FString Content = URPCCaller::RPCBuilder("eth_getBlockByNumber", Id).ToPtr()
+		->AddArray("params").ToPtr()
+			->AddValue(Number)
+			->AddBool(true)
+			->EndArray()
+		->ToString();
+	this->EnqueueJsonObject(Id, Content, OnSuccess, OnFailure);
+}
+
+void FProviderBatch::BlockByNumber(const uint64 Number, const TSuccessCallback<TSharedPtr<FJsonObject>>& OnSuccess, const FFailureCallback& OnFailure)
+{
+	this->BlockByNumberHelper(ConvertString(IntToHexString(Number)), OnSuccess, OnFailure);
+}
+
+void FProviderBatch::BlockByNumber(const EBlockTag Tag, const TSuccessCallback<TSharedPtr<FJsonObject>>& OnSuccess, const FFailureCallback& OnFailure)
+{
+	this->BlockByNumberHelper(ConvertString(BlockTagToString(Tag)), OnSuccess, OnFailure);
+}
+
+void FProviderBatch::BlockByHash(const FHash256& Hash, const TSuccessCallback<TSharedPtr<FJsonObject>>& OnSuccess, const FFailureCallback& OnFailure)
+{
+	const int32 Id = this->NextId++;
+	const FString Content = URPCCaller::RPCBuilder("eth_getBlockByHash", Id).ToPtr()
+		->AddArray("params").ToPtr()
+			->AddString("0x" + Hash.ToHex())
+			->AddBool(true)
+			->EndArray()
+		->ToString();
+	this->EnqueueJsonObject(Id, Content, OnSuccess, OnFailure);
+}
+
+void FProviderBatch::TransactionByHash(const FHash256& Hash, const TSuccessCallback<TSharedPtr<FJsonObject>>& OnSuccess, const FFailureCallback& OnFailure)
+{
+	const int32 Id = this->NextId++;
+	const FString Content = URPCCaller::RPCBuilder("eth_getTransactionByHash", Id).ToPtr()
+		->AddArray("params").ToPtr()
+			->AddString("0x" + Hash.ToHex())
+			->EndArray()
+		->ToString();
+	this->EnqueueJsonObject(Id, Content, OnSuccess, OnFailure);
+}
+
+void FProviderBatch::TransactionCountHelper(const FAddress& Addr, const FString& Number, const TSuccessCallback<uint64>& OnSuccess, const FFailureCallback& OnFailure)
+{
+	const int32 Id = this->NextId++;
+	const FString Content = URPCCaller::RPCBuilder("eth_getTransactionCount", Id).ToPtr()
+		->AddArray("params").ToPtr()
+			->AddString("0x" + Addr.ToHex())
+			->AddValue(Number)
+			->EndArray()
+		->ToString();
+	this->EnqueueUInt(Id, Content, OnSuccess, OnFailure);
+}
+
+void FProviderBatch::TransactionCount(const FAddress& Addr, const uint64 Number, const TSuccessCallback<uint64>& OnSuccess, const FFailureCallback& OnFailure)
+{
+	this->TransactionCountHelper(Addr, ConvertString(IntToHexString(Number)), OnSuccess, OnFailure);
+}
+
+void FProviderBatch::TransactionCount(const FAddress& Addr, const EBlockTag Tag, const TSuccessCallback<uint64>& OnSuccess, const FFailureCallback& OnFailure)
+{
+	this->TransactionCountHelper(Addr, ConvertString(BlockTagToString(Tag)), OnSuccess, OnFailure);
+}
+
+void FProviderBatch::TransactionReceipt(const FHash256& Hash, const TSuccessCallback<FTransactionReceipt>& OnSuccess, const FFailureCallback& OnFailure)
+{
+	const int32 Id = this->NextId++;
+	const FString Content = URPCCaller::RPCBuilder("eth_getTransactionReceipt", Id).ToPtr()
+		->AddArray("params").ToPtr()
+			->AddString("0x" + Hash.ToHex())
+			->EndArray()
+		->ToString();
+
+	this->Enqueue<FTransactionReceipt>(Id, Content, &TRpcExtractor<FTransactionReceipt>::FromJson, OnSuccess, OnFailure);
+}
+
+void FProviderBatch::EstimateContractCallGas(FContractCall ContractCall, const TSuccessCallback<FUnsizedData>& OnSuccess, const FFailureCallback& OnFailure)
+{
+	const int32 Id = this->NextId++;
+	const FString Content = URPCCaller::RPCBuilder("eth_estimateGas", Id).ToPtr()
+		->AddArray("params").ToPtr()
+			->AddValue(ContractCall.GetJson())
+			->EndArray()
+		->ToString();
+	this->EnqueueData(Id, Content, OnSuccess, OnFailure);
+}
+
+void FProviderBatch::CallHelper(FContractCall ContractCall, const FString& Number, const TSuccessCallback<FUnsizedData>& OnSuccess, const FFailureCallback& OnFailure)
+{
+	const int32 Id = this->NextId++;
+	const FString Content = URPCCaller::RPCBuilder("eth_call", Id).ToPtr()
+		->AddArray("params").ToPtr()
+			->AddValue(ContractCall.GetJson())
+			->AddValue(Number)
+			->EndArray()
+		->ToString();
+	this->EnqueueData(Id, Content, OnSuccess, OnFailure);
+}
+
+void FProviderBatch::Call(const FContractCall& ContractCall, const uint64 Number, const TSuccessCallback<FUnsizedData>& OnSuccess, const FFailureCallback& OnFailure)
+{
+	this->CallHelper(ContractCall, ConvertString(IntToHexString(Number)), OnSuccess, OnFailure);
+}
+
+void FProviderBatch::Call(const FContractCall& ContractCall, const EBlockTag Number, const TSuccessCallback<FUnsizedData>& OnSuccess, const FFailureCallback& OnFailure)
+{
+	this->CallHelper(ContractCall, ConvertString(BlockTagToString(Number)), OnSuccess, OnFailure);
+}
+
+FString FProviderBatch::BuildContent() const
+{
+	FString Content = "[";
+	for (int32 i = 0; i < this->Entries.Num(); i++)
+	{
+		if (i > 0)
+		{
+			Content += ", ";
+		}
+		Content += this->Entries[i].Content;
+	}
+	Content += "]";
+	return Content;
+}
+
+void FProviderBatch::Send()
+{
+	if (this->bSent || this->Entries.Num() == 0)
+	{
+		return;
+	}
+	this->bSent = true;
+
+	//the request keeps the batch alive until the response has been dispatched
+	TSharedRef<FProviderBatch> Batch = AsShared();
+	const TSuccessCallback<FHttpResponsePtr> OnSuccess = [Batch](const FHttpResponsePtr& Response)
+	{
+		TArray<uint8> Decoded;
+		Batch->DispatchResponse(FHttpCompression::GetContent(Response, Decoded));
+	};
+
+	const FFailureCallback OnFailure = [Batch](const FSequenceError& Error)
+	{
+		Batch->DispatchFailure(Error);
+	};
+
+	const TSharedRef<FHttpRequestDescriptor> Descriptor = FHttpRequestPool::Acquire();
+	Descriptor->Url = this->Url;
+	Descriptor->SharedHeaders = FHttpHeaderSets::Json();
+	Descriptor->Content = this->BuildContent();
+	Descriptor->bIdempotent = true;
+	Descriptor->Category = ERequestCategory::Rpc;
+	FHttpExecutor::ExecuteAndThen(Descriptor, FRequestPolicies::GetPolicy(this->Url), OnSuccess, OnFailure);
+}
+
+void FProviderBatch::DispatchResponse(const FString& Response)
+{
+	const FTCHARToUTF8 Utf8(*Response);
+	this->DispatchResponse(TConstArrayView<uint8>(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length()));
+}
+
+void FProviderBatch::DispatchResponse(const TConstArrayView<uint8> Response)
+{
+	TArray<TSharedPtr<FJsonValue>> Responses;
+	const FUtf8StringView View(reinterpret_cast<const UTF8CHAR*>(Response.GetData()), Response.Num());
+	const TSharedRef<TJsonReader<UTF8CHAR>> JsonReader = TJsonReaderFactory<UTF8CHAR>::CreateFromView(View);
+	if (!FJsonSerializer::Deserialize(JsonReader, Responses))
+	{
+		//nodes that reject a whole batch reply with a single error object instead of an array
+		const TSharedPtr<FJsonObject> Json = URPCCaller::Parse(Response);
+		const TSharedPtr<FJsonObject>* Error;
+		if (Json && Json->TryGetObjectField(TEXT("error"), Error))
+		{
+			this->DispatchFailure(FSequenceError(RequestFail, "Batch rejected: " + (*Error)->GetStringField(TEXT("message"))));
+		}
+		else
+		{
+			this->DispatchFailure(FSequenceError(ResponseParseError, "Could not parse batch response: " + UTF8BytesToString(Response)));
+		}
+		return;
+	}
+
+	TMap<int32, TSharedPtr<FJsonObject>> ResponsesById;
+	for (const TSharedPtr<FJsonValue>& Value : Responses)
+	{
+		const TSharedPtr<FJsonObject>* Json;
+		int32 Id;
+		if (Value.IsValid() && Value->TryGetObject(Json) && (*Json)->TryGetNumberField(TEXT("id"), Id))
+		{
+			ResponsesById.Add(Id, *Json);
+		}
+	}
+
+	for (const FBatchEntry& Entry : this->Entries)
+	{
+		const TSharedPtr<FJsonObject>* Json = ResponsesById.Find(Entry.Id);
+		if (!Json)
+		{
+			//a missing id is a malformed reply, EmptyResponse is kept for calls that answered with a null result
+			Entry.OnFailure(FSequenceError(ResponseParseError, FString::Printf(TEXT("No response for batch id %d"), Entry.Id)));
+			continue;
+		}
+
+		const TSharedPtr<FJsonObject>* Error;
+		if ((*Json)->TryGetObjectField(TEXT("error"), Error))
+		{
+			Entry.OnFailure(FSequenceError(RequestFail, "RPC Error: " + (*Error)->GetStringField(TEXT("message"))));
+			continue;
+		}
+
+		Entry.OnResponse(*Json);
+	}
+	this->Entries.Empty();
+}
+
+void FProviderBatch::DispatchFailure(const FSequenceError& Error)
+{
+	for (const FBatchEntry& Entry : this->Entries)
+	{
+		Entry.OnFailure(Error);
+	}
+	this->Entries.Empty();
+}
@@ -0,0 +1,94 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+#pragma once
+#include "CoreMinimal.h"
+#include "Util/Async.h"
+#include "Types/BinaryData.h"
+#include "Types/ContractCall.h"
+#include "Types/TransactionReceipt.h"
+#include "Dom/JsonObject.h"
+#include "ProviderEnum.h"
+
+/**
+ * Queues typed JSON-RPC calls and sends them to the node as one JSON-RPC 2.0 batch.
+ * Each call gets its own id, responses are matched back by id and fanned out to
+ * the OnSuccess / OnFailure pair given when the call was queued.
+ * Obtain one from UProvider::NewBatch(), queue calls, then call Send() once.
+ */
+class SEQUENCEPLUGIN_API FProviderBatch : public TSharedFromThis<FProviderBatch>
+{
+	struct FBatchEntry
+	{
+		int32 Id = 0;
+		FString Content;
+		TFunction<void (TSharedPtr<FJsonObject>)> OnResponse;
+		FFailureCallback OnFailure;
+	};
+
+	FString Url;
+	TArray<FBatchEntry> Entries;
+	int32 NextId = 1;
+	bool bSent = false;
+
+	/*
+	* Id must be the id Content was built with, responses are matched to the entry by it
+	*/
+	template<typename T>
+	void Enqueue(int32 Id, const FString& Content, const TFunction<TResult<T> (TSharedPtr<FJsonObject>)>& Extractor, const TSuccessCallback<T>& OnSuccess, const FFailureCallback& OnFailure);
+
+	void EnqueueUInt(int32 Id, const FString& Content, const TSuccessCallback<uint64>& OnSuccess, const FFailureCallback& OnFailure);
+	void EnqueueData(int32 Id, const FString& Content, const TSuccessCallback<FUnsizedData>& OnSuccess, const FFailureCallback& OnFailure);
+	void EnqueueJsonObject(int32 Id, const FString& Content, const TSuccessCallback<TSharedPtr<FJsonObject>>& OnSuccess, const FFailureCallback& OnFailure);
+
+	void BlockByNumberHelper(const FString& Number, const TSuccessCallback<TSharedPtr<FJsonObject>>& OnSuccess, const FFailureCallback& OnFailure);
+	void TransactionCountHelper(const FAddress& Addr, const FString& Number, const TSuccessCallback<uint64>& OnSuccess, const FFailureCallback& OnFailure);
+	void CallHelper(FContractCall ContractCall, const FString& Number, const TSuccessCallback<FUnsizedData>& OnSuccess, const FFailureCallback& OnFailure);
+public:
+	explicit FProviderBatch(const FString& UrlIn);
+
+	/**
+	 * @return the number of calls currently queued in this batch
+	 */
+	int32 Num() const;
+
+	void BlockNumber(const TSuccessCallback<uint64>& OnSuccess, const FFailureCallback& OnFailure);
+	void ChainId(const TSuccessCallback<uint64>& OnSuccess, const FFailureCallback& OnFailure);
+	void GetGasPrice(const TSuccessCallback<FUnsizedData>& OnSuccess, const FFailureCallback& OnFailure);
+	void FeeHistory(const int32 BlockCount, const EBlockTag Newest, const TArray<float>& RewardPercentiles, const TSuccessCallback<TSharedPtr<FJsonObject>>& OnSuccess, const FFailureCallback& OnFailure);
+	void BlockByNumber(const uint64 Number, const TSuccessCallback<TSharedPtr<FJsonObject>>& OnSuccess, const FFailureCallback& OnFailure);
+	void BlockByNumber(const EBlockTag Tag, const TSuccessCallback<TSharedPtr<FJsonObject>>& OnSuccess, const FFailureCallback& OnFailure);
+	void BlockByHash(const FHash256& Hash, const TSuccessCallback<TSharedPtr<FJsonObject>>& OnSuccess, const FFailureCallback& OnFailure);
+	void TransactionByHash(const FHash256& Hash, const TSuccessCallback<TSharedPtr<FJsonObject>>& OnSuccess, const FFailureCallback& OnFailure);
+	void TransactionCount(const FAddress& Addr, const uint64 Number, const TSuccessCallback<uint64>& OnSuccess, const FFailureCallback& OnFailure);
+	void TransactionCount(const FAddress& Addr, const EBlockTag Tag, const TSuccessCallback<uint64>& OnSuccess, const FFailureCallback& OnFailure);
+	void TransactionReceipt(const FHash256& Hash, const TSuccessCallback<FTransactionReceipt>& OnSuccess, const FFailureCallback& OnFailure);
+	void EstimateContractCallGas(FContractCall ContractCall, const TSuccessCallback<FUnsizedData>& OnSuccess, const FFailureCallback& OnFailure);
+	void Call(const FContractCall& ContractCall, const uint64 Number, const TSuccessCallback<FUnsizedData>& OnSuccess, const FFailureCallback& OnFailure);
+	void Call(const FContractCall& ContractCall, const EBlockTag Number, const TSuccessCallback<FUnsizedData>& OnSuccess, const FFailureCallback& OnFailure);
+
+	/**
+	 * @return the JSON-RPC array that Send() will post
+	 */
+	FString BuildContent() const;
+
+	/**
+	 * Posts every queued call as a single request, a batch can only be sent once
+	 */
+	void Send();
+
+	/**
+	 * Matches a raw batch response to the queued calls by id and fires their callbacks,
+	 * calls missing from the response are failed
+	 * @param Response Raw JSON-RPC batch response
+	 */
+	void DispatchResponse(const FString& Response);
+
+	/**
+	 * Same as above for the raw UTF-8 response body, which is parsed without being copied into a string
+	 */
+	void DispatchResponse(TConstArrayView<uint8> Response);
+
+	/**
+	 * Fails every queued call with the given error
+	 */
+	void DispatchFailure(const FSequenceError& Error);
+};
@@ -0,0 +1,200 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+#include "ProviderEndpoints.h"
+
+static TMap<FString, TSharedRef<FProviderEndpoints>>& EndpointSets()
+{
+	static TMap<FString, TSharedRef<FProviderEndpoints>> Registry;
+	return Registry;
+}
+
+FProviderEndpoints::FProviderEndpoints(const TArray<FString>& Urls)
+{
+	for (const FString& Url : Urls)
+	{
+		FEndpoint Endpoint;
+		Endpoint.Url = Url;
+		this->Endpoints.Add(Endpoint);
+	}
+}
+
+TSharedRef<FProviderEndpoints> FProviderEndpoints::Get(const FString& PrimaryUrl)
+{
+	if (const TSharedRef<FProviderEndpoints>* Set = EndpointSets().Find(PrimaryUrl))
+	{
+		return *Set;
+	}
+
+	const TSharedRef<FProviderEndpoints> Set = MakeShared<FProviderEndpoints>(TArray<FString>{PrimaryUrl});
+	EndpointSets().Add(PrimaryUrl, Set);
+	return Set;
+}
+
+TSharedRef<FProviderEndpoints> FProviderEndpoints::Register(const TArray<FString>& Urls)
+{
+	check(Urls.Num() > 0);
+	const TSharedRef<FProviderEndpoints> Set = Get(Urls[0]);
+
+	TArray<FEndpoint> Updated;
+	for (const FString& Url : Urls)
+	{
+		const FEndpoint* Known = Set->Endpoints.FindByPredicate([&Url](const FEndpoint& Endpoint){ return Endpoint.Url.Equals(Url); });
+		if (Known)
+		{
+			Updated.Add(*Known);
+		}
+		else
+		{
+			FEndpoint Endpoint;
+			Endpoint.Url = Url;
+			Updated.Add(Endpoint);
+		}
+	}
+
+	Set->Endpoints = Updated;
+	Set->PinnedWrite = INDEX_NONE;
+	return Set;
+}
+
+void FProviderEndpoints::SetExploreRate(const float Rate)
+{
+	this->ExploreRate = FMath::Clamp(Rate, 0.0f, 1.0f);
+}
+
+int32 FProviderEndpoints::Num() const
+{
+	return this->Endpoints.Num();
+}
+
+FString FProviderEndpoints::GetUrl(const int32 Index) const
+{
+	return this->Endpoints[Index].Url;
+}
+
+FString FProviderEndpoints::GetPrimaryUrl() const
+{
+	return this->Endpoints[0].Url;
+}
+
+bool FProviderEndpoints::IsHealthy(const FEndpoint& Endpoint, const double Now) const
+{
+	return Endpoint.CooldownUntil <= Now;
+}
+
+double FProviderEndpoints::Score(const FEndpoint& Endpoint) const
+{
+	//nodes without samples are tried first so every node gets measured
+	if (Endpoint.Samples == 0)
+	{
+		return 0.0;
+	}
+	return Endpoint.LatencySeconds * (1.0 + 4.0 * Endpoint.ErrorRate);
+}
+
+int32 FProviderEndpoints::SelectForRead(const TSet<int32>& Excluded) const
+{
+	const double Now = FPlatformTime::Seconds();
+
+	TArray<int32> Healthy;
+	int32 SoonestRecovered = INDEX_NONE;
+	for (int32 i = 0; i < this->Endpoints.Num(); i++)
+	{
+		if (Excluded.Contains(i))
+		{
+			continue;
+		}
+
+		if (this->IsHealthy(this->Endpoints[i], Now))
+		{
+			Healthy.Add(i);
+		}
+		else if (SoonestRecovered == INDEX_NONE || this->Endpoints[i].CooldownUntil < this->Endpoints[SoonestRecovered].CooldownUntil)
+		{
+			SoonestRecovered = i;
+		}
+	}
+
+	//every remaining node is cooling down, still try the one closest to recovery rather than fail outright
+	if (Healthy.Num() == 0)
+	{
+		return SoonestRecovered;
+	}
+
+	if (Healthy.Num() > 1 && FMath::FRand() < this->ExploreRate)
+	{
+		return Healthy[FMath::RandRange(0, Healthy.Num() - 1)];
+	}
+
+	int32 Best = Healthy[0];
+	for (const int32 Index : Healthy)
+	{
+		if (this->Score(this->Endpoints[Index]) < this->Score(this->Endpoints[Best]))
+		{
+			Best = Index;
+		}
+	}
+	return Best;
+}
+
+int32 FProviderEndpoints::SelectForWrite()
+{
+	const double Now = FPlatformTime::Seconds();
+	if (this->Endpoints.IsValidIndex(this->PinnedWrite) && this->IsHealthy(this->Endpoints[this->PinnedWrite], Now))
+	{
+		return this->PinnedWrite;
+	}
+
+	//pin to the first healthy node in configured order so writes consistently prefer the primary
+	const int32 Start = this->Endpoints.IsValidIndex(this->PinnedWrite) ? this->PinnedWrite + 1 : 0;
+	for (int32 Offset = 0; Offset < this->Endpoints.Num(); Offset++)
+	{
+		const int32 Index = (Start + Offset) % this->Endpoints.Num();
+		if (this->IsHealthy(this->Endpoints[Index], Now))
+		{
+			this->PinnedWrite = Index;
+			return Index;
+		}
+	}
+
+	this->PinnedWrite = this->SelectForRead(TSet<int32>());
+	return this->PinnedWrite;
+}
+
+void FProviderEndpoints::ReportSuccess(const int32 Index, const double Seconds)
+{
+	if (!this->Endpoints.IsValidIndex(Index))
+	{
+		return;
+	}
+
+	FEndpoint& Endpoint = this->Endpoints[Index];
+	Endpoint.LatencySeconds = Endpoint.Samples == 0 ? Seconds : FMath::Lerp(Endpoint.LatencySeconds, Seconds, LatencyAlpha);
+	Endpoint.ErrorRate = FMath::Lerp(Endpoint.ErrorRate, 0.0, ErrorAlpha);
+	Endpoint.Samples++;
+	Endpoint.ConsecutiveFailures = 0;
+	Endpoint.CooldownUntil = 0.0;
+}
+
+void FProviderEndpoints::ReportFailure(const int32 Index)
+{
+	if (!this->Endpoints.IsValidIndex(Index))
+	{
+		return;
+	}
+
+	FEndpoint& Endpoint = this->Endpoints[Index];
+	Endpoint.ErrorRate = FMath::Lerp(Endpoint.ErrorRate, 1.0, ErrorAlpha);
+	Endpoint.ConsecutiveFailures++;
+
+	const double Cooldown = FMath::Min(FMath::Pow(2.0, static_cast<double>(Endpoint.ConsecutiveFailures - 1)), MaxCooldownSeconds);
+	Endpoint.CooldownUntil = FPlatformTime::Seconds() + Cooldown;
+}
+
+double FProviderEndpoints::GetLatency(const int32 Index) const
+{
+	return this->Endpoints.IsValidIndex(Index) ? this->Endpoints[Index].LatencySeconds : 0.0;
+}
+
+double FProviderEndpoints::GetErrorRate(const int32 Index) const
+{
+	return this->Endpoints.IsValidIndex(Index) ? this->Endpoints[Index].ErrorRate : 0.0;
+}
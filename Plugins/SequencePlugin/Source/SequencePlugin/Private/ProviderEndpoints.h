@@ -0,0 +1,72 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+#pragma once
+#include "CoreMinimal.h"
+
+/**
+ * The set of RPC nodes serving one chain along with rolling health statistics for each.
+ * Reads are routed to the fastest healthy node, writes are pinned to one node until it fails.
+ * Sets are registered by primary (first) url and shared by every UProvider using that url,
+ * so statistics survive the short lived providers made internally. Game thread only.
+ */
+class SEQUENCEPLUGIN_API FProviderEndpoints : public TSharedFromThis<FProviderEndpoints>
+{
+	struct FEndpoint
+	{
+		FString Url;
+		double LatencySeconds = 0.0;
+		double ErrorRate = 0.0;
+		int32 Samples = 0;
+		int32 ConsecutiveFailures = 0;
+		double CooldownUntil = 0.0;
+	};
+
+	TArray<FEndpoint> Endpoints;
+	int32 PinnedWrite = INDEX_NONE;
+
+	//Share of reads sent to a random healthy node so statistics of slower nodes stay current
+	float ExploreRate = 0.05f;
+
+	bool IsHealthy(const FEndpoint& Endpoint, double Now) const;
+	double Score(const FEndpoint& Endpoint) const;
+public:
+	/* Weight of the newest sample in the rolling latency & error rate */
+	static constexpr double LatencyAlpha = 0.2;
+	static constexpr double ErrorAlpha = 0.1;
+
+	static constexpr double MaxCooldownSeconds = 30.0;
+
+	explicit FProviderEndpoints(const TArray<FString>& Urls);
+
+	/*
+	* @return the set registered for PrimaryUrl, a single endpoint set is made if none was registered
+	*/
+	static TSharedRef<FProviderEndpoints> Get(const FString& PrimaryUrl);
+
+	/*
+	* Registers Urls as the endpoints of the chain served by Urls[0], statistics of urls already known are kept
+	*/
+	static TSharedRef<FProviderEndpoints> Register(const TArray<FString>& Urls);
+
+	void SetExploreRate(float Rate);
+
+	int32 Num() const;
+	FString GetUrl(int32 Index) const;
+	FString GetPrimaryUrl() const;
+
+	/*
+	* @param Excluded endpoints already tried for this call
+	* @return the endpoint to send the next read to, INDEX_NONE once every endpoint was excluded
+	*/
+	int32 SelectForRead(const TSet<int32>& Excluded) const;
+
+	/*
+	* @return the endpoint writes are pinned to, re-pinned to the next healthy endpoint after a failure
+	*/
+	int32 SelectForWrite();
+
+	void ReportSuccess(int32 Index, double Seconds);
+	void ReportFailure(int32 Index);
+
+	double GetLatency(int32 Index) const;
+	double GetErrorRate(int32 Index) const;
+};
@@ -0,0 +1,413 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+#include "ProviderSubscriptions.h"
+#include "IWebSocket.h"
+#include "WebSocketsModule.h"
+#include "RPCCaller.h"
+#include "Util/JsonBuilder.h"
+#include "Util/Log.h"
+
+namespace ProviderSubscriptions
+{
+	static TMap<FString, TSharedRef<FProviderSubscriptions>>& Registry()
+	{
+		static TMap<FString, TSharedRef<FProviderSubscriptions>> Instances;
+		return Instances;
+	}
+}
+
+FString FLogFilter::ToJson() const
+{
+	FString Json = "{";
+	if (this->Addresses.Num() > 0)
+	{
+		TArray<FString> Values;
+		for (const FAddress& Address : this->Addresses)
+		{
+			Values.Add(ConvertString("0x" + Address.ToHex()));
+		}
+		Json += "\"address\":[" + FString::Join(Values, TEXT(",")) + "]";
+	}
+
+	if (this->Topics.Num() > 0)
+	{
+		TArray<FString> Positions;
+		for (const TArray<FHash256>& Position : this->Topics)
+		{
+			if (Position.Num() == 0)
+			{
+				Positions.Add("null");
+				continue;
+			}
+
+			TArray<FString> Values;
+			for (const FHash256& Topic : Position)
+			{
+				Values.Add(ConvertString("0x" + Topic.ToHex()));
+			}
+			Positions.Add("[" + FString::Join(Values, TEXT(",")) + "]");
+		}
+		Json += (this->Addresses.Num() > 0 ? ",\"topics\":[" : "\"topics\":[") + FString::Join(Positions, TEXT(",")) + "]";
+	}
+	return Json + "}";
+}
+
+FProviderSubscriptions::FProviderSubscriptions(const FString& WebSocketUrlIn) : WebSocketUrl(WebSocketUrlIn)
+{
+}
+
+FProviderSubscriptions::~FProviderSubscriptions()
+{
+	this->Disconnect();
+}
+
+TSharedRef<FProviderSubscriptions> FProviderSubscriptions::Register(const FString& HttpUrl, const FString& WebSocketUrl)
+{
+	TMap<FString, TSharedRef<FProviderSubscriptions>>& Registry = ProviderSubscriptions::Registry();
+	if (const TSharedRef<FProviderSubscriptions>* Existing = Registry.Find(HttpUrl))
+	{
+		if ((*Existing)->WebSocketUrl.Equals(WebSocketUrl))
+		{
+			return *Existing;
+		}
+	}
+
+	const TSharedRef<FProviderSubscriptions> Subscriptions = MakeShared<FProviderSubscriptions>(WebSocketUrl);
+	Registry.Add(HttpUrl, Subscriptions);
+	return Subscriptions;
+}
+
+TSharedPtr<FProviderSubscriptions> FProviderSubscriptions::Get(const FString& HttpUrl)
+{
+	if (const TSharedRef<FProviderSubscriptions>* Existing = ProviderSubscriptions::Registry().Find(HttpUrl))
+	{
+		return *Existing;
+	}
+	return nullptr;
+}
+
+void FProviderSubscriptions::CloseAll()
+{
+	for (const TPair<FString, TSharedRef<FProviderSubscriptions>>& Entry : ProviderSubscriptions::Registry())
+	{
+		Entry.Value->Subscriptions.Empty();
+		Entry.Value->Disconnect();
+	}
+	ProviderSubscriptions::Registry().Empty();
+}
+
+FString FProviderSubscriptions::GetWebSocketUrl() const
+{
+	return this->WebSocketUrl;
+}
+
+int32 FProviderSubscriptions::Subscribe(const FString& Params, const TSuccessCallback<TSharedPtr<FJsonValue>>& OnEvent, const FFailureCallback& OnFailure)
+{
+	const int32 SubscriptionId = this->NextSubscriptionId++;
+	this->Subscriptions.Add(SubscriptionId, FSubscription{ Params, OnEvent, OnFailure, "" });
+
+	if (this->State == EState::Connected)
+	{
+		this->SendSubscribe(SubscriptionId);
+	}
+	else if (this->State == EState::Disconnected && !this->ReconnectHandle.IsValid())
+	{
+		this->Connect();
+	}
+	return SubscriptionId;
+}
+
+int32 FProviderSubscriptions::SubscribeNewHeads(const TSuccessCallback<TSharedPtr<FJsonValue>>& OnEvent, const FFailureCallback& OnFailure)
+{
+	return this->Subscribe("[\"newHeads\"]", OnEvent, OnFailure);
+}
+
+int32 FProviderSubscriptions::SubscribeLogs(const FLogFilter& Filter, const TSuccessCallback<TSharedPtr<FJsonValue>>& OnEvent, const FFailureCallback& OnFailure)
+{
+	return this->Subscribe("[\"logs\"," + Filter.ToJson() + "]", OnEvent, OnFailure);
+}
+
+int32 FProviderSubscriptions::SubscribePendingTransactions(const TSuccessCallback<TSharedPtr<FJsonValue>>& OnEvent, const FFailureCallback& OnFailure)
+{
+	return this->Subscribe("[\"newPendingTransactions\"]", OnEvent, OnFailure);
+}
+
+void FProviderSubscriptions::Unsubscribe(const int32 SubscriptionId)
+{
+	const FSubscription* Subscription = this->Subscriptions.Find(SubscriptionId);
+	if (!Subscription)
+	{
+		return;
+	}
+
+	if (!Subscription->ServerId.IsEmpty())
+	{
+		this->SendUnsubscribe(Subscription->ServerId);
+		this->ServerIds.Remove(Subscription->ServerId);
+	}
+	this->Subscriptions.Remove(SubscriptionId);
+
+	if (this->Subscriptions.Num() == 0)
+	{
+		this->Disconnect();
+	}
+}
+
+bool FProviderSubscriptions::IsLive(const int32 SubscriptionId) const
+{
+	const FSubscription* Subscription = this->Subscriptions.Find(SubscriptionId);
+	return Subscription && !Subscription->ServerId.IsEmpty();
+}
+
+bool FProviderSubscriptions::IsConnected() const
+{
+	return this->State == EState::Connected;
+}
+
+void FProviderSubscriptions::ConnectWith(const FFrameSender& Sender)
+{
+	this->Disconnect();
+	this->SendOverride = Sender;
+	this->Connect();
+}
+
+void FProviderSubscriptions::Connect()
+{
+	if (this->State != EState::Disconnected)
+	{
+		return;
+	}
+
+	if (this->SendOverride)
+	{
+		this->HandleConnected();
+		return;
+	}
+
+	this->State = EState::Connecting;
+	this->Socket = FWebSocketsModule::Get().CreateWebSocket(this->WebSocketUrl);
+	this->Socket->OnConnected().AddSP(this, &FProviderSubscriptions::HandleConnected);
+	this->Socket->OnMessage().AddSP(this, &FProviderSubscriptions::HandleMessage);
+	this->Socket->OnConnectionError().AddSP(this, &FProviderSubscriptions::HandleClosed);
+	this->Socket->OnClosed().AddSPLambda(this, [this](const int32 StatusCode, const FString& Reason, const bool bWasClean)
+	{
+		this->HandleClosed(FString::Printf(TEXT("%d %s"), StatusCode, *Reason));
+	});
+	this->Socket->Connect();
+}
+
+void FProviderSubscriptions::Disconnect()
+{
+	if (this->ReconnectHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(this->ReconnectHandle);
+		this->ReconnectHandle.Reset();
+	}
+
+	if (this->Socket.IsValid())
+	{
+		this->Socket->OnConnected().RemoveAll(this);
+		this->Socket->OnMessage().RemoveAll(this);
+		this->Socket->OnConnectionError().RemoveAll(this);
+		this->Socket->OnClosed().RemoveAll(this);
+		this->Socket->Close();
+		this->Socket.Reset();
+	}
+
+	this->State = EState::Disconnected;
+	this->ReconnectAttempts = 0;
+	this->ServerIds.Empty();
+	this->PendingRequests.Empty();
+	for (TPair<int32, FSubscription>& Subscription : this->Subscriptions)
+	{
+		Subscription.Value.ServerId.Empty();
+	}
+}
+
+void FProviderSubscriptions::ScheduleReconnect()
+{
+	if (this->ReconnectHandle.IsValid())
+	{
+		return;
+	}
+
+	const float Backoff = FMath::Min(InitialReconnectDelaySeconds * FMath::Pow(2.0f, static_cast<float>(FMath::Min(this->ReconnectAttempts, 16))), MaxReconnectDelaySeconds);
+	const float Delay = Backoff * FMath::FRandRange(0.8f, 1.2f);
+	this->ReconnectAttempts++;
+
+	SEQ_LOG(Warning, TEXT("WebSocket %s lost, reconnecting in %.1fs"), *this->WebSocketUrl, Delay);
+	this->ReconnectHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateSP(this, &FProviderSubscriptions::OnReconnectTimer), Delay);
+}
+
+bool FProviderSubscriptions::OnReconnectTimer(float DeltaTime)
+{
+	this->ReconnectHandle.Reset();
+	if (this->Subscriptions.Num() > 0)
+	{
+		this->Connect();
+	}
+	return false;
+}
+
+void FProviderSubscriptions::HandleConnected()
+{
+	if (this->ReconnectHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(this->ReconnectHandle);
+		this->ReconnectHandle.Reset();
+	}
+
+	this->State = EState::Connected;
+	this->ReconnectAttempts = 0;
+
+	TArray<int32> ToSubscribe;
+	this->Subscriptions.GetKeys(ToSubscribe);
+	for (const int32 SubscriptionId : ToSubscribe)
+	{
+		this->SendSubscribe(SubscriptionId);
+	}
+}
+
+void FProviderSubscriptions::HandleClosed(const FString& Reason)
+{
+	if (this->Socket.IsValid())
+	{
+		this->Socket->OnConnected().RemoveAll(this);
+		this->Socket->OnMessage().RemoveAll(this);
+		this->Socket->OnConnectionError().RemoveAll(this);
+		this->Socket->OnClosed().RemoveAll(this);
+		this->Socket.Reset();
+	}
+
+	SEQ_LOG(Warning, TEXT("WebSocket %s closed: %s"), *this->WebSocketUrl, *Reason);
+
+	//subscriptions are bound to the connection, every one is sent again once reconnected
+	this->State = EState::Disconnected;
+	this->ServerIds.Empty();
+	this->PendingRequests.Empty();
+	for (TPair<int32, FSubscription>& Subscription : this->Subscriptions)
+	{
+		Subscription.Value.ServerId.Empty();
+	}
+
+	if (this->Subscriptions.Num() > 0)
+	{
+		this->ScheduleReconnect();
+	}
+}
+
+void FProviderSubscriptions::HandleMessage(const FString& Message)
+{
+	const TSharedPtr<FJsonObject> Json = URPCCaller::Parse(Message);
+	if (!Json)
+	{
+		SEQ_LOG(Warning, TEXT("Unparsable WebSocket message from %s"), *this->WebSocketUrl);
+		return;
+	}
+
+	FString Method;
+	if (Json->TryGetStringField(TEXT("method"), Method))
+	{
+		const TSharedPtr<FJsonObject>* Params;
+		FString ServerId;
+		if (!Method.Equals("eth_subscription") || !Json->TryGetObjectField(TEXT("params"), Params) || !(*Params)->TryGetStringField(TEXT("subscription"), ServerId))
+		{
+			return;
+		}
+
+		const int32* SubscriptionId = this->ServerIds.Find(ServerId);
+		const FSubscription* Subscription = SubscriptionId ? this->Subscriptions.Find(*SubscriptionId) : nullptr;
+		if (Subscription)
+		{
+			//the callback may unsubscribe
+			const TSuccessCallback<TSharedPtr<FJsonValue>> OnEvent = Subscription->OnEvent;
+			OnEvent((*Params)->TryGetField(TEXT("result")));
+		}
+		return;
+	}
+
+	int32 RequestId;
+	if (!Json->TryGetNumberField(TEXT("id"), RequestId))
+	{
+		return;
+	}
+
+	TSuccessCallback<TSharedPtr<FJsonObject>> OnResponse;
+	if (this->PendingRequests.RemoveAndCopyValue(RequestId, OnResponse))
+	{
+		OnResponse(Json);
+	}
+}
+
+void FProviderSubscriptions::SendFrame(const FString& Frame)
+{
+	if (this->SendOverride)
+	{
+		this->SendOverride(Frame);
+	}
+	else if (this->Socket.IsValid() && this->Socket->IsConnected())
+	{
+		this->Socket->Send(Frame);
+	}
+}
+
+void FProviderSubscriptions::SendRequest(const FString& Method, const FString& Params, const TSuccessCallback<TSharedPtr<FJsonObject>>& OnResponse)
+{
+	const int32 RequestId = this->NextRequestId++;
+	if (OnResponse)
+	{
+		this->PendingRequests.Add(RequestId, OnResponse);
+	}
+
+	this->SendFrame(URPCCaller::RPCBuilder(Method, RequestId).ToPtr()
+		->AddField("params", Params)
+		->ToString());
+}
+
+void FProviderSubscriptions::SendSubscribe(const int32 SubscriptionId)
+{
+	const FSubscription* Subscription = this->Subscriptions.Find(SubscriptionId);
+	if (!Subscription)
+	{
+		return;
+	}
+
+	const TWeakPtr<FProviderSubscriptions> WeakThis = AsShared();
+	this->SendRequest("eth_subscribe", Subscription->Params, [WeakThis, SubscriptionId](const TSharedPtr<FJsonObject>& Json)
+	{
+		const TSharedPtr<FProviderSubscriptions> This = WeakThis.Pin();
+		if (!This)
+		{
+			return;
+		}
+
+		const TResult<FString> ServerId = URPCCaller::ExtractStringResult(Json);
+		FSubscription* Subscription = This->Subscriptions.Find(SubscriptionId);
+
+		if (ServerId.HasError())
+		{
+			//a rejected filter will be rejected again, so the subscription is dropped rather than retried
+			if (Subscription)
+			{
+				const FFailureCallback OnFailure = Subscription->OnFailure;
+				This->Unsubscribe(SubscriptionId);
+				OnFailure(ServerId.GetError());
+			}
+			return;
+		}
+
+		//unsubscribed while the subscription was in flight
+		if (!Subscription)
+		{
+			This->SendUnsubscribe(ServerId.GetValue());
+			return;
+		}
+
+		Subscription->ServerId = ServerId.GetValue();
+		This->ServerIds.Add(ServerId.GetValue(), SubscriptionId);
+	});
+}
+
+void FProviderSubscriptions::SendUnsubscribe(const FString& ServerId)
+{
+	this->SendRequest("eth_unsubscribe", "[" + ConvertString(ServerId) + "]", nullptr);
+}
@@ -0,0 +1,141 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+#pragma once
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "Dom/JsonValue.h"
+#include "Types/BinaryData.h"
+#include "Util/Async.h"
+
+class IWebSocket;
+
+/**
+ * Filter of a logs subscription, an empty filter matches every log
+ */
+struct SEQUENCEPLUGIN_API FLogFilter
+{
+	/* Contracts to watch, empty for any contract */
+	TArray<FAddress> Addresses;
+
+	/*
+	* Topics by position, a log matches when each position holds one of the listed hashes.
+	* An empty position matches any topic.
+	*/
+	TArray<TArray<FHash256>> Topics;
+
+	FString ToJson() const;
+};
+
+/**
+ * JSON-RPC over a persistent WebSocket, used for eth_subscribe.
+ * The socket is opened with the first subscription and closed with the last one. When it drops it is
+ * reopened with exponential backoff and every live subscription is subscribed again, so callers keep
+ * their subscription id across reconnects. Events missed while disconnected are not replayed.
+ * There is one instance per HTTP RPC Url, shared by every provider using that Url. Game thread only.
+ */
+class SEQUENCEPLUGIN_API FProviderSubscriptions : public TSharedFromThis<FProviderSubscriptions>
+{
+public:
+	/* Sends one text frame, used instead of a socket to drive the protocol without a node */
+	using FFrameSender = TFunction<void (const FString&)>;
+
+	static constexpr float InitialReconnectDelaySeconds = 0.5f;
+	static constexpr float MaxReconnectDelaySeconds = 30.0f;
+
+private:
+	enum class EState : uint8
+	{
+		Disconnected,
+		Connecting,
+		Connected
+	};
+
+	struct FSubscription
+	{
+		/* Raw JSON params of eth_subscribe */
+		FString Params;
+		TSuccessCallback<TSharedPtr<FJsonValue>> OnEvent;
+		FFailureCallback OnFailure;
+		/* Id given by the node for the current connection, empty until acknowledged */
+		FString ServerId;
+	};
+
+	FString WebSocketUrl;
+	TSharedPtr<IWebSocket> Socket;
+	FFrameSender SendOverride;
+	EState State = EState::Disconnected;
+
+	TMap<int32, FSubscription> Subscriptions;
+	TMap<FString, int32> ServerIds;
+	int32 NextSubscriptionId = 1;
+
+	/* Responses awaited on the current connection, keyed by request id */
+	TMap<int32, TSuccessCallback<TSharedPtr<FJsonObject>>> PendingRequests;
+	int32 NextRequestId = 1;
+
+	int32 ReconnectAttempts = 0;
+	FTSTicker::FDelegateHandle ReconnectHandle;
+
+	void Connect();
+	void Disconnect();
+	void ScheduleReconnect();
+	bool OnReconnectTimer(float DeltaTime);
+
+	void SendFrame(const FString& Frame);
+	void SendRequest(const FString& Method, const FString& Params, const TSuccessCallback<TSharedPtr<FJsonObject>>& OnResponse);
+	void SendSubscribe(const int32 SubscriptionId);
+	void SendUnsubscribe(const FString& ServerId);
+public:
+	explicit FProviderSubscriptions(const FString& WebSocketUrlIn);
+	~FProviderSubscriptions();
+
+	/*
+	* Registers WebSocketUrl as the socket serving the chain behind HttpUrl, replaces any earlier registration
+	*/
+	static TSharedRef<FProviderSubscriptions> Register(const FString& HttpUrl, const FString& WebSocketUrl);
+
+	/*
+	* @return the instance registered for HttpUrl, null if no WebSocket url was registered for it
+	*/
+	static TSharedPtr<FProviderSubscriptions> Get(const FString& HttpUrl);
+
+	/*
+	* Closes every socket and forgets every registration, called when the module shuts down
+	*/
+	static void CloseAll();
+
+	FString GetWebSocketUrl() const;
+
+	/*
+	* Subscribes with the raw JSON params of eth_subscribe, e.g. ["newHeads"]
+	* @param OnEvent fired with the result of every notification
+	* @param OnFailure fired if the node rejects the subscription, the subscription is dropped
+	* @return Id used to unsubscribe
+	*/
+	int32 Subscribe(const FString& Params, const TSuccessCallback<TSharedPtr<FJsonValue>>& OnEvent, const FFailureCallback& OnFailure);
+
+	int32 SubscribeNewHeads(const TSuccessCallback<TSharedPtr<FJsonValue>>& OnEvent, const FFailureCallback& OnFailure);
+	int32 SubscribeLogs(const FLogFilter& Filter, const TSuccessCallback<TSharedPtr<FJsonValue>>& OnEvent, const FFailureCallback& OnFailure);
+	int32 SubscribePendingTransactions(const TSuccessCallback<TSharedPtr<FJsonValue>>& OnEvent, const FFailureCallback& OnFailure);
+
+	/*
+	* Drops the subscription, the socket is closed once none remain
+	*/
+	void Unsubscribe(const int32 SubscriptionId);
+
+	/*
+	* @return true while the node is delivering events for the subscription
+	*/
+	bool IsLive(const int32 SubscriptionId) const;
+
+	bool IsConnected() const;
+
+	/*
+	* Uses Sender instead of a WebSocket and treats the connection as open right away
+	*/
+	void ConnectWith(const FFrameSender& Sender);
+
+	/* Socket events, public so the protocol can be driven without a node */
+	void HandleConnected();
+	void HandleMessage(const FString& Message);
+	void HandleClosed(const FString& Reason);
+};
@@ -1,10 +1,23 @@
 // Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
 #include "RPCCaller.h"
 #include "Util/HexUtility.h"
-#include "RequestHandler.h"
+#include "Http/HttpRequestPool.h"
 #include "Templates/SharedPointer.h"
 #include "Serialization/JsonReader.h"
 #include "Util/JsonBuilder.h"
+#include "Util/InFlightRequests.h"
+
+static TInFlightRequests<FString>& InFlightReads()
+{
+	static TInFlightRequests<FString> InFlight;
+	return InFlight;
+}
+
+static TMap<FString, URPCCaller::FRpcResponder>& Responders()
+{
+	static TMap<FString, URPCCaller::FRpcResponder> ByUrl;
+	return ByUrl;
+}
 
 TSharedPtr<FJsonObject> URPCCaller::Parse(const FString& JsonRaw)
 {
@@ -17,33 +30,91 @@ TSharedPtr<FJsonObject> URPCCaller::Parse(const FString& JsonRaw)
 	return nullptr;
 }
 
+TSharedPtr<FJsonObject> URPCCaller::Parse(const TConstArrayView<uint8> Utf8Json)
+{
+	TSharedPtr<FJsonObject> JsonParsed;
+	const FUtf8StringView View(reinterpret_cast<const UTF8CHAR*>(Utf8Json.GetData()), Utf8Json.Num());
+	const TSharedRef<TJsonReader<UTF8CHAR>> JsonReader = TJsonReaderFactory<UTF8CHAR>::CreateFromView(View);
+	if (FJsonSerializer::Deserialize(JsonReader, JsonParsed))
+	{
+		return JsonParsed;
+	}
+	return nullptr;
+}
+
 TResult<TSharedPtr<FJsonObject>> URPCCaller::ExtractJsonObjectResult(const FString& JsonRaw)
 {
-	const TSharedPtr<FJsonObject> Json = Parse(JsonRaw);
-	
+	return ExtractJsonObjectResult(Parse(JsonRaw));
+}
+
+TResult<FString> URPCCaller::ExtractStringResult(const FString& JsonRaw)
+{
+	return ExtractStringResult(Parse(JsonRaw));
+}
+
+TResult<uint64> URPCCaller::ExtractUIntResult(const FString& JsonRaw)
+{
+	return ExtractUIntResult(Parse(JsonRaw));
+}
+
+static const FString RpcErrorPrefix = "RPC Error: ";
+
+/*
+* Nodes answer failed calls with an error object instead of a result
+*/
+static TOptional<FSequenceError> GetRpcError(const TSharedPtr<FJsonObject>& Json)
+{
+	const TSharedPtr<FJsonObject>* Error;
+	if (!Json->TryGetObjectField(TEXT("error"), Error))
+	{
+		return TOptional<FSequenceError>();
+	}
+
+	FString Message;
+	(*Error)->TryGetStringField(TEXT("message"), Message);
+	return FSequenceError(RequestFail, RpcErrorPrefix + Message);
+}
+
+TResult<TSharedPtr<FJsonObject>> URPCCaller::ExtractJsonObjectResult(const TSharedPtr<FJsonObject>& Json)
+{
 	if(!Json)
 	{
 		return MakeError(FSequenceError(EmptyResponse, "Could not extract response"));
 	}
 
-	return MakeValue(Json->GetObjectField(TEXT("result")));
+	if (const TOptional<FSequenceError> Error = GetRpcError(Json))
+	{
+		return MakeError(Error.GetValue());
+	}
+
+	//a null result (e.g. a pending receipt) is a valid answer and handed back as a null object
+	const TSharedPtr<FJsonObject>* Result;
+	return MakeValue(Json->TryGetObjectField(TEXT("result"), Result) ? *Result : TSharedPtr<FJsonObject>());
 }
 
-TResult<FString> URPCCaller::ExtractStringResult(const FString& JsonRaw)
+TResult<FString> URPCCaller::ExtractStringResult(const TSharedPtr<FJsonObject>& Json)
 {
-	const TSharedPtr<FJsonObject> Json = Parse(JsonRaw);
-	
 	if(!Json)
 	{
 		return MakeError(FSequenceError(EmptyResponse, "Could not extract response"));
 	}
 
-	return MakeValue(Json->GetStringField(TEXT("result")));
+	if (const TOptional<FSequenceError> Error = GetRpcError(Json))
+	{
+		return MakeError(Error.GetValue());
+	}
+
+	FString Result;
+	if (!Json->TryGetStringField(TEXT("result"), Result))
+	{
+		return MakeError(FSequenceError(EmptyResponse, "Response has no result"));
+	}
+	return MakeValue(Result);
 }
 
-TResult<uint64> URPCCaller::ExtractUIntResult(const FString& JsonRaw)
+TResult<uint64> URPCCaller::ExtractUIntResult(const TSharedPtr<FJsonObject>& Json)
 {
-	TResult<FString> Result = ExtractStringResult(JsonRaw);
+	TResult<FString> Result = ExtractStringResult(Json);
 	if(!Result.HasValue())
 	{
 		return MakeError(Result.GetError());
@@ -57,22 +128,115 @@ TResult<uint64> URPCCaller::ExtractUIntResult(const FString& JsonRaw)
 	return MakeValue(Convert.GetValue());
 }
 
+TResult<FString> URPCCaller::ReadStringResult(const FString& JsonRaw)
+{
+	const TSharedRef<TJsonReader<TCHAR>> Reader = TJsonReaderFactory<TCHAR>::Create(JsonRaw);
+	TOptional<FString> Result;
+	bool bOnlyStringResult = true;
+	int32 Depth = 0;
+	EJsonNotation Notation;
+	while (bOnlyStringResult && Reader->ReadNext(Notation))
+	{
+		switch (Notation)
+		{
+		case EJsonNotation::ObjectStart:
+		case EJsonNotation::ArrayStart:
+			//the root object is depth 1, a nested "result" or "error" member is not the answer
+			bOnlyStringResult = !(Depth == 1 && (Reader->GetIdentifier() == TEXT("result") || Reader->GetIdentifier() == TEXT("error")));
+			Depth++;
+			break;
+		case EJsonNotation::ObjectEnd:
+		case EJsonNotation::ArrayEnd:
+			Depth--;
+			break;
+		case EJsonNotation::String:
+			if (Depth == 1 && Reader->GetIdentifier() == TEXT("result"))
+			{
+				Result = Reader->GetValueAsString();
+			}
+			break;
+		case EJsonNotation::Error:
+			bOnlyStringResult = false;
+			break;
+		default:
+			bOnlyStringResult = !(Depth == 1 && (Reader->GetIdentifier() == TEXT("result") || Reader->GetIdentifier() == TEXT("error")));
+			break;
+		}
+	}
+
+	if (bOnlyStringResult && Result.IsSet() && Reader->GetErrorMessage().IsEmpty())
+	{
+		return MakeValue(Result.GetValue());
+	}
+	return ExtractStringResult(JsonRaw);
+}
+
+bool URPCCaller::IsRpcError(const FSequenceError& Error)
+{
+	return Error.Message.StartsWith(RpcErrorPrefix, ESearchCase::CaseSensitive);
+}
+
 void URPCCaller::SendRPC(const FString& Url, const FString& Content, const TSuccessCallback<FString>& OnSuccess, const FFailureCallback& OnError)
 {
-	NewObject<URequestHandler>()
-		->PrepareRequest()
-		->WithUrl(Url)
-		->WithHeader("Content-type", "application/json")
-		->WithHeader("Accept", "application/json")
-		->WithVerb("POST")
-		->WithContentAsString(Content)
-		->ProcessAndThen(OnSuccess, OnError);
+	PostRPC(Url, Content, false, OnSuccess, OnError);
+}
+
+void URPCCaller::SetResponder(const FString& Url, const FRpcResponder& Responder)
+{
+	if (Responder)
+	{
+		Responders().Add(Url, Responder);
+	}
+	else
+	{
+		Responders().Remove(Url);
+	}
+}
+
+void URPCCaller::PostRPC(const FString& Url, const FString& Content, const bool bIdempotent, const TSuccessCallback<FString>& OnSuccess, const FFailureCallback& OnFailure)
+{
+	if (const FRpcResponder* Responder = Responders().Find(Url))
+	{
+		(*Responder)(Content, OnSuccess, OnFailure);
+		return;
+	}
+
+	const TSharedRef<FHttpRequestDescriptor> Descriptor = FHttpRequestPool::Acquire();
+	Descriptor->Url = Url;
+	Descriptor->SharedHeaders = FHttpHeaderSets::Json();
+	Descriptor->Content = Content;
+	Descriptor->bIdempotent = bIdempotent;
+	Descriptor->Priority = bIdempotent ? ERequestPriority::Interactive : ERequestPriority::Critical;
+	Descriptor->Category = ERequestCategory::Rpc;
+	FHttpExecutor::ExecuteAndThen(Descriptor, FRequestPolicies::GetPolicy(Url), OnSuccess, OnFailure);
+}
+
+void URPCCaller::SendReadRPC(const FString& Url, const FString& Content, const TSuccessCallback<FString>& OnSuccess, const FFailureCallback& OnFailure)
+{
+	const FString Key = Url + Content;
+	if (InFlightReads().Join(Key, OnSuccess, OnFailure))
+	{
+		return;
+	}
+
+	PostRPC(Url, Content, true, [Key](const FString& Response)
+	{
+		InFlightReads().Resolve(Key, Response);
+	}, [Key](const FSequenceError& Error)
+	{
+		InFlightReads().Reject(Key, Error);
+	});
 }
 
 FJsonBuilder URPCCaller::RPCBuilder(const FString& MethodName)
+{
+	return RPCBuilder(MethodName, 1);
+}
+
+FJsonBuilder URPCCaller::RPCBuilder(const FString& MethodName, const int32 Id)
 {
 	return *FJsonBuilder().ToPtr()
 		->AddString("jsonrpc", "2.0")
-		->AddInt("id", 1)
+		->AddInt("id", Id)
 		->AddString("method", MethodName);
 }
\ No newline at end of file
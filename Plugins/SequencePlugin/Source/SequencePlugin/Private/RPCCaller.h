@@ -17,17 +17,74 @@ UCLASS()
 class SEQUENCEPLUGIN_API URPCCaller : public UObject
 {
 	GENERATED_BODY()
+protected:
+	/*
+	* Posts a JSON-RPC request, idempotent requests may be retried and hedged by the request policy
+	*/
+	virtual void PostRPC(const FString& Url, const FString& Content, bool bIdempotent, const TSuccessCallback<FString>& OnSuccess, const FFailureCallback& OnFailure);
 public:
 	static TSharedPtr<FJsonObject> Parse(const FString& JsonRaw);
+
+	/*
+	* Parses a raw UTF-8 response body as is, without widening it to a TCHAR string first
+	*/
+	static TSharedPtr<FJsonObject> Parse(TConstArrayView<uint8> Utf8Json);
 	static TResult<TSharedPtr<FJsonObject>> ExtractJsonObjectResult(const FString& JsonRaw);
 	static TResult<FString> ExtractStringResult(const FString& JsonRaw);
 	static TResult<uint64> ExtractUIntResult(const FString& JsonRaw);
+	static TResult<TSharedPtr<FJsonObject>> ExtractJsonObjectResult(const TSharedPtr<FJsonObject>& Json);
+	static TResult<FString> ExtractStringResult(const TSharedPtr<FJsonObject>& Json);
+	static TResult<uint64> ExtractUIntResult(const TSharedPtr<FJsonObject>& Json);
+
+	/*
+	* Reads a string "result" with a single streaming pass over the response instead of building its DOM,
+	* anything else (an error object, a non string result, malformed json) is handed to ExtractStringResult
+	*/
+	static TResult<FString> ReadStringResult(const FString& JsonRaw);
+
+	/*
+	* @return true if Error is a JSON-RPC error object the node answered with, false for transport failures
+	*/
+	static bool IsRpcError(const FSequenceError& Error);
+
+	/* Answers the calls sent to one url in place of a node */
+	using FRpcResponder = TFunction<void (const FString& Content, const TSuccessCallback<FString>& OnSuccess, const FFailureCallback& OnFailure)>;
+
+	/*
+	* Hands every call to Url to Responder instead of the network, an unset Responder removes it.
+	* Public so providers and everything built on them can be driven without a node
+	*/
+	static void SetResponder(const FString& Url, const FRpcResponder& Responder);
 	virtual void SendRPC(const FString& Url, const FString& Content, const TSuccessCallback<FString>& OnSuccess, const FFailureCallback& OnFailure);
 
+	/**
+	 * Sends a read only RPC, identical calls (same Url and Content) that are already in flight
+	 * are not sent again, the caller is instead handed the response of the call in flight
+	 */
+	void SendReadRPC(const FString& Url, const FString& Content, const TSuccessCallback<FString>& OnSuccess, const FFailureCallback& OnFailure);
+
 	template<typename T>
 	void SendRPCAndExtract(const FString& Url, const FString& Content, const TSuccessCallback<T>& OnSuccess, const TFunction<TResult<T> (FString)>& Extractor, const FFailureCallback& OnFailure)
 	{
-		SendRPC(Url, Content, [OnSuccess, Extractor](FString Result)
+		SendRPC(Url, Content, [OnSuccess, Extractor, OnFailure](FString Result)
+		{
+			TResult<T> Value = Extractor(Result);
+
+			if(Value.HasValue())
+			{
+				OnSuccess(Value.GetValue());
+			}
+			else
+			{
+				OnFailure(Value.GetError());
+			}
+		}, OnFailure);
+	}
+	
+	template<typename T>
+	void SendReadRPCAndExtract(const FString& Url, const FString& Content, const TSuccessCallback<T>& OnSuccess, const TFunction<TResult<T> (FString)>& Extractor, const FFailureCallback& OnFailure)
+	{
+		SendReadRPC(Url, Content, [OnSuccess, Extractor, OnFailure](FString Result)
 		{
 			TResult<T> Value = Extractor(Result);
 
@@ -35,8 +92,13 @@ public:
 			{
 				OnSuccess(Value.GetValue());
 			}
+			else
+			{
+				OnFailure(Value.GetError());
+			}
 		}, OnFailure);
 	}
 	
 	static FJsonBuilder RPCBuilder(const FString& MethodName);
+	static FJsonBuilder RPCBuilder(const FString& MethodName, const int32 Id);
 };
\ No newline at end of file
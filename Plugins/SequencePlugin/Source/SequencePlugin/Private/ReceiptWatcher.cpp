@@ -0,0 +1,335 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+#include "ReceiptWatcher.h"
+#include "BlockHeadTracker.h"
+#include "Provider.h"
+#include "ProviderBatch.h"
+#include "Util/Log.h"
+
+static TMap<FString, TSharedRef<FReceiptWatcher>>& Watchers()
+{
+	static TMap<FString, TSharedRef<FReceiptWatcher>> Registry;
+	return Registry;
+}
+
+FReceiptWatcher::FReceiptWatcher(const FString& UrlIn) : Url(UrlIn)
+{
+}
+
+TSharedRef<FReceiptWatcher> FReceiptWatcher::Get(const FString& Url)
+{
+	if (const TSharedRef<FReceiptWatcher>* Watcher = Watchers().Find(Url))
+	{
+		return *Watcher;
+	}
+
+	const TSharedRef<FReceiptWatcher> Watcher = MakeShared<FReceiptWatcher>(Url);
+	Watchers().Add(Url, Watcher);
+	return Watcher;
+}
+
+int32 FReceiptWatcher::Watch(const FHash256& Hash, const int32 Confirmations, const float TimeoutSeconds, const TSuccessCallback<FTransactionReceipt>& OnSuccess, const FFailureCallback& OnFailure)
+{
+	FWatch Watch;
+	Watch.Hash = Hash;
+	Watch.Key = Hash.ToHex();
+	Watch.Confirmations = FMath::Max(Confirmations, 1);
+	Watch.Deadline = TimeoutSeconds > 0.0f ? FPlatformTime::Seconds() + TimeoutSeconds : TNumericLimits<double>::Max();
+	Watch.OnSuccess = OnSuccess;
+	Watch.OnFailure = OnFailure;
+
+	const int32 WatchId = this->NextWatchId++;
+	this->Watches.Add(WatchId, Watch);
+
+	if (this->Watches.Num() == 1)
+	{
+		this->Start();
+	}
+
+	//the transaction may already be mined, no need to wait for the next block to find out
+	this->ScheduleRound();
+	return WatchId;
+}
+
+void FReceiptWatcher::Cancel(const int32 WatchId)
+{
+	if (this->Watches.Remove(WatchId) > 0 && this->Watches.Num() == 0)
+	{
+		this->Stop();
+	}
+}
+
+int32 FReceiptWatcher::Num() const
+{
+	return this->Watches.Num();
+}
+
+TOptional<double> FReceiptWatcher::GetBlockTime() const
+{
+	return this->BlockTime;
+}
+
+TSharedRef<FBlockHeadTracker> FReceiptWatcher::GetTracker() const
+{
+	return FBlockHeadTracker::Get(this->Url);
+}
+
+void FReceiptWatcher::Start()
+{
+	const TSharedRef<FBlockHeadTracker> Tracker = this->GetTracker();
+	this->IdlePollInterval = Tracker->GetPollInterval();
+
+	const TWeakPtr<FReceiptWatcher> WeakThis = AsShared();
+	this->HeadListener = Tracker->AddListener([WeakThis](const uint64 Head)
+	{
+		if (const TSharedPtr<FReceiptWatcher> Watcher = WeakThis.Pin())
+		{
+			Watcher->OnNewHead(Head);
+		}
+	});
+
+	this->TimeoutHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateSP(this, &FReceiptWatcher::OnTimeoutTick), 0.5f);
+}
+
+void FReceiptWatcher::Stop()
+{
+	if (this->HeadListener != INDEX_NONE)
+	{
+		const TSharedRef<FBlockHeadTracker> Tracker = this->GetTracker();
+		Tracker->RemoveListener(this->HeadListener);
+		Tracker->SetPollInterval(this->IdlePollInterval);
+		this->HeadListener = INDEX_NONE;
+	}
+
+	if (this->TimeoutHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(this->TimeoutHandle);
+		this->TimeoutHandle.Reset();
+	}
+
+	if (this->RoundHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(this->RoundHandle);
+		this->RoundHandle.Reset();
+	}
+	this->bRoundQueued = false;
+}
+
+void FReceiptWatcher::OnNewHead(const uint64 Head)
+{
+	const double Now = FPlatformTime::Seconds();
+	if (this->LastHead.IsSet() && Head > this->LastHead.GetValue())
+	{
+		const double Sample = (Now - this->LastHeadSeconds) / static_cast<double>(Head - this->LastHead.GetValue());
+		this->BlockTime = this->BlockTime.IsSet() ? BlockTimeAlpha * Sample + (1.0 - BlockTimeAlpha) * this->BlockTime.GetValue() : Sample;
+
+		//polling twice per block keeps the delay between a block and its round under half a block
+		const float Interval = FMath::Clamp(static_cast<float>(this->BlockTime.GetValue() * 0.5), MinPollIntervalSeconds, MaxPollIntervalSeconds);
+		this->GetTracker()->SetPollInterval(Interval);
+	}
+	this->LastHead = Head;
+	this->LastHeadSeconds = Now;
+
+	this->ScheduleRound();
+}
+
+bool FReceiptWatcher::OnTimeoutTick(float DeltaTime)
+{
+	const double Now = FPlatformTime::Seconds();
+	TArray<int32> Expired;
+	for (const TPair<int32, FWatch>& Watch : this->Watches)
+	{
+		if (Watch.Value.Deadline <= Now)
+		{
+			Expired.Add(Watch.Key);
+		}
+	}
+
+	for (const int32 WatchId : Expired)
+	{
+		FWatch Watch;
+		if (!this->Watches.RemoveAndCopyValue(WatchId, Watch))
+		{
+			continue;
+		}
+
+		if (this->Watches.Num() == 0)
+		{
+			this->Stop();
+		}
+
+		if (Watch.bDropped)
+		{
+			Watch.OnFailure(FSequenceError(TransactionDropped, "Transaction 0x" + Watch.Key + " was dropped by a reorg and not mined again in time"));
+		}
+		else
+		{
+			Watch.OnFailure(FSequenceError(RequestTimeExceeded, "Timed out waiting for the receipt of 0x" + Watch.Key));
+		}
+	}
+
+	//Stop removed this ticker once nothing is left to watch
+	return this->TimeoutHandle.IsValid();
+}
+
+void FReceiptWatcher::ScheduleRound()
+{
+	if (this->bRoundInFlight)
+	{
+		this->bRoundQueued = true;
+		return;
+	}
+
+	//deferred to the next tick so every hash watched this frame shares the round
+	if (!this->RoundHandle.IsValid())
+	{
+		this->RoundHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateSP(this, &FReceiptWatcher::OnRoundTimer), 0.0f);
+	}
+}
+
+bool FReceiptWatcher::OnRoundTimer(float DeltaTime)
+{
+	this->RoundHandle.Reset();
+	this->RunRound();
+	return false;
+}
+
+void FReceiptWatcher::RunRound()
+{
+	//pending transactions are looked up every block, mined ones only once deep enough to be verified
+	TMap<FString, FHash256> ToFetch;
+	for (const TPair<int32, FWatch>& Watch : this->Watches)
+	{
+		if (!Watch.Value.Receipt.IsSet() || this->IsConfirmed(Watch.Value))
+		{
+			ToFetch.Add(Watch.Value.Key, Watch.Value.Hash);
+		}
+	}
+
+	if (ToFetch.Num() == 0)
+	{
+		return;
+	}
+
+	const TWeakPtr<FReceiptWatcher> WeakThis = AsShared();
+	const TSharedRef<int32> Remaining = MakeShared<int32>(ToFetch.Num());
+	const TFunction<void ()> EntryDone = [WeakThis, Remaining]()
+	{
+		const TSharedPtr<FReceiptWatcher> Watcher = WeakThis.Pin();
+		if (--(*Remaining) > 0 || !Watcher)
+		{
+			return;
+		}
+
+		Watcher->bRoundInFlight = false;
+		if (Watcher->bRoundQueued)
+		{
+			Watcher->bRoundQueued = false;
+			Watcher->ScheduleRound();
+		}
+	};
+
+	const TSharedRef<FProviderBatch> Batch = UProvider::Make(this->Url)->NewBatch();
+	for (const TPair<FString, FHash256>& Entry : ToFetch)
+	{
+		const FHash256 Hash = Entry.Value;
+		Batch->TransactionReceipt(Hash, [WeakThis, Hash, EntryDone](const FTransactionReceipt& Receipt)
+		{
+			if (const TSharedPtr<FReceiptWatcher> Watcher = WeakThis.Pin())
+			{
+				Watcher->HandleReceipt(Hash, Receipt);
+			}
+			EntryDone();
+		}, [WeakThis, Hash, EntryDone](const FSequenceError& Error)
+		{
+			//only a null receipt is reported as EmptyResponse, a missing batch entry or transport error is retried next block
+			const TSharedPtr<FReceiptWatcher> Watcher = WeakThis.Pin();
+			if (Watcher && Error.Type == EmptyResponse)
+			{
+				Watcher->HandlePending(Hash);
+			}
+			else if (Watcher)
+			{
+				SEQ_LOG(Warning, TEXT("Receipt lookup for 0x%s failed: %s"), *Hash.ToHex(), *Error.Message);
+			}
+			EntryDone();
+		});
+	}
+
+	this->bRoundInFlight = true;
+	Batch->Send();
+}
+
+void FReceiptWatcher::HandleReceipt(const FHash256& Hash, const FTransactionReceipt& Receipt)
+{
+	const FString Key = Hash.ToHex();
+	TArray<int32> Confirmed;
+	for (TPair<int32, FWatch>& Watch : this->Watches)
+	{
+		if (!Watch.Value.Key.Equals(Key))
+		{
+			continue;
+		}
+
+		//mined again in another block, confirmations count from that block now
+		if (Watch.Value.Receipt.IsSet() && !Watch.Value.Receipt->BlockHash.ToHex().Equals(Receipt.BlockHash.ToHex()))
+		{
+			SEQ_LOG(Warning, TEXT("Transaction 0x%s moved from block %llu to %llu after a reorg"), *Key, Watch.Value.Receipt->BlockNumber, Receipt.BlockNumber);
+			Watch.Value.Receipt = Receipt;
+			continue;
+		}
+
+		Watch.Value.Receipt = Receipt;
+		if (this->IsConfirmed(Watch.Value))
+		{
+			Confirmed.Add(Watch.Key);
+		}
+	}
+
+	for (const int32 WatchId : Confirmed)
+	{
+		this->Complete(WatchId);
+	}
+}
+
+void FReceiptWatcher::HandlePending(const FHash256& Hash)
+{
+	const FString Key = Hash.ToHex();
+	for (TPair<int32, FWatch>& Watch : this->Watches)
+	{
+		if (Watch.Value.Key.Equals(Key) && Watch.Value.Receipt.IsSet())
+		{
+			SEQ_LOG(Warning, TEXT("Transaction 0x%s was mined in block %llu and dropped by a reorg"), *Key, Watch.Value.Receipt->BlockNumber);
+			Watch.Value.Receipt.Reset();
+			Watch.Value.bDropped = true;
+		}
+	}
+}
+
+bool FReceiptWatcher::IsConfirmed(const FWatch& Watch) const
+{
+	if (!Watch.Receipt.IsSet())
+	{
+		return false;
+	}
+
+	//the head may lag behind the node that served the receipt, the receipt block is at least 1 deep
+	const TOptional<uint64> Head = this->GetTracker()->GetHead();
+	const uint64 Mined = Watch.Receipt->BlockNumber;
+	const uint64 Depth = Head.IsSet() && Head.GetValue() >= Mined ? Head.GetValue() - Mined + 1 : 1;
+	return Depth >= static_cast<uint64>(Watch.Confirmations);
+}
+
+void FReceiptWatcher::Complete(const int32 WatchId)
+{
+	FWatch Watch;
+	if (!this->Watches.RemoveAndCopyValue(WatchId, Watch))
+	{
+		return;
+	}
+
+	if (this->Watches.Num() == 0)
+	{
+		this->Stop();
+	}
+	Watch.OnSuccess(Watch.Receipt.GetValue());
+}
@@ -0,0 +1,101 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+#pragma once
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "Types/BinaryData.h"
+#include "Types/TransactionReceipt.h"
+#include "Util/Async.h"
+
+class FBlockHeadTracker;
+
+/**
+ * Waits for transactions of one chain (one RPC Url) to be mined and confirmed.
+ * Every pending hash is checked in a single batched request per new block, driven by the shared
+ * FBlockHeadTracker, whose poll interval follows the observed block time while anything is being watched.
+ * A receipt is fetched again once it reaches its confirmation depth, a receipt that vanished or moved
+ * to another block in the meantime was reorged out and goes back to waiting.
+ * Game thread only.
+ */
+class SEQUENCEPLUGIN_API FReceiptWatcher : public TSharedFromThis<FReceiptWatcher>
+{
+	struct FWatch
+	{
+		FHash256 Hash;
+		/* Hex of Hash, watches of the same transaction share one lookup per round */
+		FString Key;
+		int32 Confirmations = 1;
+		double Deadline = 0.0;
+		TSuccessCallback<FTransactionReceipt> OnSuccess;
+		FFailureCallback OnFailure;
+		TOptional<FTransactionReceipt> Receipt;
+		/* Set once a receipt seen earlier was lost to a reorg */
+		bool bDropped = false;
+	};
+
+	FString Url;
+	TMap<int32, FWatch> Watches;
+	int32 NextWatchId = 1;
+
+	int32 HeadListener = INDEX_NONE;
+	FTSTicker::FDelegateHandle TimeoutHandle;
+	FTSTicker::FDelegateHandle RoundHandle;
+	bool bRoundInFlight = false;
+	bool bRoundQueued = false;
+
+	/* Smoothed seconds per block, unset until two heads were seen */
+	TOptional<double> BlockTime;
+	TOptional<uint64> LastHead;
+	double LastHeadSeconds = 0.0;
+	float IdlePollInterval = 0.0f;
+
+	TSharedRef<FBlockHeadTracker> GetTracker() const;
+	void Start();
+	void Stop();
+	void OnNewHead(const uint64 Head);
+	bool OnTimeoutTick(float DeltaTime);
+
+	void ScheduleRound();
+	bool OnRoundTimer(float DeltaTime);
+	void RunRound();
+	bool IsConfirmed(const FWatch& Watch) const;
+	void Complete(const int32 WatchId);
+public:
+	/* Weight of the newest sample in the smoothed block time */
+	static constexpr double BlockTimeAlpha = 0.3;
+
+	/* Heads are polled twice per block, within these bounds */
+	static constexpr float MinPollIntervalSeconds = 0.25f;
+	static constexpr float MaxPollIntervalSeconds = 5.0f;
+
+	explicit FReceiptWatcher(const FString& UrlIn);
+
+	/**
+	 * Gets the shared watcher for the given RPC Url, creating it on first use
+	 */
+	static TSharedRef<FReceiptWatcher> Get(const FString& Url);
+
+	/**
+	 * Waits until Hash is mined and its block is Confirmations deep (1 = mined in the head block)
+	 * @param OnSuccess fired with the receipt, reverted transactions included (check Status)
+	 * @param OnFailure RequestTimeExceeded once TimeoutSeconds pass, TransactionDropped instead if the
+	 * transaction was mined but reorged out and not mined again in time
+	 * @return Id used to cancel the wait
+	 */
+	int32 Watch(const FHash256& Hash, const int32 Confirmations, const float TimeoutSeconds, const TSuccessCallback<FTransactionReceipt>& OnSuccess, const FFailureCallback& OnFailure);
+
+	/**
+	 * Stops waiting without firing any callback
+	 */
+	void Cancel(const int32 WatchId);
+
+	int32 Num() const;
+
+	/**
+	 * @return the smoothed block time, unset until two blocks were observed
+	 */
+	TOptional<double> GetBlockTime() const;
+
+	/* Results of a round, public so the confirmation logic can be driven without a node */
+	void HandleReceipt(const FHash256& Hash, const FTransactionReceipt& Receipt);
+	void HandlePending(const FHash256& Hash);
+};
@@ -11,32 +11,45 @@
 #include "Util/HexUtility.h"
 #include "Util/Log.h"
 #include "TextureResource.h"
+#include "Http/HttpRequestPool.h"
+#include "Http/HttpCompression.h"
 
 URequestHandler* URequestHandler::PrepareRequest()
 {
-	Request = FHttpModule::Get().CreateRequest();
-	Request->SetTimeout(30);
+	Descriptor = FHttpRequestPool::Acquire();
+	Policy.Reset();
+	OnComplete.Reset();
 	return this;
 }
 
-void URequestHandler::SetUrl(const FString Url) const
+void URequestHandler::SetUrl(const FString Url)
 {
-	Request->SetURL(Url);
+	Descriptor->Url = Url;
 }
 
-void URequestHandler::SetVerb(FString Verb) const
+void URequestHandler::SetVerb(FString Verb)
 {
-	Request->SetVerb(Verb);
+	Descriptor->Verb = Verb;
 }
 
-void URequestHandler::AddHeader(const FString Name, const FString Value) const
+void URequestHandler::SetHeaders(const TSharedRef<const FHttpHeaders>& Headers)
 {
-	Request->AppendToHeader(Name, Value);
+	Descriptor->SharedHeaders = Headers;
 }
 
-void URequestHandler::SetContentAsString(const FString Content) const
+void URequestHandler::AddHeader(const FString Name, const FString Value)
 {
-	Request->SetContentAsString(Content);
+	Descriptor->Headers.Add(TPair<FString, FString>(Name, Value));
+}
+
+void URequestHandler::SetContentAsString(const FString Content)
+{
+	Descriptor->Content = Content;
+}
+
+void URequestHandler::SetIdempotent(const bool bIdempotent)
+{
+	Descriptor->bIdempotent = bIdempotent;
 }
 
 URequestHandler* URequestHandler::WithUrl(const FString Url)
@@ -57,35 +70,66 @@ URequestHandler* URequestHandler::WithHeader(const FString Name, const FString V
 	return this;
 }
 
+URequestHandler* URequestHandler::WithHeaders(const TSharedRef<const FHttpHeaders>& Headers)
+{
+	SetHeaders(Headers);
+	return this;
+}
+
 URequestHandler* URequestHandler::WithContentAsString(const FString Content)
 {
 	SetContentAsString(Content);
 	return this;
 }
 
-FHttpRequestCompleteDelegate& URequestHandler::Process() const
+URequestHandler* URequestHandler::WithIdempotent(const bool bIdempotent)
 {
-	Request->ProcessRequest();
-	return Request->OnProcessRequestComplete();
+	SetIdempotent(bIdempotent);
+	return this;
 }
 
-void URequestHandler::ProcessAndThen(TFunction<void(UTexture2D*)> OnSuccess, FFailureCallback OnFailure)
+URequestHandler* URequestHandler::WithPriority(const ERequestPriority Priority)
+{
+	Descriptor->Priority = Priority;
+	return this;
+}
+
+URequestHandler* URequestHandler::WithCategory(const ERequestCategory Category)
+{
+	Descriptor->Category = Category;
+	return this;
+}
+
+URequestHandler* URequestHandler::WithPolicy(const FRequestPolicy& PolicyIn)
+{
+	Policy = PolicyIn;
+	return this;
+}
+
+FRequestPolicy URequestHandler::GetPolicy() const
+{
+	return Policy.IsSet() ? Policy.GetValue() : FRequestPolicies::GetPolicy(Descriptor->Url);
+}
+
+FHttpRequestCompleteDelegate& URequestHandler::Process()
 {
-	Process().BindLambda([OnSuccess, OnFailure](FHttpRequestPtr Req, FHttpResponsePtr Response, bool bWasSuccessful)
+	const TSharedRef<FHttpRequestCompleteDelegate> Delegate = MakeShared<FHttpRequestCompleteDelegate>();
+	OnComplete = Delegate;
+	FHttpExecutor::Execute(Descriptor.ToSharedRef(), GetPolicy(), [Delegate](FHttpRequestPtr Req, FHttpResponsePtr Response, bool bWasSuccessful)
 	{
-		auto content = Req->GetContent();
-		FString str = "";
-		for (auto i : content)
-		{
-			str += UTF8ToString(FUnsizedData{ MakeArray(&i, 1) });
-		}
-		auto headers = Req->GetAllHeaders();
-		FString headers_str = "";
-		for (auto header : headers) { headers_str += "\n" + header; }
+		Delegate->ExecuteIfBound(Req, Response, bWasSuccessful);
+	});
+	return *Delegate;
+}
 
+void URequestHandler::ProcessAndThen(TFunction<void(UTexture2D*)> OnSuccess, FFailureCallback OnFailure)
+{
+	FHttpExecutor::Execute(Descriptor.ToSharedRef(), GetPolicy(), [OnSuccess, OnFailure](FHttpRequestPtr Req, FHttpResponsePtr Response, bool bWasSuccessful)
+	{
 		if (bWasSuccessful)
 		{
-			TArray<uint8> img_data = Response->GetContent();
+			TArray<uint8> decoded_data;
+			const TArray<uint8>& img_data = FHttpCompression::GetContent(Response, decoded_data);
 			//now we must process the image
 			int32 width = 0, height = 0;
 			UTexture2D* img = nullptr;
@@ -123,7 +167,7 @@ void URequestHandler::ProcessAndThen(TFunction<void(UTexture2D*)> OnSuccess, FFa
 				OnFailure(FSequenceError(RequestFail, "The Request is invalid!"));
 			} else
 			{
-				OnFailure(FSequenceError(RequestFail, "Request failed: " + Response->GetContentAsString()));
+				OnFailure(FSequenceError(RequestFail, "Request failed: " + FHttpCompression::GetContentAsString(Response)));
 			}
 		}//if wasn't successful
 		//catch all error case!
@@ -133,52 +177,11 @@ void URequestHandler::ProcessAndThen(TFunction<void(UTexture2D*)> OnSuccess, FFa
 
 void URequestHandler::ProcessAndThen(TFunction<void (FString)> OnSuccess, FFailureCallback OnFailure) const
 {
-	Process().BindLambda([OnSuccess, OnFailure](FHttpRequestPtr Req, const FHttpResponsePtr& Response, const bool bWasSuccessful)
-	{
-		FString CurlCommand = FString::Printf(
-			TEXT("curl -X %s \"%s\" -H \"Content-Type: application/json\" -H \"Accept: application/json\" -H \"X-Access-Key: %s\" --data \"%s\""),
-			*Req->GetVerb(),                
-			*Req->GetURL(),                 
-			*Req->GetHeader("X-Access-Key"),
-			*FString::Printf(TEXT("%s"),*FString(UTF8_TO_TCHAR(Req->GetContent().GetData())).Replace(TEXT("\""), TEXT("\\\"")))
-		);
-
-		SEQ_LOG_EDITOR(Log,TEXT("%s"), *CurlCommand);
-		SEQ_LOG_EDITOR(Log,TEXT("%s"), *Response->GetContentAsString());
-
-		if (bWasSuccessful)
-		{
-			OnSuccess(Response->GetContentAsString());
-		}
-		else
-		{
-			if(Response.IsValid())
-			{
-				OnFailure(FSequenceError(RequestFail, "Request is invalid" + Response->GetContentAsString()));
-			}
-			else
-			{
-				OnFailure(FSequenceError(RequestFail, "Request failed: No response received!"));
-			}
-		}
-	});
+	FHttpExecutor::ExecuteAndThen(Descriptor.ToSharedRef(), GetPolicy(), OnSuccess, OnFailure);
 }
 
 void URequestHandler::ProcessAndThen(TSuccessCallback<FHttpResponsePtr> OnSuccess,
                                      const FFailureCallback& OnFailure) const
 {
-	Process().BindLambda([OnSuccess, OnFailure](FHttpRequestPtr Req, const FHttpResponsePtr& Response, const bool bWasSuccessful)
-	{		
-		if(bWasSuccessful)
-		{
-			OnSuccess(Response);
-		}
-		else
-		{
-			if(!Response.IsValid())
-				OnFailure(FSequenceError(RequestFail, "The Request is invalid!"));
-			else
-				OnFailure(FSequenceError(RequestFail, "Request failed: " + Response->GetContentAsString()));
-		}
-	});
+	FHttpExecutor::ExecuteAndThen(Descriptor.ToSharedRef(), GetPolicy(), OnSuccess, OnFailure);
 }
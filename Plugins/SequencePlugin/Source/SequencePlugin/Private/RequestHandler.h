@@ -5,36 +5,68 @@
 #include "CoreMinimal.h"
 #include "Util/Async.h"
 #include "Interfaces/IHttpRequest.h"
+#include "Http/HttpExecutor.h"
 #include "Engine/Texture2D.h"
 #include "UObject/Object.h"
 #include "RequestHandler.generated.h"
 
 /**
- * 
+ * Builder style wrapper over FHttpExecutor, internal callers use FHttpRequestPool & FHttpExecutor directly
+ * so no UObject is created per request
  */
 UCLASS()
 class SEQUENCEPLUGIN_API URequestHandler : public UObject
 {
 	GENERATED_BODY()
-	FHttpRequestPtr Request;
+	TSharedPtr<FHttpRequestDescriptor> Descriptor;
+	TOptional<FRequestPolicy> Policy;
+
+	/* Shared with the executor callback so a binding made after Process outlives this object */
+	TSharedPtr<FHttpRequestCompleteDelegate> OnComplete;
+
+	FRequestPolicy GetPolicy() const;
 	
 public:
 	URequestHandler* PrepareRequest();
 	
 	// Setters
-	void SetUrl(FString Url) const;
-	void SetVerb(FString Verb) const;
-	void AddHeader(FString Name, FString Value) const;
-	void SetContentAsString(FString Content) const;
+	void SetUrl(FString Url);
+	void SetVerb(FString Verb);
+	void SetHeaders(const TSharedRef<const FHttpHeaders>& Headers);
+	void AddHeader(FString Name, FString Value);
+	void SetContentAsString(FString Content);
+	void SetIdempotent(bool bIdempotent);
 
 	// Builder Pattern
 	URequestHandler* WithUrl(FString Url);
 	URequestHandler* WithVerb(FString Verb);
 	URequestHandler* WithHeader(FString Name, FString Value);
+	URequestHandler* WithHeaders(const TSharedRef<const FHttpHeaders>& Headers);
 	URequestHandler* WithContentAsString(FString Content);
 
-	// Process
-	FHttpRequestCompleteDelegate& Process() const;
+	/*
+	* Marks the request as safe to resend (a read), allowing retries after a server error and hedging
+	*/
+	URequestHandler* WithIdempotent(bool bIdempotent);
+
+	/*
+	* Sets the scheduler lane, requests default to ERequestPriority::Interactive
+	*/
+	URequestHandler* WithPriority(ERequestPriority Priority);
+
+	/*
+	* Sets the category the request is traced under, requests default to ERequestCategory::Other
+	*/
+	URequestHandler* WithCategory(ERequestCategory Category);
+
+	/*
+	* Overrides the FRequestPolicy registered for the url
+	*/
+	URequestHandler* WithPolicy(const FRequestPolicy& PolicyIn);
+
+	// Process, every variant runs through FHttpExecutor under the FRequestPolicy registered for the url,
+	// the delegate returned by Process fires once with the final attempt and can be bound after the call
+	FHttpRequestCompleteDelegate& Process();
 	void ProcessAndThen(TFunction<void(UTexture2D*)> OnSuccess, FFailureCallback OnFailure);
 	void ProcessAndThen(TFunction<void (FString)> OnSuccess, FFailureCallback OnFailure) const;
 	void ProcessAndThen(TSuccessCallback<FHttpResponsePtr> OnSuccess, const FFailureCallback& OnFailure) const;
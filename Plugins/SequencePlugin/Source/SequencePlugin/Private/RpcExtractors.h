@@ -0,0 +1,181 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+#pragma once
+#include "CoreMinimal.h"
+#include "Errors.h"
+#include "RPCCaller.h"
+#include "Types/BinaryData.h"
+#include "Types/Header.h"
+#include "Types/TransactionReceipt.h"
+#include "Util/HexUtility.h"
+#include "Dom/JsonObject.h"
+
+/**
+ * Typed extractors for the "result" of a JSON-RPC response.
+ * Every specialization offers FromJson for an already parsed response (batches) and
+ * FromResponse for the raw body, both are plain static functions so they can be handed
+ * to SendRPCAndExtract without capturing anything or touching a UObject.
+ * Scalar results are read from the raw body in one streaming pass, object results still parse the DOM.
+ */
+template<typename T>
+struct TRpcExtractor;
+
+/*
+* Hex quantity such as a block number, nonce or chain id
+*/
+template<>
+struct TRpcExtractor<uint64>
+{
+	static TResult<uint64> FromJson(const TSharedPtr<FJsonObject>& Json)
+	{
+		return FromString(URPCCaller::ExtractStringResult(Json));
+	}
+
+	static TResult<uint64> FromResponse(const FString& Response)
+	{
+		return FromString(URPCCaller::ReadStringResult(Response));
+	}
+
+	static TResult<uint64> FromString(const TResult<FString>& String)
+	{
+		if (String.HasError())
+		{
+			return MakeError(String.GetError());
+		}
+
+		const TOptional<uint64> Convert = HexStringToUint64(String.GetValue());
+		if (!Convert.IsSet())
+		{
+			return MakeError(FSequenceError(ResponseParseError, "Couldn't convert \"" + String.GetValue() + "\" to a number."));
+		}
+		return MakeValue(Convert.GetValue());
+	}
+};
+
+/*
+* Hex encoded byte string such as call data, gas values or a transaction hash
+*/
+template<>
+struct TRpcExtractor<FUnsizedData>
+{
+	static TResult<FUnsizedData> FromJson(const TSharedPtr<FJsonObject>& Json)
+	{
+		return FromString(URPCCaller::ExtractStringResult(Json));
+	}
+
+	static TResult<FUnsizedData> FromResponse(const FString& Response)
+	{
+		return FromString(URPCCaller::ReadStringResult(Response));
+	}
+
+	static TResult<FUnsizedData> FromString(const TResult<FString>& String)
+	{
+		if (String.HasError())
+		{
+			return MakeError(String.GetError());
+		}
+		return MakeValue(HexStringToBinary(String.GetValue()));
+	}
+};
+
+/*
+* 32 byte hash
+*/
+template<>
+struct TRpcExtractor<FHash256>
+{
+	static TResult<FHash256> FromJson(const TSharedPtr<FJsonObject>& Json)
+	{
+		return FromString(URPCCaller::ExtractStringResult(Json));
+	}
+
+	static TResult<FHash256> FromResponse(const FString& Response)
+	{
+		return FromString(URPCCaller::ReadStringResult(Response));
+	}
+
+	static TResult<FHash256> FromString(const TResult<FString>& String)
+	{
+		if (String.HasError())
+		{
+			return MakeError(String.GetError());
+		}
+
+		FString Hex = String.GetValue();
+		Hex.RemoveFromStart("0x");
+		if (Hex.Len() != FHash256::Size * 2)
+		{
+			return MakeError(FSequenceError(ResponseParseError, "Couldn't convert \"" + String.GetValue() + "\" to a hash."));
+		}
+		return MakeValue(FHash256::From(Hex));
+	}
+};
+
+/*
+* Object result such as a block or transaction, a null result is reported as EmptyResponse
+*/
+template<>
+struct TRpcExtractor<TSharedPtr<FJsonObject>>
+{
+	static TResult<TSharedPtr<FJsonObject>> FromJson(const TSharedPtr<FJsonObject>& Json)
+	{
+		TResult<TSharedPtr<FJsonObject>> Obj = URPCCaller::ExtractJsonObjectResult(Json);
+		if (Obj.HasValue() && Obj.GetValue() == nullptr)
+		{
+			return MakeError(FSequenceError(EmptyResponse, "Json response is null"));
+		}
+		return Obj;
+	}
+
+	static TResult<TSharedPtr<FJsonObject>> FromResponse(const FString& Response)
+	{
+		return FromJson(URPCCaller::Parse(Response));
+	}
+};
+
+/*
+* Transaction receipt, a null result means the transaction is still pending
+*/
+template<>
+struct TRpcExtractor<FTransactionReceipt>
+{
+	static TResult<FTransactionReceipt> FromJson(const TSharedPtr<FJsonObject>& Json)
+	{
+		TResult<TSharedPtr<FJsonObject>> Obj = URPCCaller::ExtractJsonObjectResult(Json);
+		if (Obj.HasError())
+		{
+			return MakeError(Obj.GetError());
+		}
+		if (Obj.GetValue() == nullptr)
+		{
+			return MakeError(FSequenceError(EmptyResponse, "Transaction receipt is not available yet"));
+		}
+		return MakeValue(JsonToTransactionReceipt(Obj.GetValue()));
+	}
+
+	static TResult<FTransactionReceipt> FromResponse(const FString& Response)
+	{
+		return FromJson(URPCCaller::Parse(Response));
+	}
+};
+
+/*
+* Block header
+*/
+template<>
+struct TRpcExtractor<FHeader>
+{
+	static TResult<FHeader> FromJson(const TSharedPtr<FJsonObject>& Json)
+	{
+		TResult<TSharedPtr<FJsonObject>> Obj = TRpcExtractor<TSharedPtr<FJsonObject>>::FromJson(Json);
+		if (Obj.HasError())
+		{
+			return MakeError(Obj.GetError());
+		}
+		return MakeValue(JsonToHeader(Obj.GetValue()));
+	}
+
+	static TResult<FHeader> FromResponse(const FString& Response)
+	{
+		return FromJson(URPCCaller::Parse(Response));
+	}
+};
@@ -12,6 +12,7 @@
 #include "Provider.h"
 #include "Transak.h"
 #include "SequenceRPCManager.h"
+#include "TransactionHistoryStore.h"
 
 USequenceWallet::USequenceWallet()
 {
@@ -322,7 +323,12 @@ void USequenceWallet::SendTransactionWithFeeOption(const TArray<TransactionUnion
 {
 	if (this->SequenceRPCManager)
 	{
-		this->SequenceRPCManager->SendTransactionWithFeeOption(this->Credentials,Transactions,FeeOption,OnSuccess,OnFailure);
+		const int64 Network = this->Credentials.GetNetwork();
+		this->SequenceRPCManager->SendTransactionWithFeeOption(this->Credentials,Transactions,FeeOption,[Network, OnSuccess](const FSeqTransactionResponse_Data& Response)
+		{
+			UIndexer::InvalidateBalances(Network);
+			OnSuccess(Response);
+		},OnFailure);
 	}
 }
 
@@ -453,7 +459,12 @@ void USequenceWallet::SendTransaction(const TArray<TransactionUnion>& Transactio
 {
 	if (this->SequenceRPCManager)
 	{
-		this->SequenceRPCManager->SendTransaction(this->Credentials, Transactions, OnSuccess, OnFailure);
+		const int64 Network = this->Credentials.GetNetwork();
+		this->SequenceRPCManager->SendTransaction(this->Credentials, Transactions, [Network, OnSuccess](const FSeqTransactionResponse_Data& Response)
+		{
+			UIndexer::InvalidateBalances(Network);
+			OnSuccess(Response);
+		}, OnFailure);
 	}
 }
 
@@ -513,6 +524,34 @@ void USequenceWallet::GetTransactionHistory(const FSeqGetTransactionHistoryArgs&
 		this->Indexer->GetTransactionHistory(this->Credentials.GetNetwork(), Args, OnSuccess, OnFailure);
 }
 
+void USequenceWallet::ForEachTokenBalancesPage(const FSeqGetTokenBalancesArgs& Args, const TFunction<bool (const FSeqGetTokenBalancesReturn&)>& OnPage, const TFunction<void ()>& OnDone, const FFailureCallback& OnFailure) const
+{
+	if (this->Indexer)
+		this->Indexer->IterateTokenBalances(this->Credentials.GetNetwork(), Args)->ForEachPage(OnPage, OnDone, OnFailure);
+}
+
+void USequenceWallet::ForEachTransactionHistoryPage(const FSeqGetTransactionHistoryArgs& Args, const TFunction<bool (const FSeqGetTransactionHistoryReturn&)>& OnPage, const TFunction<void ()>& OnDone, const FFailureCallback& OnFailure) const
+{
+	if (this->Indexer)
+		this->Indexer->IterateTransactionHistory(this->Credentials.GetNetwork(), Args)->ForEachPage(OnPage, OnDone, OnFailure);
+}
+
+TArray<FSeqTransaction> USequenceWallet::GetStoredTransactionHistory() const
+{
+	return FTransactionHistoryStore::Get(this->Credentials.GetNetwork(), this->GetWalletAddress())->GetTransactions();
+}
+
+void USequenceWallet::SyncTransactionHistory(const TSuccessCallback<TArray<FSeqTransaction>>& OnSuccess, const FFailureCallback& OnFailure) const
+{
+	FTransactionHistoryStore::Get(this->Credentials.GetNetwork(), this->GetWalletAddress())->Sync(this->Indexer, OnSuccess, OnFailure);
+}
+
+void USequenceWallet::GetPortfolio(const TArray<int64>& ChainIds, const int32 MaxConcurrentChains, const TFunction<void (const FSeqChainPortfolio&, const FSeqPortfolio&)>& OnChain, const TSuccessCallback<FSeqPortfolio>& OnSuccess) const
+{
+	if (this->Indexer)
+		this->Indexer->GetPortfolio(this->GetWalletAddress(), ChainIds, MaxConcurrentChains, true, OnChain, OnSuccess);
+}
+
 void USequenceWallet::BlockByNumber(uint64 Number, const TSuccessCallback<TSharedPtr<FJsonObject>>& OnSuccess, const FFailureCallback& OnFailure) const
 {
 	if (this->Provider)
@@ -601,6 +640,14 @@ void USequenceWallet::TransactionReceipt(const FHash256& Hash, const TSuccessCal
 	}
 }
 
+void USequenceWallet::WaitForReceipt(const FHash256& Hash, const int32 Confirmations, const float TimeoutSeconds, const TSuccessCallback<FTransactionReceipt>& OnSuccess, const FFailureCallback& OnFailure) const
+{
+	if (this->Provider)
+	{
+		this->Provider->WaitForReceipt(Hash,Confirmations,TimeoutSeconds,OnSuccess,OnFailure);
+	}
+}
+
 void USequenceWallet::GetGasPrice(const TSuccessCallback<FUnsizedData>& OnSuccess, const FFailureCallback& OnFailure) const
 {
 	if (this->Provider)
@@ -671,4 +718,149 @@ void USequenceWallet::NonViewCall(const FEthTransaction& Transaction, const FPri
 	{
 		this->Provider->NonViewCall(Transaction, PrivateKey, ChainID, OnSuccess, OnFailure);
 	}
-}
\ No newline at end of file
+}
+template <typename T>
+static TSeqFuture<T> WalletFuture(const bool bInitialized, const TFunction<void (const TSuccessCallback<T>&, const FFailureCallback&)>& Call)
+{
+	if (!bInitialized)
+	{
+		return SeqFuture::MakeError<T>(FSequenceError(RequestFail, "SequenceWallet is not initialized"));
+	}
+	return SeqFuture::FromCallback<T>(Call);
+}
+
+TSeqFuture<FSeqSignMessageResponse_Response> USequenceWallet::SignMessage(const FString& Message) const
+{
+	return WalletFuture<FSeqSignMessageResponse_Response>(this->SequenceRPCManager != nullptr, [this, Message](const TSuccessCallback<FSeqSignMessageResponse_Response>& OnSuccess, const FFailureCallback& OnFailure)
+	{
+		this->SignMessage(Message, OnSuccess, OnFailure);
+	});
+}
+
+TSeqFuture<FSeqTransactionResponse_Data> USequenceWallet::SendTransaction(const TArray<TransactionUnion>& Transactions) const
+{
+	return WalletFuture<FSeqTransactionResponse_Data>(this->SequenceRPCManager != nullptr, [this, Transactions](const TSuccessCallback<FSeqTransactionResponse_Data>& OnSuccess, const FFailureCallback& OnFailure)
+	{
+		this->SendTransaction(Transactions, OnSuccess, OnFailure);
+	});
+}
+
+TSeqFuture<FSeqTransactionResponse_Data> USequenceWallet::SendTransactionWithFeeOption(const TArray<TransactionUnion>& Transactions, const FFeeOption& FeeOption) const
+{
+	return WalletFuture<FSeqTransactionResponse_Data>(this->SequenceRPCManager != nullptr, [this, Transactions, FeeOption](const TSuccessCallback<FSeqTransactionResponse_Data>& OnSuccess, const FFailureCallback& OnFailure)
+	{
+		this->SendTransactionWithFeeOption(Transactions, FeeOption, OnSuccess, OnFailure);
+	});
+}
+
+TSeqFuture<TArray<FFeeOption>> USequenceWallet::GetFeeOptions(const TArray<TransactionUnion>& Transactions) const
+{
+	return WalletFuture<TArray<FFeeOption>>(this->SequenceRPCManager != nullptr, [this, Transactions](const TSuccessCallback<TArray<FFeeOption>>& OnSuccess, const FFailureCallback& OnFailure)
+	{
+		this->GetFeeOptions(Transactions, OnSuccess, OnFailure);
+	});
+}
+
+TSeqFuture<TArray<FFeeOption>> USequenceWallet::GetUnfilteredFeeOptions(const TArray<TransactionUnion>& Transactions) const
+{
+	return WalletFuture<TArray<FFeeOption>>(this->SequenceRPCManager != nullptr, [this, Transactions](const TSuccessCallback<TArray<FFeeOption>>& OnSuccess, const FFailureCallback& OnFailure)
+	{
+		this->GetUnfilteredFeeOptions(Transactions, OnSuccess, OnFailure);
+	});
+}
+
+TSeqFuture<FSeqEtherBalance> USequenceWallet::GetEtherBalance(const FString& AccountAddr) const
+{
+	return WalletFuture<FSeqEtherBalance>(this->Indexer != nullptr, [this, AccountAddr](const TSuccessCallback<FSeqEtherBalance>& OnSuccess, const FFailureCallback& OnFailure)
+	{
+		this->GetEtherBalance(AccountAddr, OnSuccess, OnFailure);
+	});
+}
+
+TSeqFuture<FSeqGetTokenBalancesReturn> USequenceWallet::GetTokenBalances(const FSeqGetTokenBalancesArgs& Args) const
+{
+	return WalletFuture<FSeqGetTokenBalancesReturn>(this->Indexer != nullptr, [this, Args](const TSuccessCallback<FSeqGetTokenBalancesReturn>& OnSuccess, const FFailureCallback& OnFailure)
+	{
+		this->GetTokenBalances(Args, OnSuccess, OnFailure);
+	});
+}
+
+TSeqFuture<FSeqGetTokenSuppliesReturn> USequenceWallet::GetTokenSupplies(const FSeqGetTokenSuppliesArgs& Args) const
+{
+	return WalletFuture<FSeqGetTokenSuppliesReturn>(this->Indexer != nullptr, [this, Args](const TSuccessCallback<FSeqGetTokenSuppliesReturn>& OnSuccess, const FFailureCallback& OnFailure)
+	{
+		this->GetTokenSupplies(Args, OnSuccess, OnFailure);
+	});
+}
+
+TSeqFuture<FSeqGetTokenSuppliesMapReturn> USequenceWallet::GetTokenSuppliesMap(const FSeqGetTokenSuppliesMapArgs& Args) const
+{
+	return WalletFuture<FSeqGetTokenSuppliesMapReturn>(this->Indexer != nullptr, [this, Args](const TSuccessCallback<FSeqGetTokenSuppliesMapReturn>& OnSuccess, const FFailureCallback& OnFailure)
+	{
+		this->GetTokenSuppliesMap(Args, OnSuccess, OnFailure);
+	});
+}
+
+TSeqFuture<FSeqGetTransactionHistoryReturn> USequenceWallet::GetTransactionHistory(const FSeqGetTransactionHistoryArgs& Args) const
+{
+	return WalletFuture<FSeqGetTransactionHistoryReturn>(this->Indexer != nullptr, [this, Args](const TSuccessCallback<FSeqGetTransactionHistoryReturn>& OnSuccess, const FFailureCallback& OnFailure)
+	{
+		this->GetTransactionHistory(Args, OnSuccess, OnFailure);
+	});
+}
+
+TSeqFuture<uint64> USequenceWallet::BlockNumber() const
+{
+	return WalletFuture<uint64>(this->Provider != nullptr, [this](const TSuccessCallback<uint64>& OnSuccess, const FFailureCallback& OnFailure)
+	{
+		this->BlockNumber(OnSuccess, OnFailure);
+	});
+}
+
+TSeqFuture<uint64> USequenceWallet::TransactionCount(const FAddress& Addr, const EBlockTag Tag) const
+{
+	return WalletFuture<uint64>(this->Provider != nullptr, [this, Addr, Tag](const TSuccessCallback<uint64>& OnSuccess, const FFailureCallback& OnFailure)
+	{
+		this->TransactionCount(Addr, Tag, OnSuccess, OnFailure);
+	});
+}
+
+TSeqFuture<FTransactionReceipt> USequenceWallet::TransactionReceipt(const FHash256& Hash) const
+{
+	return WalletFuture<FTransactionReceipt>(this->Provider != nullptr, [this, Hash](const TSuccessCallback<FTransactionReceipt>& OnSuccess, const FFailureCallback& OnFailure)
+	{
+		this->TransactionReceipt(Hash, OnSuccess, OnFailure);
+	});
+}
+
+TSeqFuture<FTransactionReceipt> USequenceWallet::WaitForReceipt(const FHash256& Hash, const int32 Confirmations, const float TimeoutSeconds) const
+{
+	return WalletFuture<FTransactionReceipt>(this->Provider != nullptr, [this, Hash, Confirmations, TimeoutSeconds](const TSuccessCallback<FTransactionReceipt>& OnSuccess, const FFailureCallback& OnFailure)
+	{
+		this->WaitForReceipt(Hash, Confirmations, TimeoutSeconds, OnSuccess, OnFailure);
+	});
+}
+
+TSeqFuture<FUnsizedData> USequenceWallet::GetGasPrice() const
+{
+	return WalletFuture<FUnsizedData>(this->Provider != nullptr, [this](const TSuccessCallback<FUnsizedData>& OnSuccess, const FFailureCallback& OnFailure)
+	{
+		this->GetGasPrice(OnSuccess, OnFailure);
+	});
+}
+
+TSeqFuture<FUnsizedData> USequenceWallet::EstimateContractCallGas(const FContractCall& ContractCall) const
+{
+	return WalletFuture<FUnsizedData>(this->Provider != nullptr, [this, ContractCall](const TSuccessCallback<FUnsizedData>& OnSuccess, const FFailureCallback& OnFailure)
+	{
+		this->EstimateContractCallGas(ContractCall, OnSuccess, OnFailure);
+	});
+}
+
+TSeqFuture<FUnsizedData> USequenceWallet::Call(const FContractCall& ContractCall, const EBlockTag Number) const
+{
+	return WalletFuture<FUnsizedData>(this->Provider != nullptr, [this, ContractCall, Number](const TSuccessCallback<FUnsizedData>& OnSuccess, const FFailureCallback& OnFailure)
+	{
+		this->Call(ContractCall, Number, OnSuccess, OnFailure);
+	});
+}
@@ -10,7 +10,7 @@
 #include "IWebBrowserCookieManager.h"
 #include "IWebBrowserSingleton.h"
 #include "PlayFabSendIntent.h"
-#include "RequestHandler.h"
+#include "Http/HttpRequestPool.h"
 #include "WebBrowserModule.h"
 #include "SequenceRPCManager.h"
 #include "Native/NativeOAuth.h"
@@ -620,13 +620,12 @@ FString USequenceAuthenticator::GeneratePlayFabRegisterUrl()
 
 void USequenceAuthenticator::PlayFabRPC(const FString& Url, const FString& Content, const TSuccessCallback<FString>& OnSuccess, const FFailureCallback& OnFailure)
 {
-	NewObject<URequestHandler>()
-	->PrepareRequest()
-	->WithUrl(Url)
-	->WithHeader("Content-type", "application/json")
-	->WithVerb("POST")
-	->WithContentAsString(Content)
-	->ProcessAndThen(OnSuccess, OnFailure);
+	const TSharedRef<FHttpRequestDescriptor> Descriptor = FHttpRequestPool::Acquire();
+	Descriptor->Url = Url;
+	Descriptor->SharedHeaders = FHttpHeaderSets::Json();
+	Descriptor->Content = Content;
+	Descriptor->Priority = ERequestPriority::Critical;
+	FHttpExecutor::ExecuteAndThen(Descriptor, FRequestPolicies::GetPolicy(Url), OnSuccess, OnFailure);
 }
 
 void USequenceAuthenticator::EmailLoginCode(const FString& CodeIn)
@@ -7,6 +7,7 @@
 #include "SequencePlugin.h"
 #include "Modules/ModuleManager.h"
 #include "Engine/Engine.h"
+#include "ProviderSubscriptions.h"
 
 
 #define LOCTEXT_NAMESPACE "FSequencePluginModule"
@@ -24,6 +25,7 @@ void FSequencePluginModule::ShutdownModule()
 
 	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
 	// we call this function before unloading the module.
+	FProviderSubscriptions::CloseAll();
 }
 
 #undef LOCTEXT_NAMESPACE
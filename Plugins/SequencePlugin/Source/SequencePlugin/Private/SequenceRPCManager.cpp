@@ -5,7 +5,8 @@
 #include <ThirdParty/ShaderConductor/ShaderConductor/External/DirectXShaderCompiler/include/dxc/Support/WinAdapter.h>
 
 #include "SequenceAuthenticator.h"
-#include "RequestHandler.h"
+#include "Http/HttpRequestPool.h"
+#include "Http/HttpCompression.h"
 #include "ConfigFetcher.h"
 #include "Interfaces/IHttpResponse.h"
 #include "Types/BinaryData.h"
@@ -14,10 +15,11 @@
 #include "Sequence/SequenceAPI.h"
 #include "Sequence/SequenceAuthResponseIntent.h"
 #include "Misc/DateTime.h"
+#include "ServerClock.h"
 
 template<typename T> FString USequenceRPCManager::GenerateIntent(T Data, TOptional<int64> CurrentTime) const
 {
-	const int64 Issued = CurrentTime.IsSet() ? CurrentTime.GetValue() : FDateTime::UtcNow().ToUnixTimestamp() - 30;
+	const int64 Issued = CurrentTime.IsSet() ? CurrentTime.GetValue() : FServerClock::Get().NowUnix() - 30;
 	const int64 Expires = Issued + 86400;
 	FGenericData * LocalDataPtr = &Data;
 	const FString Operation = LocalDataPtr->Operation;
@@ -40,57 +42,47 @@ template<typename T> FString USequenceRPCManager::GenerateIntent(T Data, TOption
 
 void USequenceRPCManager::SequenceRPC(const FString& Url, const FString& Content, const TSuccessCallback<FString>& OnSuccess, const FFailureCallback& OnFailure) const
 {
-	UE_LOG(LogTemp, Log, TEXT("URL set to: %s"), *Url);
-	UE_LOG(LogTemp, Log, TEXT("Request content set to: %s"), *Content);
-
-
-	NewObject<URequestHandler>()
-	->PrepareRequest()
-	->WithUrl(Url)
-	->WithHeader("Content-type", "application/json")
-	->WithHeader("Accept", "application/json")
-	->WithHeader("X-Access-Key", this->Cached_ProjectAccessKey)
-	->WithVerb("POST")
-	->WithContentAsString(Content)
-	->ProcessAndThen(OnSuccess, OnFailure);
+	const TSharedRef<FHttpRequestDescriptor> Descriptor = FHttpRequestPool::Acquire();
+	Descriptor->Url = Url;
+	Descriptor->SharedHeaders = FHttpHeaderSets::JsonWithAccessKey(this->Cached_ProjectAccessKey);
+	Descriptor->Content = Content;
+	Descriptor->Priority = ERequestPriority::Critical;
+	Descriptor->Category = ERequestCategory::Waas;
+	FHttpExecutor::ExecuteAndThen(Descriptor, FRequestPolicies::GetPolicy(Url), OnSuccess, OnFailure);
 }
 
 void USequenceRPCManager::SequenceRPC(const FString& Url, const FString& Content, const TFunction<void(FHttpResponsePtr)>& OnSuccess, const FFailureCallback& OnFailure) const
 {
-	NewObject<URequestHandler>()
-	->PrepareRequest()
-	->WithUrl(Url)
-	->WithHeader("Content-type", "application/json")
-	->WithHeader("Accept", "application/json")
-	->WithHeader("X-Access-Key", this->Cached_ProjectAccessKey)
-	->WithVerb("POST")
-	->WithContentAsString(Content)
-	->ProcessAndThen(OnSuccess, OnFailure);
+	const TSharedRef<FHttpRequestDescriptor> Descriptor = FHttpRequestPool::Acquire();
+	Descriptor->Url = Url;
+	Descriptor->SharedHeaders = FHttpHeaderSets::JsonWithAccessKey(this->Cached_ProjectAccessKey);
+	Descriptor->Content = Content;
+	Descriptor->Priority = ERequestPriority::Critical;
+	Descriptor->Category = ERequestCategory::Waas;
+	FHttpExecutor::ExecuteAndThen(Descriptor, FRequestPolicies::GetPolicy(Url), OnSuccess, OnFailure);
 }
 
 void USequenceRPCManager::SendIntent(const FString& Url, TFunction<FString(TOptional<int64>)> ContentGenerator,
 	const TSuccessCallback<FString>& OnSuccess, const FFailureCallback& OnFailure) const
 {
-	this->SequenceRPC(Url, ContentGenerator(TOptional<int64>()), [this, Url, ContentGenerator, OnSuccess, OnFailure](FHttpResponsePtr Response)
+	//the intent is issued in server time as last measured, the resend below only happens when the clock jumped since
+	const FDateTime SentAt = FDateTime::UtcNow();
+	this->SequenceRPC(Url, ContentGenerator(TOptional<int64>()), [this, Url, ContentGenerator, SentAt, OnSuccess, OnFailure](FHttpResponsePtr Response)
 	{
-		UE_LOG(LogTemp, Display, TEXT("SUCCESS"));
-		UE_LOG(LogTemp, Display, TEXT("CONTENT"));
-		FString Content = UTF8ToString(FUnsizedData(Response.Get()->GetContent()));
-		UE_LOG(LogTemp, Display, TEXT("%s"), *Content);
+		const FString Content = FHttpCompression::GetContentAsString(Response);
+		const FString Date = Response->GetHeader("Date");
+		const bool bMeasured = FServerClock::Get().ObserveDate(Date, SentAt, FDateTime::UtcNow());
 
 		if(Content.Contains("intent is invalid: intent expired") || Content.Contains("intent is invalid: intent issued in the future"))
 		{
-			FString Date = Response->GetHeader("Date");
 			FDateTime Time;
-			bool IsParsed = FDateTime::ParseHttpDate(Date, Time);
-
-			if(!IsParsed)
+			if(!bMeasured || !FDateTime::ParseHttpDate(Date, Time))
 			{
 				OnFailure(FSequenceError(FailedToParseIntentTime, "Failed to parse intent time " + Date));
 				return;
 			}
-			
-			UE_LOG(LogTemp, Display, TEXT("Resending intent with date %i"), Time.ToUnixTimestamp());
+
+			UE_LOG(LogTemp, Display, TEXT("Resending intent with date %lld"), Time.ToUnixTimestamp());
 			this->SequenceRPC(Url, ContentGenerator(TOptional(Time.ToUnixTimestamp())), OnSuccess, OnFailure);
 		}
 		else
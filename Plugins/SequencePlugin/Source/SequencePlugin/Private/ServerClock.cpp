@@ -0,0 +1,113 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+#include "ServerClock.h"
+#include "Kismet/GameplayStatics.h"
+#include "StorableClockOffset.h"
+#include "Util/Log.h"
+
+FServerClock::FServerClock(const FString& SaveSlotIn) : SaveSlot(SaveSlotIn)
+{
+}
+
+FServerClock& FServerClock::Get()
+{
+	static FServerClock Clock("SeqClk");
+	return Clock;
+}
+
+bool FServerClock::ObserveDate(const FString& DateHeader, const FDateTime& SentAt, const FDateTime& ReceivedAt)
+{
+	FDateTime ServerTime;
+	if (DateHeader.IsEmpty() || !FDateTime::ParseHttpDate(DateHeader, ServerTime))
+	{
+		return false;
+	}
+
+	//the header is truncated to the second and stamped somewhere during the round trip, assume the middle of both
+	const FDateTime LocalTime = SentAt + (ReceivedAt - SentAt) * 0.5;
+	this->ObserveOffset((ServerTime - LocalTime).GetTotalSeconds() + 0.5);
+	return true;
+}
+
+void FServerClock::ObserveOffset(const double SampleSeconds)
+{
+	this->Load();
+
+	if (!this->OffsetSeconds.IsSet() || FMath::Abs(SampleSeconds - this->OffsetSeconds.GetValue()) > JumpSeconds)
+	{
+		this->OffsetSeconds = SampleSeconds;
+	}
+	else
+	{
+		this->OffsetSeconds = this->OffsetSeconds.GetValue() + (SampleSeconds - this->OffsetSeconds.GetValue()) * SampleWeight;
+	}
+
+	if (FMath::Abs(this->OffsetSeconds.GetValue() - this->PersistedOffsetSeconds) >= SaveThresholdSeconds)
+	{
+		SEQ_LOG(Log, TEXT("Server clock offset is now %.2fs"), this->OffsetSeconds.GetValue());
+		this->Save();
+	}
+}
+
+double FServerClock::GetOffsetSeconds()
+{
+	this->Load();
+	return this->OffsetSeconds.Get(0.0);
+}
+
+bool FServerClock::HasOffset()
+{
+	this->Load();
+	return this->OffsetSeconds.IsSet();
+}
+
+int64 FServerClock::NowUnix()
+{
+	return FDateTime::UtcNow().ToUnixTimestamp() + FMath::RoundToInt64(this->GetOffsetSeconds());
+}
+
+void FServerClock::Reset()
+{
+	this->OffsetSeconds.Reset();
+	this->PersistedOffsetSeconds = 0.0;
+	if (!this->SaveSlot.IsEmpty())
+	{
+		UGameplayStatics::DeleteGameInSlot(this->SaveSlot, 0);
+	}
+}
+
+void FServerClock::Load()
+{
+	if (this->bLoaded)
+	{
+		return;
+	}
+	this->bLoaded = true;
+
+	if (this->SaveSlot.IsEmpty() || !UGameplayStatics::DoesSaveGameExist(this->SaveSlot, 0))
+	{
+		return;
+	}
+
+	if (const UStorableClockOffset* Stored = Cast<UStorableClockOffset>(UGameplayStatics::LoadGameFromSlot(this->SaveSlot, 0)))
+	{
+		this->OffsetSeconds = Stored->OffsetSeconds;
+		this->PersistedOffsetSeconds = Stored->OffsetSeconds;
+	}
+}
+
+void FServerClock::Save()
+{
+	if (this->SaveSlot.IsEmpty())
+	{
+		this->PersistedOffsetSeconds = this->OffsetSeconds.Get(0.0);
+		return;
+	}
+
+	if (UStorableClockOffset* Stored = Cast<UStorableClockOffset>(UGameplayStatics::CreateSaveGameObject(UStorableClockOffset::StaticClass())))
+	{
+		Stored->OffsetSeconds = this->OffsetSeconds.Get(0.0);
+		Stored->MeasuredAt = FDateTime::UtcNow().ToUnixTimestamp();
+		this->PersistedOffsetSeconds = Stored->OffsetSeconds;
+		UGameplayStatics::AsyncSaveGameToSlot(Stored, this->SaveSlot, 0);
+	}
+}
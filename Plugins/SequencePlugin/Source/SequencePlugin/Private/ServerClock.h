@@ -0,0 +1,65 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+#pragma once
+#include "CoreMinimal.h"
+
+/**
+ * Tracks the offset between the WaaS server clock and the local clock from the Date header of
+ * intent responses, so intents are issued in server time and a skewed device clock no longer
+ * costs a rejected intent and a second signed send. The offset is saved to a USaveGame slot and
+ * restored on the next launch so even the first intent of a session is issued correctly.
+ * Game thread only.
+ */
+class SEQUENCEPLUGIN_API FServerClock
+{
+	TOptional<double> OffsetSeconds;
+	double PersistedOffsetSeconds = 0.0;
+	FString SaveSlot;
+	bool bLoaded = false;
+
+	void Load();
+	void Save();
+public:
+	/**
+	 * @param SaveSlotIn Slot the offset is persisted in, empty keeps it in memory only
+	 */
+	explicit FServerClock(const FString& SaveSlotIn);
+
+	static FServerClock& Get();
+
+	/**
+	 * Adds a measurement from the Date header of a response
+	 * @param DateHeader Value of the Date header, ignored if it can't be parsed
+	 * @param SentAt Local UTC time the request was sent
+	 * @param ReceivedAt Local UTC time the response arrived
+	 * @return true if the header was used
+	 */
+	bool ObserveDate(const FString& DateHeader, const FDateTime& SentAt, const FDateTime& ReceivedAt);
+
+	/**
+	 * Adds a measured offset, server time minus local time in seconds
+	 */
+	void ObserveOffset(double SampleSeconds);
+
+	/**
+	 * @return server time minus local time in seconds, 0 until the first measurement
+	 */
+	double GetOffsetSeconds();
+
+	bool HasOffset();
+
+	/**
+	 * @return the current unix time of the server as best known
+	 */
+	int64 NowUnix();
+
+	void Reset();
+
+	/* Samples further than this from the current offset replace it instead of being averaged in, e.g. after the user changed the device clock */
+	static constexpr double JumpSeconds = 5.0;
+
+	/* Weight of a new sample in the running average */
+	static constexpr double SampleWeight = 0.25;
+
+	/* The offset is saved again once it moved this far from the saved one */
+	static constexpr double SaveThresholdSeconds = 1.0;
+};
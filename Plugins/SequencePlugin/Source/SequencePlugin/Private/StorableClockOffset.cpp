@@ -0,0 +1,3 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+#include "StorableClockOffset.h"
+UStorableClockOffset::UStorableClockOffset(){}
@@ -0,0 +1,26 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/SaveGame.h"
+#include "StorableClockOffset.generated.h"
+
+/**
+ * Persisted offset between the WaaS server clock and the local clock, see FServerClock
+ */
+UCLASS()
+class SEQUENCEPLUGIN_API UStorableClockOffset : public USaveGame
+{
+	GENERATED_BODY()
+public:
+		//Server time minus local time in seconds
+		UPROPERTY(VisibleAnywhere, Category = Basic)
+			double OffsetSeconds = 0.0;
+
+		//Local unix time the offset was last measured at
+		UPROPERTY(VisibleAnywhere, Category = Basic)
+			int64 MeasuredAt = 0;
+
+		UStorableClockOffset();
+};
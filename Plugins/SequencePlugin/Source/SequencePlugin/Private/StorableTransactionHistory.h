@@ -0,0 +1,37 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/SaveGame.h"
+#include "Indexer/Structs/SeqTransaction.h"
+#include "StorableTransactionHistory.generated.h"
+
+/**
+ * Persisted transaction history of one account on one chain, see FTransactionHistoryStore
+ */
+UCLASS()
+class SEQUENCEPLUGIN_API UStorableTransactionHistory : public USaveGame
+{
+	GENERATED_BODY()
+public:
+		UPROPERTY(VisibleAnywhere, Category = Basic)
+			int64 ChainId = 0;
+
+		UPROPERTY(VisibleAnywhere, Category = Basic)
+			FString AccountAddress = "";
+
+		//Newest first
+		UPROPERTY(VisibleAnywhere, Category = Basic)
+			TArray<FSeqTransaction> Transactions;
+
+		//Highest block number among Transactions, the next sync starts there
+		UPROPERTY(VisibleAnywhere, Category = Basic)
+			int64 NewestBlock = -1;
+
+		//Unix time of the last successful sync
+		UPROPERTY(VisibleAnywhere, Category = Basic)
+			int64 SyncedAt = 0;
+
+		UStorableTransactionHistory();
+};
@@ -0,0 +1,83 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+#include "Misc/AutomationTest.h"
+#include "BlockHeadTracker.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(TestBlockHeadTracker, "Public.TestBlockHeadTracker",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+/*
+* Drives a tracker with hand settled polls and checks that every listener sees each new head once,
+* that repeated or older heads are dropped, that polls do not overlap and that the poll interval is clamped
+*/
+bool TestBlockHeadTracker::RunTest(const FString& Parameters)
+{
+	TArray<TSuccessCallback<uint64>> Polls;
+	const TSharedRef<FBlockHeadTracker> Tracker = MakeShared<FBlockHeadTracker>("test://block-head", [&Polls](const TSuccessCallback<uint64>& OnSuccess, const FFailureCallback& OnFailure)
+	{
+		Polls.Add(OnSuccess);
+	});
+
+	//the first listener starts polling and polls at once
+	TArray<uint64> SeenA;
+	TArray<uint64> SeenB;
+	const int32 ListenerA = Tracker->AddListener([&SeenA](const uint64 Head)
+	{
+		SeenA.Add(Head);
+	});
+	if (!Tracker->IsPolling() || Polls.Num() != 1 || Tracker->GetHead().IsSet())
+	{
+		return false;
+	}
+
+	//a poll in flight is not sent again
+	Tracker->Refresh();
+	if (Polls.Num() != 1)
+	{
+		return false;
+	}
+
+	const int32 ListenerB = Tracker->AddListener([&SeenB](const uint64 Head)
+	{
+		SeenB.Add(Head);
+	});
+	Polls[0](100);
+	if (SeenA != TArray<uint64>{ 100 } || SeenB != TArray<uint64>{ 100 } || Tracker->GetHead().Get(0) != 100)
+	{
+		return false;
+	}
+
+	//the same or an older head is not fanned out again
+	Tracker->Refresh();
+	Polls[1](100);
+	Tracker->Refresh();
+	Polls[2](99);
+	if (SeenA.Num() != 1 || SeenB.Num() != 1 || Tracker->GetHead().Get(0) != 100)
+	{
+		return false;
+	}
+
+	Tracker->RemoveListener(ListenerA);
+	Tracker->Refresh();
+	Polls[3](101);
+	if (SeenA.Num() != 1 || SeenB != TArray<uint64>{ 100, 101 })
+	{
+		return false;
+	}
+
+	//changing the interval keeps polling running, intervals below 0.1 seconds are clamped
+	Tracker->SetPollInterval(5.0f);
+	if (Tracker->GetPollInterval() != 5.0f || !Tracker->IsPolling())
+	{
+		return false;
+	}
+	Tracker->SetPollInterval(0.0f);
+	if (Tracker->GetPollInterval() != 0.1f || !Tracker->IsPolling())
+	{
+		return false;
+	}
+
+	//the last listener stops polling, a new interval does not restart it
+	Tracker->RemoveListener(ListenerB);
+	Tracker->SetPollInterval(1.0f);
+	return !Tracker->IsPolling() && Tracker->GetPollInterval() == 1.0f;
+}
@@ -0,0 +1,75 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+#include "Misc/AutomationTest.h"
+#include "Util/Future.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(TestFuture, "Public.TestFuture",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+/*
+* Settles promises by hand and checks continuations, chaining and the WhenAll / WhenAny joins
+*/
+bool TestFuture::RunTest(const FString& Parameters)
+{
+	//continuations added before and after settling both run, chained futures are flattened
+	const TSeqPromise<int32> Number;
+	const TSeqPromise<FString> Suffix;
+	const TSeqFuture<FString> Chained = Number.GetFuture().Then([Suffix](const int32 Value)
+	{
+		return Suffix.GetFuture().Then([Value](const FString& Text)
+		{
+			return FString::FromInt(Value) + Text;
+		});
+	});
+
+	Number.SetValue(4);
+	if (Chained.IsReady())
+	{
+		return false;
+	}
+	Suffix.SetValue("2");
+	if (!Chained.IsSucceeded() || Chained.GetValue() != "42" || Number.SetValue(5))
+	{
+		return false;
+	}
+
+	//WhenAll keeps the order of its inputs regardless of completion order
+	const TSeqPromise<int32> First;
+	const TSeqPromise<int32> Second;
+	const TSeqFuture<TArray<int32>> Both = SeqFuture::WhenAll(TArray<TSeqFuture<int32>>{ First.GetFuture(), Second.GetFuture() });
+	Second.SetValue(2);
+	First.SetValue(1);
+	if (!Both.IsSucceeded() || Both.GetValue() != TArray<int32>{ 1, 2 })
+	{
+		return false;
+	}
+
+	//mixed types join into a tuple, the first error fails the join
+	const TSeqPromise<FString> Name;
+	const TSeqFuture<TTuple<int32, FString>> Mixed = SeqFuture::WhenAll(SeqFuture::MakeReady<int32>(7), Name.GetFuture());
+	Name.SetValue("seven");
+	if (!Mixed.IsSucceeded() || Mixed.GetValue().Get<0>() != 7 || Mixed.GetValue().Get<1>() != "seven")
+	{
+		return false;
+	}
+
+	const TSeqFuture<TTuple<int32, FString>> Failed = SeqFuture::WhenAll(SeqFuture::MakeReady<int32>(7), SeqFuture::MakeError<FString>(FSequenceError(RequestFail, "offline")));
+	if (!Failed.IsReady() || Failed.IsSucceeded() || Failed.GetError().Message != "offline")
+	{
+		return false;
+	}
+
+	//WhenAny takes the first value and only fails once every input failed
+	const TSeqPromise<int32> Slow;
+	const TSeqFuture<int32> Any = SeqFuture::WhenAny(TArray<TSeqFuture<int32>>{ SeqFuture::MakeError<int32>(FSequenceError(RequestFail, "down")), Slow.GetFuture() });
+	if (Any.IsReady())
+	{
+		return false;
+	}
+	Slow.SetValue(3);
+
+	const TSeqFuture<int32> Recovered = SeqFuture::MakeError<int32>(FSequenceError(RequestFail, "down")).Recover([](const FSequenceError& Error)
+	{
+		return -1;
+	});
+	return Any.IsSucceeded() && Any.GetValue() == 3 && Recovered.IsSucceeded() && Recovered.GetValue() == -1;
+}
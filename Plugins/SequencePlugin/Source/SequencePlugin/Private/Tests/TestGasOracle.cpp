@@ -0,0 +1,44 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+#include "Misc/AutomationTest.h"
+#include "GasOracle.h"
+#include "ProviderBatch.h"
+#include "RPCCaller.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(TestGasOracle, "Public.TestGasOracle",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+/*
+* Checks the eth_feeHistory request and how its result is reduced to a suggestion
+*/
+bool TestGasOracle::RunTest(const FString& Parameters)
+{
+	const TSharedRef<FProviderBatch> Batch = MakeShared<FProviderBatch>("http://127.0.0.1:1/gas-oracle-test");
+	Batch->FeeHistory(4, EBlockTag::ELatest, { 10.0f, 50.0f }, [](const TSharedPtr<FJsonObject>& Result) {}, [](const FSequenceError& Error) {});
+	if (!Batch->BuildContent().Contains("\"method\":\"eth_feeHistory\",\"params\":[\"0x4\",\"latest\",[10.0,50.0]]"))
+	{
+		return false;
+	}
+
+	//4 sampled blocks starting at 0x10, 5 base fees as the last one belongs to the next block
+	const TSharedPtr<FJsonObject> FeeHistory = URPCCaller::Parse(TEXT("{\"oldestBlock\":\"0x10\",\"baseFeePerGas\":[\"0x64\",\"0x6e\",\"0x78\",\"0x82\",\"0x8c\"],\"gasUsedRatio\":[0.5,0.9,0.4,0.7],\"reward\":[[\"0x1\",\"0xa\"],[\"0x3\",\"0x1e\"],[\"0x2\",\"0x14\"],[\"0x5\",\"0x32\"]]}"));
+
+	FGasSuggestion Suggestion;
+	if (!FGasOracle::ParseFeeHistory(FeeHistory, Suggestion))
+	{
+		return false;
+	}
+
+	if (Suggestion.BaseFee != 0x8c || !Suggestion.BlockNumber.IsSet() || Suggestion.BlockNumber.GetValue() != 0x13)
+	{
+		return false;
+	}
+
+	//median of each percentile column, upper middle for an even count
+	if (Suggestion.PriorityFees.Num() != 2 || Suggestion.PriorityFees[0] != 3 || Suggestion.PriorityFees[1] != 30)
+	{
+		return false;
+	}
+
+	FGasSuggestion Empty;
+	return !FGasOracle::ParseFeeHistory(URPCCaller::Parse(TEXT("{\"oldestBlock\":\"0x0\",\"baseFeePerGas\":[]}")), Empty);
+}
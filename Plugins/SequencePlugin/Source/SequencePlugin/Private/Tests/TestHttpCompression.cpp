@@ -0,0 +1,82 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+#include "Misc/AutomationTest.h"
+#include "Http/HttpCompression.h"
+#include "Http/HttpExecutor.h"
+#include "Types/BinaryData.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(TestHttpCompression, "Public.TestHttpCompression",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+/*
+* Round trips a token balance page through gzip, checks that request bodies are only compressed
+* when the policy opts in and above its threshold, and reports the ratio and counted bytes
+*/
+bool TestHttpCompression::RunTest(const FString& Parameters)
+{
+	const FString Balance = "{\"contractAddress\":\"0x631998e91476da5b870d741192fc5cbc55f5a52e\",\"contractType\":\"ERC1155\",\"accountAddress\":\"0x8e3e38fe7367dd3b52d1e281e4e8400447c8d8b9\",\"tokenID\":\"65538\",\"balance\":\"1\",\"chainId\":137,\"tokenMetadata\":{\"name\":\"Sword\",\"description\":\"A sharp sword\",\"image\":\"https://metadata.sequence.app/tokens/65538.png\"}}";
+	FString Page = "{\"page\":{\"pageSize\":200,\"more\":false},\"balances\":[";
+	for (int32 i = 0; i < 200; i++)
+	{
+		Page += (i == 0) ? Balance : TEXT(",") + Balance;
+	}
+	Page += TEXT("]}");
+
+	//round trip
+	const FUnsizedData Plain = StringToUTF8(Page);
+	const int32 PlainSize = Plain.GetLength();
+	TArray<uint8> Compressed;
+	TArray<uint8> Decompressed;
+	if (!FHttpCompression::Gzip(TConstArrayView<uint8>(Plain.Ptr(), PlainSize), Compressed) || !FHttpCompression::IsGzip(Compressed))
+	{
+		return false;
+	}
+
+	if (!FHttpCompression::Gunzip(Compressed, Decompressed) || !UTF8BytesToString(Decompressed).Equals(Page, ESearchCase::CaseSensitive))
+	{
+		return false;
+	}
+
+	//plain json and truncated streams are rejected rather than misread
+	if (FHttpCompression::Gunzip(TConstArrayView<uint8>(Plain.Ptr(), PlainSize), Decompressed) || FHttpCompression::Gunzip(TConstArrayView<uint8>(Compressed.GetData(), 10), Decompressed))
+	{
+		return false;
+	}
+
+	//requests
+	FHttpCompression::ResetStats();
+	FHttpRequestDescriptor Descriptor;
+	Descriptor.Url = "https://compression.invalid/rpc";
+	Descriptor.Content = Page;
+
+	const FHttpRequestRef Untouched = FHttpExecutor::CreateRequest(Descriptor, FRequestPolicy());
+	if (!Untouched->GetHeader("Content-Encoding").IsEmpty() || !Untouched->GetHeader("Accept-Encoding").IsEmpty() || Untouched->GetContent().Num() != PlainSize)
+	{
+		return false;
+	}
+
+	FRequestPolicy Policy;
+	Policy.bAcceptCompressed = true;
+	Policy.CompressRequestsAboveBytes = PlainSize + 1;
+	const FHttpRequestRef BelowThreshold = FHttpExecutor::CreateRequest(Descriptor, Policy);
+	if (!BelowThreshold->GetHeader("Content-Encoding").IsEmpty() || !BelowThreshold->GetHeader("Accept-Encoding").Equals("gzip"))
+	{
+		return false;
+	}
+
+	Policy.CompressRequestsAboveBytes = 1024;
+	const FHttpRequestRef Encoded = FHttpExecutor::CreateRequest(Descriptor, Policy);
+	if (!Encoded->GetHeader("Content-Encoding").Equals("gzip") || !FHttpCompression::IsGzip(Encoded->GetContent()) || Encoded->GetContent().Num() >= PlainSize)
+	{
+		return false;
+	}
+
+	const FHttpTransferStats Stats = FHttpCompression::GetStats();
+	if (Stats.CompressedRequests != 1 || Stats.RequestPlainBytes != 3 * PlainSize || Stats.GetSavedBytes() != PlainSize - Encoded->GetContent().Num())
+	{
+		return false;
+	}
+	FHttpCompression::ResetStats();
+
+	AddInfo(FString::Printf(TEXT("Token balance page: %d bytes plain, %d bytes gzip (%.1f%%)"), PlainSize, Compressed.Num(), 100.0 * Compressed.Num() / PlainSize));
+	return true;
+}
@@ -0,0 +1,57 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+#include "Misc/AutomationTest.h"
+#include "Util/InFlightRequests.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(TestInFlightRequests, "Public.TestInFlightRequests",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+/*
+* Joins one key several times and checks that only the first caller leads, that Resolve and Reject
+* reach every waiter and that the key is free for a new leader once it settled
+*/
+bool TestInFlightRequests::RunTest(const FString& Parameters)
+{
+	TInFlightRequests<int32> InFlight;
+	TArray<int32> Values;
+	TArray<FString> Errors;
+	const TSuccessCallback<int32> OnValue = [&Values](const int32 Value)
+	{
+		Values.Add(Value);
+	};
+	const FFailureCallback OnError = [&Errors](const FSequenceError& Error)
+	{
+		Errors.Add(Error.Message);
+	};
+
+	//the first caller leads, later callers wait behind it, other keys are independent
+	if (InFlight.Join("a", OnValue, OnError) || !InFlight.Join("a", OnValue, OnError) || !InFlight.Join("a", OnValue, OnError))
+	{
+		return false;
+	}
+	if (InFlight.Join("b", OnValue, OnError) || InFlight.Num() != 2)
+	{
+		return false;
+	}
+
+	InFlight.Resolve("a", 7);
+	if (Values != TArray<int32>{ 7, 7, 7 } || Errors.Num() != 0 || InFlight.Num() != 1)
+	{
+		return false;
+	}
+
+	//settling a key twice or a key nobody waits on is a no-op
+	InFlight.Resolve("a", 8);
+	if (Values.Num() != 3)
+	{
+		return false;
+	}
+
+	//once settled the key takes a new leader
+	if (InFlight.Join("a", OnValue, OnError) || !InFlight.Join("a", OnValue, OnError))
+	{
+		return false;
+	}
+	InFlight.Reject("a", FSequenceError(RequestFail, "down"));
+	InFlight.Reject("b", FSequenceError(RequestFail, "gone"));
+	return Values.Num() == 3 && Errors == TArray<FString>{ "down", "down", "gone" } && InFlight.Num() == 0;
+}
@@ -0,0 +1,64 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+#include "Misc/AutomationTest.h"
+#include "Indexer/IndexerCache.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(TestIndexerCache, "Public.TestIndexerCache",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+/*
+* Ages entries with a hand driven clock and checks the fresh / stale / expired windows,
+* that equivalent arguments share an entry and that invalidation only hits the given endpoint and chain
+*/
+bool TestIndexerCache::RunTest(const FString& Parameters)
+{
+	double Now = 1000.0;
+	FIndexerCache Cache(FIndexerCache::DefaultMaxBytes);
+	Cache.SetClock([&Now]()
+	{
+		return Now;
+	});
+
+	//key order, whitespace and address case do not matter
+	const FString Key = FIndexerCache::MakeKey(137, "GetTokenBalances", "{\"accountAddress\":\"0xABC\", \"includeMetaData\":true}");
+	if (Key != FIndexerCache::MakeKey(137, "GetTokenBalances", "{\"includeMetaData\":true,\"accountAddress\":\"0xabc\"}")
+		|| Key == FIndexerCache::MakeKey(1, "GetTokenBalances", "{\"accountAddress\":\"0xabc\",\"includeMetaData\":true}"))
+	{
+		return false;
+	}
+
+	const FIndexerCachePolicy Policy(10.0f, 50.0f);
+	if (Cache.GetPolicy("GetTokenBalances").IsEnabled() || Cache.Find(Key, Policy).State != EIndexerCacheLookup::Miss)
+	{
+		return false;
+	}
+
+	Cache.Store(Key, "{\"balances\":[]}");
+	Now += 5.0;
+	const FIndexerCacheHit Fresh = Cache.Find(Key, Policy);
+	if (Fresh.State != EIndexerCacheLookup::Fresh || Fresh.Response != "{\"balances\":[]}")
+	{
+		return false;
+	}
+	Now += 30.0;
+	if (Cache.Find(Key, Policy).State != EIndexerCacheLookup::Stale)
+	{
+		return false;
+	}
+	Now += 30.0;
+	if (Cache.Find(Key, Policy).State != EIndexerCacheLookup::Expired)
+	{
+		return false;
+	}
+
+	//a new response restarts the clock
+	Cache.Store(Key, "{\"balances\":[{}]}");
+	if (Cache.Find(Key, Policy).State != EIndexerCacheLookup::Fresh)
+	{
+		return false;
+	}
+
+	const FString Other = FIndexerCache::MakeKey(137, "GetTokenSupplies", "{}");
+	Cache.Store(Other, "{}");
+	Cache.Invalidate(137, "GetTokenBalances");
+	return Cache.Find(Key, Policy).State == EIndexerCacheLookup::Miss && Cache.Find(Other, Policy).State == EIndexerCacheLookup::Fresh && Cache.Num() == 1;
+}
@@ -0,0 +1,114 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+#include "Misc/AutomationTest.h"
+#include "Indexer/IndexerPageIterator.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(TestIndexerPageIterator, "Public.TestIndexerPageIterator",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+static FSeqGetTransactionHistoryReturn HistoryPage(const int32 Next, const bool bMore, const int32 Transactions)
+{
+	FSeqGetTransactionHistoryReturn Page;
+	Page.page.page = Next;
+	Page.page.pageSize = 2;
+	Page.page.more = bMore;
+	Page.transactions.AddDefaulted(Transactions);
+	return Page;
+}
+
+/*
+* Answers page requests by hand and checks that the next page is prefetched with the returned cursor,
+* that items stream until the consumer stops and that nothing is delivered after stopping
+*/
+bool TestIndexerPageIterator::RunTest(const FString& Parameters)
+{
+	TArray<FSeqGetTransactionHistoryArgs> Requested;
+	TArray<TSeqPromise<FSeqGetTransactionHistoryReturn>> Responses;
+	const TSharedRef<FTransactionHistoryIterator> Iterator = MakeShared<FTransactionHistoryIterator>(FSeqGetTransactionHistoryArgs("0xabc"), &FSeqGetTransactionHistoryReturn::transactions, [&Requested, &Responses](const FSeqGetTransactionHistoryArgs& Args)
+	{
+		Requested.Add(Args);
+		return Responses.AddDefaulted_GetRef().GetFuture();
+	});
+
+	int32 Items = 0;
+	bool bDone = false;
+	Iterator->ForEachItem([&Items](const FSeqTransaction&)
+	{
+		return ++Items < 3;
+	}, [&bDone]()
+	{
+		bDone = true;
+	}, [](const FSequenceError&)
+	{
+	});
+
+	//the first page goes out without a page, the second is requested with the cursor of the first before it is consumed
+	if (Requested.Num() != 1 || Requested[0].page.IsSet())
+	{
+		return false;
+	}
+	Responses[0].SetValue(HistoryPage(1, true, 2));
+	if (Requested.Num() != 2 || Requested[1].page.GetValue().page != 1 || Items != 2)
+	{
+		return false;
+	}
+
+	//the third item stops the iteration mid page, the prefetched third page is dropped
+	Responses[1].SetValue(HistoryPage(2, true, 2));
+	if (Items != 3 || !bDone || Iterator->HasMore() || Iterator->IsPrefetching() || Requested.Num() != 3)
+	{
+		return false;
+	}
+	Responses[2].SetValue(HistoryPage(3, false, 2));
+	if (Items != 3 || Iterator->GetPagesRead() != 2)
+	{
+		return false;
+	}
+
+	//ReadAll stops after the last page
+	TArray<FSeqTokenBalance> Balances;
+	const FTokenBalancesIterator::FPageFetch ThreePages = [](const FSeqGetTokenBalancesArgs& Args)
+	{
+		FSeqGetTokenBalancesReturn Page;
+		Page.page.page = Args.page.page + 1;
+		Page.page.more = Page.page.page < 2;
+		Page.balances.AddDefaulted(2);
+		return SeqFuture::MakeReady(Page);
+	};
+	const TSharedRef<FTokenBalancesIterator> AllBalances = MakeShared<FTokenBalancesIterator>(FSeqGetTokenBalancesArgs(), &FSeqGetTokenBalancesReturn::balances, ThreePages);
+	AllBalances->SetPrefetch(false);
+	AllBalances->ReadAll(0, [&Balances](const TArray<FSeqTokenBalance>& Read)
+	{
+		Balances = Read;
+	}, [](const FSequenceError&)
+	{
+	});
+	if (Balances.Num() != 6 || AllBalances->GetPagesRead() != 3 || AllBalances->StoppedEarly())
+	{
+		return false;
+	}
+
+	//a page cap below the number of pages cuts the read short and says so, without prefetching past the cap
+	int32 Fetches = 0;
+	const TSharedRef<FTokenBalancesIterator> CappedBalances = MakeShared<FTokenBalancesIterator>(FSeqGetTokenBalancesArgs(), &FSeqGetTokenBalancesReturn::balances, [&Fetches, ThreePages](const FSeqGetTokenBalancesArgs& Args)
+	{
+		Fetches++;
+		return ThreePages(Args);
+	});
+	CappedBalances->ReadAll(2, [&Balances](const TArray<FSeqTokenBalance>& Read)
+	{
+		Balances = Read;
+	}, [](const FSequenceError&)
+	{
+	});
+	if (Balances.Num() != 4 || !CappedBalances->StoppedEarly() || Fetches != 2)
+	{
+		return false;
+	}
+
+	//a page cursor in the history args is separated by a comma, a page size alone is enough to be sent
+	FSeqGetTransactionHistoryArgs Args("0xabc");
+	FSeqPage Page;
+	Page.pageSize = 10;
+	Args.page = Page;
+	return Args.GetArgs().Contains(",\"page\":{\"pageSize\":10,\"more\":false}");
+}
@@ -0,0 +1,80 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+#include "Misc/AutomationTest.h"
+#include "Indexer/Indexer.h"
+#include "RPCCaller.h"
+#include "Types/BinaryData.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(TestIndexerParseBenchmark, "Public.TestIndexerParseBenchmark",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+/*
+* Builds a multi megabyte GetTokenBalances body and parses it the old way (widen to FString, parse once for
+* the error check and once more to build the struct) and straight from the UTF-8 bytes, reporting MB/s and
+* the transient string memory the old path needed
+*/
+bool TestIndexerParseBenchmark::RunTest(const FString& Parameters)
+{
+	constexpr int32 Balances = 6000;
+	constexpr int32 Iterations = 5;
+	const FString Balance = TEXT("{\"id\":15,\"contractAddress\":\"0xc1\",\"contractType\":\"ERC20\",\"accountAddress\":\"0xa1\",\"tokenID\":11,\"balance\":16384,\"blockHash\":\"0xb1\",\"blockNumber\":1,\"updateID\":3,\"chainId\":137,\"contractInfo\":{\"chainId\":137,\"address\":\"0xa11\",\"name\":\"Caf\u00e9 \u00dcbercoin\",\"type\":\"t1\",\"symbol\":\"%\",\"decimals\":18,\"logoURI\":\"http://stuff.ca\",\"extensions\":{\"link\":\"https://that.com\",\"description\":\"extension\",\"ogImage\":\"uint8[]\",\"originChainId\":137,\"originAddress\":\"http://origin.ca\",\"blacklist\":true,\"verified\":false,\"verifiedBy\":\"\"}},\"tokenMetaData\":{\"tokenId\":101,\"contractAddress\":\"0xc112\",\"name\":\"testing_name\",\"description\":\"some_desc_stuff\",\"image\":\"string_image_data\",\"decimals\":18,\"properties\":{\"p1\":10,\"p2\":\"prop_2\"},\"attributes\":[{\"a11\":\"a\",\"a12\":\"b\"}]}}");
+
+	FString Text = "{\"page\":{\"page\":1,\"pageSize\":6000,\"more\":false},\"balances\":[";
+	for (int32 i = 0; i < Balances; i++)
+	{
+		Text += (i == 0) ? Balance : TEXT(",") + Balance;
+	}
+	Text += TEXT("]}");
+
+	//what the http response hands over
+	const FTCHARToUTF8 Converted(*Text);
+	const TArray<uint8> Body(reinterpret_cast<const uint8*>(Converted.Get()), Converted.Length());
+	const double Megabytes = Body.Num() / (1024.0 * 1024.0);
+
+	UIndexer* Indexer = NewObject<UIndexer>();
+
+	//correctness, both paths must agree and keep multi byte characters intact
+	const FSeqGetTokenBalancesReturn FromBytes = Indexer->BuildResponse<FSeqGetTokenBalancesReturn>(URPCCaller::Parse(Body));
+	const FSeqGetTokenBalancesReturn FromString = Indexer->BuildResponse<FSeqGetTokenBalancesReturn>(UTF8BytesToString(Body));
+	if (FromBytes.balances.Num() != Balances || FromString.balances.Num() != Balances)
+	{
+		return false;
+	}
+
+	if (!FromBytes.balances[Balances - 1].contractInfo.name.Equals(TEXT("Caf\u00e9 \u00dcbercoin")) || !FromBytes.balances[0].contractInfo.name.Equals(FromString.balances[0].contractInfo.name))
+	{
+		return false;
+	}
+
+	//benchmark
+	int64 Checksum = 0;
+	double Start = FPlatformTime::Seconds();
+	for (int32 i = 0; i < Iterations; i++)
+	{
+		const FString Content = UTF8BytesToString(Body);
+		if (URPCCaller::Parse(Content)->HasField(TEXT("error")))
+		{
+			return false;
+		}
+		Checksum += Indexer->BuildResponse<FSeqGetTokenBalancesReturn>(Content).balances.Num();
+	}
+	const double StringSeconds = (FPlatformTime::Seconds() - Start) / Iterations;
+
+	Start = FPlatformTime::Seconds();
+	for (int32 i = 0; i < Iterations; i++)
+	{
+		const TSharedPtr<FJsonObject> Json = URPCCaller::Parse(Body);
+		if (Json->HasField(TEXT("error")))
+		{
+			return false;
+		}
+		Checksum += Indexer->BuildResponse<FSeqGetTokenBalancesReturn>(Json).balances.Num();
+	}
+	const double BytesSeconds = (FPlatformTime::Seconds() - Start) / Iterations;
+
+	AddInfo(FString::Printf(TEXT("Payload: %.2f MB, %d balances"), Megabytes, Balances));
+	AddInfo(FString::Printf(TEXT("FString path: %.1f ms/response, %.1f MB/s, %.2f MB transient string"), StringSeconds * 1e3, Megabytes / StringSeconds, Text.Len() * sizeof(TCHAR) / (1024.0 * 1024.0)));
+	AddInfo(FString::Printf(TEXT("UTF-8 path: %.1f ms/response, %.1f MB/s, no transient string"), BytesSeconds * 1e3, Megabytes / BytesSeconds));
+	AddInfo(FString::Printf(TEXT("Checksum %lld"), Checksum));
+
+	return true;
+}
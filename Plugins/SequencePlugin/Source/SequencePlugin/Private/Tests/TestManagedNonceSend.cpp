@@ -0,0 +1,76 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+#include "Misc/AutomationTest.h"
+#include "Provider.h"
+#include "NonceManager.h"
+#include "Eth/Crypto.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(TestManagedNonceSend, "Public.TestManagedNonceSend",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+/*
+* Sends through a scripted node that rejects the first transaction with "nonce too low" and checks that the
+* pending count is fetched again and the send is retried with the new nonce, then that a send lost in transport
+* keeps its nonce until the next count settles it
+*/
+bool TestManagedNonceSend::RunTest(const FString& Parameters)
+{
+	const FString Url = "test://managed-nonce-send";
+	const FString Hash = "0x88df016429689c079f3b2f6ad39fa052532c56795b733da78a91ebe6a713944b";
+	const FPrivateKey PrivateKey = FPrivateKey::From("abc0000000000000000000000000000000000000000000000000000000000001");
+
+	TArray<FString> PendingCounts = { "0x5", "0x7", "0x8" };
+	TArray<FString> SendAnswers = {
+		"{\"jsonrpc\":\"2.0\",\"id\":1,\"error\":{\"code\":-32000,\"message\":\"nonce too low\"}}",
+		"{\"jsonrpc\":\"2.0\",\"id\":1,\"result\":\"" + Hash + "\"}",
+		""
+	};
+	int32 CountCalls = 0;
+	TArray<FString> Sent;
+	URPCCaller::SetResponder(Url, [&](const FString& Content, const TSuccessCallback<FString>& OnSuccess, const FFailureCallback& OnFailure)
+	{
+		if (Content.Contains("eth_getTransactionCount"))
+		{
+			OnSuccess("{\"jsonrpc\":\"2.0\",\"id\":1,\"result\":\"" + PendingCounts[CountCalls++] + "\"}");
+			return;
+		}
+
+		const FString Answer = SendAnswers[Sent.Num()];
+		Sent.Add(Content);
+		if (Answer.IsEmpty())
+		{
+			OnFailure(FSequenceError(RequestFail, "Request failed: No response received!"));
+			return;
+		}
+		OnSuccess(Answer);
+	});
+
+	UProvider* Provider = UProvider::Make(Url);
+	const TSharedRef<FNonceManager> Nonces = Provider->GetNonceManager(GetAddress(GetPublicKey(PrivateKey)));
+	int32 Successes = 0;
+	TArray<FString> Errors;
+	const TSuccessCallback<FUnsizedData> OnSent = [&Successes](const FUnsizedData& SentHash)
+	{
+		Successes++;
+	};
+	const FFailureCallback OnFailure = [&Errors](const FSequenceError& Error)
+	{
+		Errors.Add(Error.Message);
+	};
+
+	const FAddress To = FAddress::From("1099542D7dFaF6757527146C0aB9E70A967f71C0");
+	const FUnsizedData GasPrice = FUnsizedData::From("3b9aca00");
+	const FUnsizedData GasLimit = FUnsizedData::From("5208");
+
+	//the stale nonce 5 is rejected, the count is fetched again and nonce 7 goes out
+	Provider->NonViewCall(To, FUnsizedData::From("00"), FUnsizedData::From(""), GasPrice, GasLimit, PrivateKey, 137, OnSent, OnFailure);
+	if (CountCalls != 2 || Sent.Num() != 2 || Sent[0] == Sent[1] || Successes != 1 || Errors.Num() != 0 || Nonces->NumInFlight() != 0)
+	{
+		URPCCaller::SetResponder(Url, nullptr);
+		return false;
+	}
+
+	//nonce 8 is lost in transport, the caller fails but the nonce stays reserved until the count settles it
+	Provider->NonViewCall(To, FUnsizedData::From("00"), FUnsizedData::From(""), GasPrice, GasLimit, PrivateKey, 137, OnSent, OnFailure);
+	URPCCaller::SetResponder(Url, nullptr);
+	return Sent.Num() == 3 && Errors.Num() == 1 && CountCalls == 3 && Nonces->NumInFlight() == 0 && Nonces->IsSeeded();
+}
@@ -0,0 +1,92 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+#include "Misc/AutomationTest.h"
+#include "NonceManager.h"
+#include "RPCCaller.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(TestNonceManager, "Public.TestNonceManager",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+/*
+* Seeds a manager by hand and checks local hand out, reuse of released nonces, settling of sends
+* lost in transport and error classification
+*/
+bool TestNonceManager::RunTest(const FString& Parameters)
+{
+	const TSharedRef<FNonceManager> Nonces = MakeShared<FNonceManager>("http://127.0.0.1:1/nonce-manager-test", FAddress::From("1099542D7dFaF6757527146C0aB9E70A967f71C0"));
+	Nonces->Seed(10);
+
+	TArray<uint64> Given;
+	const TSuccessCallback<uint64> OnNonce = [&Given](const uint64 Nonce)
+	{
+		Given.Add(Nonce);
+	};
+	const FFailureCallback OnFailure = [](const FSequenceError& Error) {};
+
+	//seeded managers answer synchronously
+	Nonces->Acquire(OnNonce, OnFailure);
+	Nonces->Acquire(OnNonce, OnFailure);
+	Nonces->Acquire(OnNonce, OnFailure);
+	if (Given != TArray<uint64>{ 10, 11, 12 } || Nonces->NumInFlight() != 3)
+	{
+		return false;
+	}
+
+	//a released gap is filled before new nonces, releasing the newest one just rewinds
+	Nonces->Release(11);
+	Nonces->Acquire(OnNonce, OnFailure);
+	Nonces->Release(12);
+	Nonces->Acquire(OnNonce, OnFailure);
+	if (Given != TArray<uint64>{ 10, 11, 12, 11, 12 })
+	{
+		return false;
+	}
+
+	Nonces->Confirm(10);
+	Nonces->Confirm(11);
+	Nonces->Confirm(12);
+	if (Nonces->NumInFlight() != 0)
+	{
+		return false;
+	}
+
+	//preparing a seeded manager answers right away without reserving anything
+	bool bPrepared = false;
+	Nonces->Prepare([&bPrepared]() { bPrepared = true; }, OnFailure);
+	Nonces->Acquire(OnNonce, OnFailure);
+	if (!bPrepared || Given.Last() != 13)
+	{
+		return false;
+	}
+	Nonces->Release(13);
+
+	//sends lost in transport stay reserved, acquiring waits for the count that tells whether the node got them
+	Nonces->Acquire(OnNonce, OnFailure);
+	Nonces->Acquire(OnNonce, OnFailure);
+	Nonces->Acquire(OnNonce, OnFailure);
+	Nonces->Unresolved(13);
+	Nonces->Unresolved(14);
+	Nonces->Acquire(OnNonce, OnFailure);
+	if (Given.Last() != 15 || Nonces->NumInFlight() != 3 || Nonces->IsSeeded())
+	{
+		return false;
+	}
+
+	//the pool holds 13 but not 14, which is handed out again before anything new
+	Nonces->OnSeeded(14);
+	Nonces->Acquire(OnNonce, OnFailure);
+	if (Given != TArray<uint64>{ 10, 11, 12, 11, 12, 13, 13, 14, 15, 14, 16 } || Nonces->NumInFlight() != 3)
+	{
+		return false;
+	}
+	Nonces->Confirm(14);
+	Nonces->Confirm(15);
+	Nonces->Confirm(16);
+
+	const bool bClassified = FNonceManager::IsNonceTooLow(FSequenceError(RequestFail, "RPC Error: Nonce too low. Expected nonce to be 13 but got 12."))
+		&& FNonceManager::IsNonceTooLow(FSequenceError(RequestFail, "RPC Error: nonce too low"))
+		&& !FNonceManager::IsNonceTooLow(FSequenceError(RequestFail, "RPC Error: insufficient funds for gas * price + value"))
+		&& URPCCaller::IsRpcError(FSequenceError(RequestFail, "RPC Error: insufficient funds for gas * price + value"))
+		&& !URPCCaller::IsRpcError(FSequenceError(RequestFail, "HTTP Error: 502"));
+
+	return bClassified && FNonceManager::ToBlockNonce(0x1234).ToHex().Equals("0000000000001234");
+}
@@ -0,0 +1,93 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+#include "Misc/AutomationTest.h"
+#include "Indexer/PortfolioQuery.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(TestPortfolio, "Public.TestPortfolio",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+/*
+* Drives a portfolio query over four chains with hand settled fetches and checks the concurrency cap,
+* the streamed partial results, the request ordering of the merged portfolio and that a failed chain is tolerated
+*/
+bool TestPortfolio::RunTest(const FString& Parameters)
+{
+	TMap<int64, TSeqPromise<FSeqChainPortfolio>> Fetches;
+	const TSharedRef<FPortfolioQuery> Query = MakeShared<FPortfolioQuery>("0xabc", TArray<int64>{ 1, 137, 10, 8453 }, 2, [&Fetches](const int64 ChainId)
+	{
+		return Fetches.Add(ChainId).GetFuture();
+	});
+
+	TArray<int64> Streamed;
+	TOptional<FSeqPortfolio> Result;
+	Query->Start([&Streamed](const FSeqChainPortfolio& Chain, const FSeqPortfolio& SoFar)
+	{
+		Streamed.Add(Chain.chainId);
+	}, [&Result](const FSeqPortfolio& Portfolio)
+	{
+		Result = Portfolio;
+	});
+
+	//only two chains run at once, the next starts as one completes
+	if (Fetches.Num() != 2 || !Fetches.Contains(1) || !Fetches.Contains(137))
+	{
+		return false;
+	}
+
+	FSeqChainPortfolio Polygon;
+	Polygon.succeeded = true;
+	Polygon.balances.AddDefaulted(3);
+	Fetches[137].SetValue(Polygon);
+	if (Fetches.Num() != 3 || !Fetches.Contains(10) || Streamed != TArray<int64>{ 137 } || Query->GetPortfolio().completedChains != 1)
+	{
+		return false;
+	}
+
+	Fetches[1].SetError(FSequenceError(RequestFail, "mainnet down"));
+	FSeqChainPortfolio Optimism;
+	Optimism.succeeded = true;
+	Optimism.balances.AddDefaulted(1);
+	Fetches[10].SetValue(Optimism);
+	if (Result.IsSet() || Query->GetRunning() != 1)
+	{
+		return false;
+	}
+
+	Fetches[8453].SetValue(FSeqChainPortfolio());
+	if (!Result.IsSet() || Streamed != TArray<int64>{ 137, 1, 10, 8453 })
+	{
+		return false;
+	}
+
+	//chains keep the requested order, the failed chain is kept with its error and left out of the merged balances
+	const FSeqPortfolio& Portfolio = Result.GetValue();
+	if (Portfolio.accountAddress != "0xabc" || Portfolio.chains.Num() != 4 || Portfolio.chains[0].chainId != 1 || Portfolio.chains[3].chainId != 8453)
+	{
+		return false;
+	}
+	if (Portfolio.chains[0].succeeded || Portfolio.chains[0].error != "mainnet down" || Portfolio.failedChains != 2 || !Portfolio.IsComplete())
+	{
+		return false;
+	}
+	if (Portfolio.GetAllBalances().Num() != 4)
+	{
+		return false;
+	}
+
+	//a cancelled query starts nothing further and reports nothing
+	TArray<TSeqPromise<FSeqChainPortfolio>> Pending;
+	bool bCalled = false;
+	const TSharedRef<FPortfolioQuery> Cancelled = MakeShared<FPortfolioQuery>("0xabc", TArray<int64>{ 1, 137, 10 }, 1, [&Pending](const int64 ChainId)
+	{
+		return Pending.AddDefaulted_GetRef().GetFuture();
+	});
+	Cancelled->Start([&bCalled](const FSeqChainPortfolio&, const FSeqPortfolio&)
+	{
+		bCalled = true;
+	}, [&bCalled](const FSeqPortfolio&)
+	{
+		bCalled = true;
+	});
+	Cancelled->Cancel();
+	Pending[0].SetValue(FSeqChainPortfolio());
+	return !bCalled && Pending.Num() == 1;
+}
@@ -0,0 +1,79 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+#include "Misc/AutomationTest.h"
+#include "ProviderBatch.h"
+#include "Util/HexUtility.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(TestProviderBatch, "Public.TestProviderBatch",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool TestProviderBatch::RunTest(const FString& Parameters)
+{
+	const TSharedRef<FProviderBatch> Batch = MakeShared<FProviderBatch>("http://localhost:8545/");
+
+	uint64 BlockNumber = 0;
+	uint64 ChainId = 0;
+	FString GasPriceHex = "";
+	FString FailureMessage = "";
+	int32 Failures = 0;
+	EErrorType FailureType = RequestFail;
+	const FFailureCallback OnFailure = [&Failures, &FailureMessage, &FailureType](const FSequenceError& Error)
+	{
+		Failures++;
+		FailureMessage = Error.Message;
+		FailureType = Error.Type;
+	};
+
+	Batch->BlockNumber([&BlockNumber](const uint64 Number){ BlockNumber = Number; }, OnFailure);
+	Batch->ChainId([&ChainId](const uint64 Id){ ChainId = Id; }, OnFailure);
+	Batch->GetGasPrice([&GasPriceHex](const FUnsizedData& GasPrice){ GasPriceHex = GasPrice.ToHex(); }, OnFailure);
+	Batch->TransactionCount(FAddress::From("1099542D7dFaF6757527146C0aB9E70A967f71C0"), EBlockTag::ELatest, [](const uint64 Count){}, OnFailure);
+
+	if (Batch->Num() != 4)
+	{
+		return false;
+	}
+
+	const FString Content = Batch->BuildContent();
+	if (!Content.StartsWith("[") || !Content.Contains("\"id\":4") || !Content.Contains("eth_getTransactionCount"))
+	{
+		return false;
+	}
+
+	//responses come back out of order and the last call errors
+	Batch->DispatchResponse("[{\"jsonrpc\":\"2.0\",\"id\":3,\"result\":\"0x3b9aca00\"},"
+		"{\"jsonrpc\":\"2.0\",\"id\":4,\"error\":{\"code\":-32000,\"message\":\"header not found\"}},"
+		"{\"jsonrpc\":\"2.0\",\"id\":1,\"result\":\"0x10\"},"
+		"{\"jsonrpc\":\"2.0\",\"id\":2,\"result\":\"0x89\"}]");
+
+	if (BlockNumber != 0x10 || ChainId != 137 || Failures != 1 || !FailureMessage.Contains("header not found"))
+	{
+		return false;
+	}
+
+	if (!GasPriceHex.Equals(HexStringToBinary("0x3b9aca00").ToHex()))
+	{
+		return false;
+	}
+
+	//a rejected batch fails every queued call
+	const TSharedRef<FProviderBatch> Rejected = MakeShared<FProviderBatch>("http://localhost:8545/");
+	Failures = 0;
+	Rejected->BlockNumber([](const uint64 Number){}, OnFailure);
+	Rejected->ChainId([](const uint64 Id){}, OnFailure);
+	Rejected->DispatchResponse("{\"jsonrpc\":\"2.0\",\"id\":null,\"error\":{\"code\":-32600,\"message\":\"batch too large\"}}");
+
+	if (Failures != 2)
+	{
+		return false;
+	}
+
+	//a reply missing an id is a parse error rather than a null result
+	const TSharedRef<FProviderBatch> Truncated = MakeShared<FProviderBatch>("http://localhost:8545/");
+	Failures = 0;
+	BlockNumber = 0;
+	Truncated->BlockNumber([&BlockNumber](const uint64 Number){ BlockNumber = Number; }, OnFailure);
+	Truncated->TransactionReceipt(FHash256::From("88df016429689c079f3b2f6ad39fa052532c56795b733da78a91ebe6a713944b"), [](const FTransactionReceipt& Receipt){}, OnFailure);
+	Truncated->DispatchResponse("[{\"jsonrpc\":\"2.0\",\"id\":1,\"result\":\"0x10\"}]");
+
+	return BlockNumber == 0x10 && Failures == 1 && FailureType == ResponseParseError;
+}
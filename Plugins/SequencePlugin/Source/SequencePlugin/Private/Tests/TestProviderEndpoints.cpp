@@ -0,0 +1,49 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+#include "Misc/AutomationTest.h"
+#include "ProviderEndpoints.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(TestProviderEndpoints, "Public.TestProviderEndpoints",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool TestProviderEndpoints::RunTest(const FString& Parameters)
+{
+	FProviderEndpoints Endpoints({"https://own-node.invalid", "https://public-a.invalid", "https://public-b.invalid"});
+	Endpoints.SetExploreRate(0.0f);
+
+	//unmeasured nodes get probed first
+	Endpoints.ReportSuccess(0, 0.30);
+	Endpoints.ReportSuccess(1, 0.05);
+	if (Endpoints.SelectForRead(TSet<int32>()) != 2)
+	{
+		return false;
+	}
+
+	Endpoints.ReportSuccess(2, 0.10);
+	if (Endpoints.SelectForRead(TSet<int32>()) != 1)
+	{
+		return false;
+	}
+
+	//a failing node cools down and reads move to the next fastest one
+	Endpoints.ReportFailure(1);
+	if (Endpoints.SelectForRead(TSet<int32>()) != 2 || Endpoints.GetErrorRate(1) <= 0.0)
+	{
+		return false;
+	}
+
+	//failover never returns a node already tried for the call
+	if (Endpoints.SelectForRead({0, 1, 2}) != INDEX_NONE || Endpoints.SelectForRead({2}) != 0)
+	{
+		return false;
+	}
+
+	//writes stay pinned to the primary while it is healthy and move on once it fails
+	if (Endpoints.SelectForWrite() != 0 || Endpoints.SelectForWrite() != 0)
+	{
+		return false;
+	}
+
+	Endpoints.ReportFailure(0);
+	const int32 Repinned = Endpoints.SelectForWrite();
+	return Repinned == 2 && Endpoints.SelectForWrite() == Repinned;
+}
@@ -0,0 +1,43 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+#include "Misc/AutomationTest.h"
+#include "Provider.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(TestProviderImmutableCache, "Public.TestProviderImmutableCache",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+/*
+* Looks a transaction up through a scripted node while it is pending and again once mined, checking only
+* the mined answer is served from the immutable cache afterwards
+*/
+bool TestProviderImmutableCache::RunTest(const FString& Parameters)
+{
+	const FString Url = "test://provider-immutable-cache";
+	const FHash256 Hash = FHash256::From("88df016429689c079f3b2f6ad39fa052532c56795b733da78a91ebe6a713944b");
+
+	FString Answer = "{\"jsonrpc\":\"2.0\",\"id\":1,\"result\":{\"hash\":\"0x" + Hash.ToHex() + "\",\"blockHash\":null}}";
+	int32 Requests = 0;
+	URPCCaller::SetResponder(Url, [&Answer, &Requests](const FString& Content, const TSuccessCallback<FString>& OnSuccess, const FFailureCallback& OnFailure)
+	{
+		Requests++;
+		OnSuccess(Answer);
+	});
+
+	int32 Found = 0;
+	const TFunction<void (TSharedPtr<FJsonObject>)> OnFound = [&Found](const TSharedPtr<FJsonObject> Transaction)
+	{
+		Found++;
+	};
+	const FFailureCallback OnFailure = [](const FSequenceError& Error) {};
+
+	UProvider* Provider = UProvider::Make(Url);
+	Provider->TransactionByHash(Hash, OnFound, OnFailure);
+	Provider->TransactionByHash(Hash, OnFound, OnFailure);
+	const bool bPendingNotCached = Requests == 2 && Found == 2;
+
+	Answer = "{\"jsonrpc\":\"2.0\",\"id\":1,\"result\":{\"hash\":\"0x" + Hash.ToHex() + "\",\"blockHash\":\"0x" + Hash.ToHex() + "\"}}";
+	Provider->TransactionByHash(Hash, OnFound, OnFailure);
+	Provider->TransactionByHash(Hash, OnFound, OnFailure);
+
+	URPCCaller::SetResponder(Url, nullptr);
+	return bPendingNotCached && Requests == 3 && Found == 4;
+}
@@ -0,0 +1,41 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+#include "Misc/AutomationTest.h"
+#include "Provider.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(TestProviderRpcErrors, "Public.TestProviderRpcErrors",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+/*
+* Answers eth_sendRawTransaction with a JSON-RPC error object and checks the error reaches OnFailure
+* as an rpc error, then that a result still reaches OnSuccess
+*/
+bool TestProviderRpcErrors::RunTest(const FString& Parameters)
+{
+	const FString Url = "test://provider-rpc-errors";
+	FString Answer = "{\"jsonrpc\":\"2.0\",\"id\":1,\"error\":{\"code\":-32000,\"message\":\"insufficient funds for gas * price + value\"}}";
+	URPCCaller::SetResponder(Url, [&Answer](const FString& Content, const TSuccessCallback<FString>& OnSuccess, const FFailureCallback& OnFailure)
+	{
+		OnSuccess(Answer);
+	});
+
+	int32 Successes = 0;
+	TArray<FSequenceError> Errors;
+	const TSuccessCallback<FUnsizedData> OnSent = [&Successes](const FUnsizedData& Hash)
+	{
+		Successes++;
+	};
+	const FFailureCallback OnFailure = [&Errors](const FSequenceError& Error)
+	{
+		Errors.Add(Error);
+	};
+
+	UProvider* Provider = UProvider::Make(Url);
+	Provider->SendRawTransaction("0x00", OnSent, OnFailure);
+	const bool bRejected = Successes == 0 && Errors.Num() == 1 && URPCCaller::IsRpcError(Errors[0]) && Errors[0].Message.Contains("insufficient funds");
+
+	Answer = "{\"jsonrpc\":\"2.0\",\"id\":1,\"result\":\"0x88df016429689c079f3b2f6ad39fa052532c56795b733da78a91ebe6a713944b\"}";
+	Provider->SendRawTransaction("0x00", OnSent, OnFailure);
+
+	URPCCaller::SetResponder(Url, nullptr);
+	return bRejected && Successes == 1 && Errors.Num() == 1;
+}
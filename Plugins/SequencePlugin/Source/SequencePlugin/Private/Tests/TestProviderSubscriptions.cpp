@@ -0,0 +1,90 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+#include "Misc/AutomationTest.h"
+#include "ProviderSubscriptions.h"
+#include "RPCCaller.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(TestProviderSubscriptions, "Public.TestProviderSubscriptions",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+/*
+* Drives the subscription protocol through a fake socket: subscribe, notification routing,
+* resubscription after the connection drops and a rejected filter
+*/
+bool TestProviderSubscriptions::RunTest(const FString& Parameters)
+{
+	const TSharedRef<FProviderSubscriptions> Subscriptions = MakeShared<FProviderSubscriptions>("ws://127.0.0.1:8545");
+	TArray<TSharedPtr<FJsonObject>> Sent;
+	Subscriptions->ConnectWith([&Sent](const FString& Frame)
+	{
+		Sent.Add(URPCCaller::Parse(Frame));
+	});
+
+	const auto Respond = [&Subscriptions](const TSharedPtr<FJsonObject>& Request, const FString& Result)
+	{
+		Subscriptions->HandleMessage(FString::Printf(TEXT("{\"jsonrpc\":\"2.0\",\"id\":%d,\"result\":\"%s\"}"), Request->GetIntegerField(TEXT("id")), *Result));
+	};
+
+	TArray<FString> Heads;
+	const int32 HeadsId = Subscriptions->SubscribeNewHeads([&Heads](const TSharedPtr<FJsonValue>& Result)
+	{
+		Heads.Add(Result->AsObject()->GetStringField(TEXT("number")));
+	}, [](const FSequenceError& Error) {});
+
+	if (Sent.Num() != 1 || !Sent[0]->GetStringField(TEXT("method")).Equals("eth_subscribe") || !Sent[0]->GetArrayField(TEXT("params"))[0]->AsString().Equals("newHeads"))
+	{
+		return false;
+	}
+
+	Respond(Sent[0], "0x1");
+	Subscriptions->HandleMessage("{\"jsonrpc\":\"2.0\",\"method\":\"eth_subscription\",\"params\":{\"subscription\":\"0x1\",\"result\":{\"number\":\"0x10\"}}}");
+	Subscriptions->HandleMessage("{\"jsonrpc\":\"2.0\",\"method\":\"eth_subscription\",\"params\":{\"subscription\":\"0x9\",\"result\":{\"number\":\"0x11\"}}}");
+	if (!Subscriptions->IsLive(HeadsId) || Heads.Num() != 1 || !Heads[0].Equals("0x10"))
+	{
+		return false;
+	}
+
+	//the node forgets subscriptions with the connection, they are sent again under the same local id
+	Subscriptions->HandleClosed("test");
+	if (Subscriptions->IsConnected() || Subscriptions->IsLive(HeadsId))
+	{
+		return false;
+	}
+
+	Subscriptions->HandleConnected();
+	if (Sent.Num() != 2 || !Sent[1]->GetStringField(TEXT("method")).Equals("eth_subscribe"))
+	{
+		return false;
+	}
+
+	Respond(Sent[1], "0x2");
+	Subscriptions->HandleMessage("{\"jsonrpc\":\"2.0\",\"method\":\"eth_subscription\",\"params\":{\"subscription\":\"0x2\",\"result\":{\"number\":\"0x12\"}}}");
+	if (Heads.Num() != 2 || !Heads[1].Equals("0x12"))
+	{
+		return false;
+	}
+
+	//filters are serialized with null for wildcard topic positions
+	FLogFilter Filter;
+	Filter.Addresses.Add(FAddress::From("0x0000000000000000000000000000000000000001"));
+	Filter.Topics.Add(TArray<FHash256>());
+	Filter.Topics.Add({ FHash256::From("0x0000000000000000000000000000000000000000000000000000000000000002") });
+	if (!Filter.ToJson().Equals("{\"address\":[\"0x0000000000000000000000000000000000000001\"],\"topics\":[null,[\"0x0000000000000000000000000000000000000000000000000000000000000002\"]]}"))
+	{
+		return false;
+	}
+
+	bool bRejected = false;
+	const int32 LogsId = Subscriptions->SubscribeLogs(Filter, [](const TSharedPtr<FJsonValue>& Result) {}, [&bRejected](const FSequenceError& Error)
+	{
+		bRejected = true;
+	});
+	Subscriptions->HandleMessage(FString::Printf(TEXT("{\"jsonrpc\":\"2.0\",\"id\":%d,\"error\":{\"code\":-32602,\"message\":\"invalid filter\"}}"), Sent.Last()->GetIntegerField(TEXT("id"))));
+	if (!bRejected || Subscriptions->IsLive(LogsId) || !Subscriptions->IsLive(HeadsId))
+	{
+		return false;
+	}
+
+	Subscriptions->Unsubscribe(HeadsId);
+	const bool bUnsubscribed = Sent.Last()->GetStringField(TEXT("method")).Equals("eth_unsubscribe") && Sent.Last()->GetArrayField(TEXT("params"))[0]->AsString().Equals("0x2");
+	return bUnsubscribed && !Subscriptions->IsConnected();
+}
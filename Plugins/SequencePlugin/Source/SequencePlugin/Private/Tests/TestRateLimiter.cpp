@@ -0,0 +1,91 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+#include "Misc/AutomationTest.h"
+#include "Http/RateLimiter.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(TestRateLimiter, "Public.TestRateLimiter",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+/*
+* Drives a limiter on a fake clock through a burst, the background reserve and a 429 with Retry-After
+*/
+bool TestRateLimiter::RunTest(const FString& Parameters)
+{
+	const TSharedRef<double> Clock = MakeShared<double>(100.0);
+	FRateLimiter Limiter;
+	Limiter.SetClock([Clock]() { return *Clock; });
+
+	FRateLimit Limit;
+	Limit.RequestsPerSecond = 2.0f;
+	Limit.Burst = 4.0f;
+	Limit.BackgroundReserve = 0.5f;
+	Limiter.SetDefaultLimit(Limit);
+
+	TArray<FString> Started;
+	const auto Record = [&Started](const FString& Name)
+	{
+		return [&Started, Name](){ Started.Add(Name); };
+	};
+
+	const FString Url = "https://indexer.invalid/rpc/Indexer/GetTokenBalances";
+
+	//background stops once taking a token would dip into the reserve, interactive may use it
+	Limiter.Acquire(Url, "key", ERequestPriority::Background, Record("bg1"));
+	Limiter.Acquire(Url, "key", ERequestPriority::Background, Record("bg2"));
+	Limiter.Acquire(Url, "key", ERequestPriority::Background, Record("bg3"));
+	Limiter.Acquire(Url, "key", ERequestPriority::Interactive, Record("read1"));
+	Limiter.Acquire(Url, "key", ERequestPriority::Interactive, Record("read2"));
+	Limiter.Acquire(Url, "key", ERequestPriority::Interactive, Record("read3"));
+	if (Started != TArray<FString>{ "bg1", "bg2", "read1", "read2" } || Limiter.GetBudget(Url, "key").Queued != 2)
+	{
+		return false;
+	}
+
+	//other access keys have buckets of their own
+	Limiter.Acquire(Url, "other", ERequestPriority::Interactive, Record("other"));
+	if (Started.Last() != "other")
+	{
+		return false;
+	}
+
+	//the first token goes to the interactive read, background needs 3 and waits another 1.5s at 2 per second
+	*Clock += 0.5;
+	Limiter.Update();
+	if (Started.Last() != "read3")
+	{
+		return false;
+	}
+	*Clock += 1.0;
+	Limiter.Update();
+	if (Started.Last() != "read3")
+	{
+		return false;
+	}
+	*Clock += 0.5;
+	Limiter.Update();
+	if (Started.Last() != "bg3")
+	{
+		return false;
+	}
+
+	//a 429 holds everything for its Retry-After, critical included
+	*Clock += 10.0;
+	Limiter.OnThrottled(Url, "key", FRateLimiter::ParseRetryAfter("2", FDateTime::UtcNow()));
+	Limiter.Acquire(Url, "key", ERequestPriority::Critical, Record("intent"));
+	if (Started.Last() != "bg3" || !FMath::IsNearlyEqual(Limiter.GetBudget(Url, "key").RetryAfterSeconds, 2.0f))
+	{
+		return false;
+	}
+
+	*Clock += 2.5;
+	Limiter.Update();
+	if (Started.Last() != "intent" || Limiter.GetBudget(Url, "key").Throttled != 1)
+	{
+		return false;
+	}
+
+	//Retry-After also comes as an HTTP date
+	const FDateTime Now(2024, 10, 21, 7, 28, 0);
+	const TOptional<float> FromDate = FRateLimiter::ParseRetryAfter("Mon, 21 Oct 2024 07:28:30 GMT", Now);
+	return FromDate.IsSet() && FMath::IsNearlyEqual(FromDate.GetValue(), 30.0f)
+		&& !FRateLimiter::ParseRetryAfter("soon", Now).IsSet();
+}
@@ -0,0 +1,59 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+#include "Misc/AutomationTest.h"
+#include "ReceiptWatcher.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(TestReceiptWatcher, "Public.TestReceiptWatcher",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+/*
+* Feeds round results straight into a watcher and checks that watches of one hash complete together
+* and that a receipt lost to a reorg sends a deep watch back to waiting
+*/
+bool TestReceiptWatcher::RunTest(const FString& Parameters)
+{
+	const TSharedRef<FReceiptWatcher> Watcher = FReceiptWatcher::Get("http://127.0.0.1:1/receipt-watcher-test");
+	const FHash256 Shallow = FHash256::From("0x0000000000000000000000000000000000000000000000000000000000000001");
+	const FHash256 Deep = FHash256::From("0x0000000000000000000000000000000000000000000000000000000000000002");
+
+	FTransactionReceipt Receipt{};
+	Receipt.BlockHash = FHash256::From("0x00000000000000000000000000000000000000000000000000000000000000aa");
+	Receipt.BlockNumber = 5;
+
+	int32 Completed = 0;
+	bool bFailed = false;
+	const TSuccessCallback<FTransactionReceipt> OnSuccess = [&Completed](const FTransactionReceipt& Mined)
+	{
+		Completed++;
+	};
+	const FFailureCallback OnFailure = [&bFailed](const FSequenceError& Error)
+	{
+		bFailed = true;
+	};
+
+	Watcher->Watch(Shallow, 1, 0.0f, OnSuccess, OnFailure);
+	Watcher->Watch(Shallow, 1, 0.0f, OnSuccess, OnFailure);
+	const int32 DeepId = Watcher->Watch(Deep, 3, 0.0f, OnSuccess, OnFailure);
+	if (Watcher->Num() != 3)
+	{
+		return false;
+	}
+
+	//one lookup answers every watch of the hash
+	Watcher->HandleReceipt(Shallow, Receipt);
+	if (Completed != 2 || Watcher->Num() != 1)
+	{
+		return false;
+	}
+
+	//without a head the receipt block counts as 1 deep, not enough for 3 confirmations
+	Watcher->HandleReceipt(Deep, Receipt);
+	Watcher->HandlePending(Deep);
+	Watcher->HandleReceipt(Deep, Receipt);
+	if (Completed != 2 || Watcher->Num() != 1 || bFailed)
+	{
+		return false;
+	}
+
+	Watcher->Cancel(DeepId);
+	return Watcher->Num() == 0 && !bFailed;
+}
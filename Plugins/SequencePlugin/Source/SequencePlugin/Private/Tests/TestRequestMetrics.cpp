@@ -0,0 +1,117 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+#include "Misc/AutomationTest.h"
+#include "Http/HttpExecutor.h"
+#include "Http/RequestMetrics.h"
+#include "RPCCaller.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(TestRequestMetrics, "Public.TestRequestMetrics",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+/*
+* Checks histogram percentiles and per endpoint aggregation, that both dump formats carry the endpoint,
+* how rpc and media calls are keyed and that the number of endpoints is capped
+*/
+bool TestRequestMetrics::RunTest(const FString& Parameters)
+{
+	FMetricHistogram Histogram;
+	for (int32 i = 0; i < 90; i++)
+	{
+		Histogram.Add(0.0008);
+	}
+	for (int32 i = 0; i < 10; i++)
+	{
+		Histogram.Add(0.3);
+	}
+
+	//p50 sits in the 1ms bucket, p95 in the 512ms bucket but never above the largest sample
+	if (Histogram.Count != 100 || Histogram.GetPercentile(0.5f) != 0.001 || Histogram.GetPercentile(0.95f) != 0.3 || !FMath::IsNearlyEqual(Histogram.GetMean(), 0.03072))
+	{
+		return false;
+	}
+
+	FRequestMetrics::Reset();
+	FHttpRequestDescriptor Descriptor;
+	Descriptor.Url = "https://polygon-indexer.sequence.app/rpc/Indexer/GetTokenBalances?page=1";
+	Descriptor.Category = ERequestCategory::Indexer;
+
+	FRequestMetrics::Record(Descriptor, nullptr, nullptr, false, 3, 0.002, TOptional<double>(), 1.5);
+	Descriptor.Url = "https://polygon-indexer.sequence.app/rpc/Indexer/GetTokenBalances?page=2";
+	FRequestMetrics::Record(Descriptor, nullptr, nullptr, false, 1, 0.0, 0.05, 0.1);
+
+	const TOptional<FEndpointMetrics> Metrics = FRequestMetrics::GetEndpoint("https://polygon-indexer.sequence.app/rpc/Indexer/GetTokenBalances");
+	if (!Metrics.IsSet() || FRequestMetrics::GetSnapshot().Num() != 1)
+	{
+		return false;
+	}
+
+	const FEndpointMetrics& Endpoint = Metrics.GetValue();
+	if (Endpoint.Calls != 2 || Endpoint.Errors != 2 || Endpoint.Retries != 2 || Endpoint.StatusCodes.FindRef(0) != 2)
+	{
+		return false;
+	}
+
+	if (Endpoint.TotalTime.Count != 2 || Endpoint.TimeToFirstByte.Count != 1 || Endpoint.QueueTime.Max != 0.002)
+	{
+		return false;
+	}
+
+	TArray<FString> Lines;
+	FRequestMetrics::ToCsv().ParseIntoArrayLines(Lines);
+	if (Lines.Num() != 2 || !Lines[0].StartsWith("endpoint,category,calls") || !Lines[1].StartsWith("https://polygon-indexer.sequence.app/rpc/Indexer/GetTokenBalances,Indexer,2,2,2,"))
+	{
+		return false;
+	}
+
+	const TSharedPtr<FJsonObject> Json = URPCCaller::Parse(FRequestMetrics::ToJson());
+	const TArray<TSharedPtr<FJsonValue>>* Endpoints;
+	if (!Json || !Json->TryGetArrayField(TEXT("endpoints"), Endpoints) || Endpoints->Num() != 1)
+	{
+		return false;
+	}
+
+	const TSharedPtr<FJsonObject> First = (*Endpoints)[0]->AsObject();
+	if (First->GetIntegerField(TEXT("calls")) != 2 || First->GetObjectField(TEXT("statusCodes"))->GetIntegerField(TEXT("0")) != 2)
+	{
+		return false;
+	}
+
+	//rpc calls are told apart by method, media by host only
+	FRequestMetrics::Reset();
+	FHttpRequestDescriptor Rpc;
+	Rpc.Url = "https://nodes.sequence.app/polygon";
+	Rpc.Category = ERequestCategory::Rpc;
+	Rpc.Content = "{\"jsonrpc\":\"2.0\",\"id\":1,\"params\":[{\"method\":\"nested\"}],\"method\":\"eth_call\"}";
+	FRequestMetrics::Record(Rpc, nullptr, nullptr, true, 1, 0.0, 0.01, 0.02);
+	Rpc.Content = "{\"jsonrpc\":\"2.0\",\"id\":2,\"method\":\"eth_blockNumber\",\"params\":[]}";
+	FRequestMetrics::Record(Rpc, nullptr, nullptr, true, 1, 0.0, 0.01, 0.02);
+	Rpc.Content = "[{\"jsonrpc\":\"2.0\",\"id\":3,\"method\":\"eth_chainId\",\"params\":[]}]";
+	FRequestMetrics::Record(Rpc, nullptr, nullptr, true, 1, 0.0, 0.01, 0.02);
+
+	FHttpRequestDescriptor Media;
+	Media.Category = ERequestCategory::Media;
+	for (int32 i = 0; i < 3; i++)
+	{
+		Media.Url = FString::Printf(TEXT("https://metadata.sequence.app/tokens/137/0xabc/%d.png"), i);
+		FRequestMetrics::Record(Media, nullptr, nullptr, true, 1, 0.0, 0.01, 0.02);
+	}
+
+	if (FRequestMetrics::GetSnapshot().Num() != 4 || FRequestMetrics::GetEndpointKey(Rpc) != "https://nodes.sequence.app/polygon#batch"
+		|| !FRequestMetrics::GetEndpoint("https://nodes.sequence.app/polygon#eth_call").IsSet()
+		|| FRequestMetrics::GetEndpoint(FRequestMetrics::GetEndpointKey(Media)).Get(FEndpointMetrics()).Calls != 3)
+	{
+		return false;
+	}
+
+	//endpoints beyond the cap share one entry
+	FRequestMetrics::Reset();
+	for (int32 i = 0; i < FRequestMetrics::MaxEndpoints + 10; i++)
+	{
+		Descriptor.Url = FString::Printf(TEXT("https://api.example.com/items/%d"), i);
+		FRequestMetrics::Record(Descriptor, nullptr, nullptr, true, 1, 0.0, 0.01, 0.02);
+	}
+	const bool bCapped = FRequestMetrics::GetSnapshot().Num() == FRequestMetrics::MaxEndpoints + 1
+		&& FRequestMetrics::GetEndpoint(FRequestMetrics::OverflowEndpoint).Get(FEndpointMetrics()).Calls == 10;
+
+	FRequestMetrics::Reset();
+	return bCapped;
+}
@@ -0,0 +1,80 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+#include "Misc/AutomationTest.h"
+#include "Http/RequestPolicy.h"
+#include "Http/HttpExecutor.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(TestRequestPolicy, "Public.TestRequestPolicy",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool TestRequestPolicy::RunTest(const FString& Parameters)
+{
+	FRequestPolicy Policy;
+	Policy.BaseBackoffSeconds = 0.5f;
+	Policy.MaxBackoffSeconds = 3.0f;
+	Policy.JitterFraction = 0.5f;
+
+	//exponential growth without jitter, capped at the max
+	if (!FMath::IsNearlyEqual(Policy.GetBackoffSeconds(1, 0.0f), 0.5f)
+		|| !FMath::IsNearlyEqual(Policy.GetBackoffSeconds(2, 0.0f), 1.0f)
+		|| !FMath::IsNearlyEqual(Policy.GetBackoffSeconds(3, 0.0f), 2.0f)
+		|| !FMath::IsNearlyEqual(Policy.GetBackoffSeconds(4, 0.0f), 3.0f))
+	{
+		return false;
+	}
+
+	//full jitter removes at most JitterFraction of the backoff
+	if (!FMath::IsNearlyEqual(Policy.GetBackoffSeconds(2, 1.0f), 0.5f))
+	{
+		return false;
+	}
+
+	//fixed hedge delay wins over p95, p95 wins over the fallback
+	Policy.HedgeDelaySeconds = 0.0f;
+	if (!FMath::IsNearlyEqual(Policy.GetHedgeDelaySeconds(TOptional<float>()), Policy.FallbackHedgeDelaySeconds)
+		|| !FMath::IsNearlyEqual(Policy.GetHedgeDelaySeconds(0.3f), 0.3f))
+	{
+		return false;
+	}
+	Policy.HedgeDelaySeconds = 0.2f;
+	if (!FMath::IsNearlyEqual(Policy.GetHedgeDelaySeconds(0.3f), 0.2f))
+	{
+		return false;
+	}
+
+	//longest matching prefix wins
+	FRequestPolicy Host;
+	Host.MaxAttempts = 2;
+	FRequestPolicy Endpoint;
+	Endpoint.MaxAttempts = 5;
+	FRequestPolicies::SetPolicy("https://test-host.invalid", Host);
+	FRequestPolicies::SetPolicy("https://test-host.invalid/rpc/Indexer/GetTokenBalances", Endpoint);
+
+	const bool bPrefixOk = FRequestPolicies::GetPolicy("https://test-host.invalid/rpc/Indexer/Ping").MaxAttempts == 2
+		&& FRequestPolicies::GetPolicy("https://test-host.invalid/rpc/Indexer/GetTokenBalances").MaxAttempts == 5
+		&& FRequestPolicies::GetPolicy("https://other-host.invalid").MaxAttempts == FRequestPolicies::GetDefaultPolicy().MaxAttempts;
+
+	FRequestPolicies::ClearPolicy("https://test-host.invalid");
+	FRequestPolicies::ClearPolicy("https://test-host.invalid/rpc/Indexer/GetTokenBalances");
+
+	if (!bPrefixOk)
+	{
+		return false;
+	}
+
+	//p95 needs enough samples before it is trusted
+	const FString LatencyUrl = "https://latency-host.invalid/rpc";
+	FHttpExecutor::RecordLatency(LatencyUrl, 1.0f);
+	if (FHttpExecutor::GetLatencyPercentile(LatencyUrl, 0.95f).IsSet())
+	{
+		return false;
+	}
+
+	for (int32 i = 1; i < 20; i++)
+	{
+		FHttpExecutor::RecordLatency(LatencyUrl + "?attempt=" + FString::FromInt(i), i < 19 ? 0.1f : 2.0f);
+	}
+
+	const TOptional<float> P95 = FHttpExecutor::GetLatencyPercentile(LatencyUrl, 0.95f);
+	FHttpExecutor::ResetLatency();
+	return P95.IsSet() && FMath::IsNearlyEqual(P95.GetValue(), 1.0f);
+}
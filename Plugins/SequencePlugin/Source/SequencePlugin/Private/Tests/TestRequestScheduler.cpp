@@ -0,0 +1,68 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+#include "Misc/AutomationTest.h"
+#include "Http/RequestScheduler.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(TestRequestScheduler, "Public.TestRequestScheduler",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool TestRequestScheduler::RunTest(const FString& Parameters)
+{
+	FRequestScheduler Scheduler;
+	Scheduler.SetGlobalLimit(3);
+	Scheduler.SetReservedCriticalSlots(1);
+	Scheduler.SetBackgroundLimit(1);
+	Scheduler.SetHostLimit(2);
+
+	TArray<FString> Started;
+	const auto Record = [&Started](const FString& Name)
+	{
+		return [&Started, Name](){ Started.Add(Name); };
+	};
+
+	Scheduler.Enqueue("https://images.invalid/1.png", ERequestPriority::Background, Record("img1"));
+	Scheduler.Enqueue("https://images.invalid/2.png", ERequestPriority::Background, Record("img2"));
+	Scheduler.Enqueue("https://api.invalid/read1", ERequestPriority::Interactive, Record("read1"));
+	Scheduler.Enqueue("https://api.invalid/read2", ERequestPriority::Interactive, Record("read2"));
+
+	//background is capped at one, interactive stops short of the slot reserved for critical traffic
+	if (Started.Num() != 2 || Started[0] != "img1" || Started[1] != "read1")
+	{
+		return false;
+	}
+
+	//the reserved slot lets a critical intent through immediately
+	Scheduler.Enqueue("https://waas.invalid/intent", ERequestPriority::Critical, Record("intent"));
+	if (Started.Num() != 3 || Started[2] != "intent" || Scheduler.GetInFlight() != 3)
+	{
+		return false;
+	}
+
+	//a freed slot goes to the highest priority lane waiting
+	Scheduler.Release("https://waas.invalid/intent", ERequestPriority::Critical);
+	Scheduler.Release("https://images.invalid/1.png", ERequestPriority::Background);
+	if (Started.Num() != 4 || Started[3] != "read2" || Scheduler.GetQueued(ERequestPriority::Background) != 1)
+	{
+		return false;
+	}
+
+	//hosts within a lane are served round robin
+	FRequestScheduler Fair;
+	Fair.SetGlobalLimit(1);
+	Fair.SetReservedCriticalSlots(0);
+	TArray<FString> Order;
+	const auto RecordFair = [&Order](const FString& Name)
+	{
+		return [&Order, Name](){ Order.Add(Name); };
+	};
+
+	Fair.Enqueue("https://a.invalid/0", ERequestPriority::Interactive, RecordFair("a0"));
+	Fair.Enqueue("https://a.invalid/1", ERequestPriority::Interactive, RecordFair("a1"));
+	Fair.Enqueue("https://a.invalid/2", ERequestPriority::Interactive, RecordFair("a2"));
+	Fair.Enqueue("https://b.invalid/0", ERequestPriority::Interactive, RecordFair("b0"));
+	for (const FString& Finished : {"https://a.invalid/0", "https://a.invalid/1", "https://b.invalid/0", "https://a.invalid/2"})
+	{
+		Fair.Release(Finished, ERequestPriority::Interactive);
+	}
+
+	return Order == TArray<FString>({"a0", "a1", "b0", "a2"});
+}
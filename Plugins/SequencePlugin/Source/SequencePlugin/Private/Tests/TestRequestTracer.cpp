@@ -0,0 +1,80 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+#include "Misc/AutomationTest.h"
+#include "Http/HttpExecutor.h"
+#include "Http/RequestTracer.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(TestRequestTracer, "Public.TestRequestTracer",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+/*
+* Feeds completed calls straight into the tracer and checks sampling, ring wrap around, url truncation and sinks
+*/
+bool TestRequestTracer::RunTest(const FString& Parameters)
+{
+	FRequestTracer::Reset();
+
+	FHttpRequestDescriptor Descriptor;
+	Descriptor.Url = "https://polygon-indexer.sequence.app/rpc/Indexer/GetTokenBalances";
+	Descriptor.Category = ERequestCategory::Indexer;
+	const double Start = FPlatformTime::Seconds();
+
+	//no sinks, records still land in the ring
+	FRequestTracer::Trace(Descriptor, nullptr, nullptr, false, 2, Start, 0.01f);
+	TArray<FRequestTraceRecord> Records;
+	FRequestTracer::GetRecent(Records);
+	if (FRequestTracer::HasSinks() || Records.Num() != 1 || Records[0].Attempts != 2 || Records[0].bSucceeded || Records[0].Category != ERequestCategory::Indexer)
+	{
+		return false;
+	}
+
+	if (!Records[0].GetUrl().Equals(Descriptor.Url) || !Records[0].GetVerb().Equals("POST"))
+	{
+		return false;
+	}
+
+	//a category sampled at 0 is skipped entirely, other categories are unaffected
+	FRequestTracer::SetSampleRate(ERequestCategory::Indexer, 0.0f);
+	int32 SinkCalls = 0;
+	const int32 Handle = FRequestTracer::AddSink([&SinkCalls](const FRequestTraceEvent& Event)
+	{
+		SinkCalls++;
+	});
+	FRequestTracer::Trace(Descriptor, nullptr, nullptr, true, 1, Start, 0.0f);
+	Descriptor.Category = ERequestCategory::Rpc;
+	FRequestTracer::Trace(Descriptor, nullptr, nullptr, true, 1, Start, 0.0f);
+	FRequestTracer::GetRecent(Records);
+	if (SinkCalls != 1 || Records.Num() != 2 || Records[0].Category != ERequestCategory::Rpc)
+	{
+		return false;
+	}
+
+	FRequestTracer::RemoveSink(Handle);
+	if (FRequestTracer::HasSinks())
+	{
+		return false;
+	}
+
+	//the ring keeps the newest Capacity records, newest first
+	Descriptor.Url = "https://example.invalid/" + FString::ChrN(400, TEXT('a'));
+	for (int32 i = 0; i < FRequestTracer::Capacity + 10; i++)
+	{
+		FRequestTracer::Trace(Descriptor, nullptr, nullptr, true, i, Start, 0.0f);
+	}
+	FRequestTracer::GetRecent(Records);
+	if (Records.Num() != FRequestTracer::Capacity || Records[0].Attempts != FRequestTracer::Capacity + 9 || Records.Last().Attempts != 10)
+	{
+		return false;
+	}
+
+	if (Records[0].GetUrl().Len() != FRequestTraceRecord::MaxUrlLength - 1 || Records[0].Id <= Records[1].Id)
+	{
+		return false;
+	}
+
+	FRequestTracer::GetRecent(Records, 5);
+	const bool bLimited = Records.Num() == 5;
+
+	FRequestTracer::Reset();
+	FRequestTracer::SetLogSinkEnabled(WITH_EDITOR);
+	return bLimited;
+}
@@ -0,0 +1,66 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+#include "Misc/AutomationTest.h"
+#include "Util/ResponseCache.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(TestResponseCache, "Public.TestResponseCache",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool TestResponseCache::RunTest(const FString& Parameters)
+{
+	const FString Value = FString::ChrN(100, 'a');
+	FResponseCache Probe(MAX_int64);
+	Probe.Add("k0", Value);
+	const int64 EntrySize = Probe.GetSizeInBytes();
+
+	//room for exactly three entries
+	FResponseCache Cache(EntrySize * 3);
+	Cache.Add("k1", Value);
+	Cache.Add("k2", Value);
+	Cache.Add("k3", Value);
+
+	if (Cache.Num() != 3 || Cache.GetSizeInBytes() != EntrySize * 3)
+	{
+		return false;
+	}
+
+	//touch k1 so k2 becomes the least recently used
+	if (!Cache.Find("k1").IsSet())
+	{
+		return false;
+	}
+
+	TArray<FString> Evicted;
+	Cache.SetOnEvicted([&Evicted](const FString& Key)
+	{
+		Evicted.Add(Key);
+	});
+
+	Cache.Add("k4", Value);
+	if (Cache.Find("k2").IsSet() || !Cache.Find("k1").IsSet() || !Cache.Find("k4").IsSet() || Cache.Num() != 3
+		|| Evicted.Num() != 1 || Evicted[0] != "k2")
+	{
+		return false;
+	}
+
+	//replacing a key must not double count it
+	Cache.Add("k4", Value);
+	if (Cache.GetSizeInBytes() != EntrySize * 3)
+	{
+		return false;
+	}
+
+	//values bigger than the whole budget are never cached
+	if (Cache.Add("huge", FString::ChrN(1000, 'b')) || Cache.Find("huge").IsSet())
+	{
+		return false;
+	}
+
+	Cache.SetMaxBytes(EntrySize);
+	if (Cache.Num() != 1 || Evicted.Num() != 3)
+	{
+		return false;
+	}
+
+	Cache.Clear();
+	return Cache.Num() == 0 && Cache.GetSizeInBytes() == 0;
+}
@@ -0,0 +1,97 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+#include "Misc/AutomationTest.h"
+#include "Provider.h"
+#include "RpcExtractors.h"
+#include "UObject/UObjectArray.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(TestRpcExtractorBenchmark, "Public.TestRpcExtractorBenchmark",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+/*
+* Checks the typed extractors against canned responses, then times them against the old
+* Make(Url)->Extract* pattern and reports time per response and UObjects created by both
+*/
+bool TestRpcExtractorBenchmark::RunTest(const FString& Parameters)
+{
+	const FString UIntResponse = "{\"jsonrpc\":\"2.0\",\"id\":1,\"result\":\"0x10d4f\"}";
+	const FString DataResponse = "{\"jsonrpc\":\"2.0\",\"id\":1,\"result\":\"0x0000000000000000000000000000000000000000000000000de0b6b3a7640000\"}";
+	const FString HashResponse = "{\"jsonrpc\":\"2.0\",\"id\":1,\"result\":\"0x88df016429689c079f3b2f6ad39fa052532c56795b733da78a91ebe6a713944b\"}";
+	const FString NullResponse = "{\"jsonrpc\":\"2.0\",\"id\":1,\"result\":null}";
+	const FString ErrorResponse = "{\"jsonrpc\":\"2.0\",\"id\":1,\"error\":{\"code\":-32000,\"message\":\"execution reverted\"}}";
+
+	//correctness
+	const TResult<uint64> UInt = TRpcExtractor<uint64>::FromResponse(UIntResponse);
+	const TResult<FUnsizedData> Data = TRpcExtractor<FUnsizedData>::FromResponse(DataResponse);
+	const TResult<FHash256> Hash = TRpcExtractor<FHash256>::FromResponse(HashResponse);
+	if (!UInt.HasValue() || UInt.GetValue() != 0x10d4f || !Data.HasValue() || Data.GetValue().GetLength() != 32 || !Hash.HasValue())
+	{
+		return false;
+	}
+
+	if (!Hash.GetValue().ToHex().Equals("88df016429689c079f3b2f6ad39fa052532c56795b733da78a91ebe6a713944b", ESearchCase::IgnoreCase))
+	{
+		return false;
+	}
+
+	const TResult<FTransactionReceipt> Pending = TRpcExtractor<FTransactionReceipt>::FromResponse(NullResponse);
+	const TResult<TSharedPtr<FJsonObject>> NullObject = TRpcExtractor<TSharedPtr<FJsonObject>>::FromResponse(NullResponse);
+	const TResult<FHash256> BadHash = TRpcExtractor<FHash256>::FromResponse(UIntResponse);
+	if (!Pending.HasError() || Pending.GetError().Type != EmptyResponse || !NullObject.HasError() || !BadHash.HasError())
+	{
+		return false;
+	}
+
+	//the streaming read only takes the top level result and reports errors like the DOM path
+	const TResult<uint64> Nested = TRpcExtractor<uint64>::FromResponse("{\"meta\":{\"result\":\"0x1\"},\"result\":\"0x2\"}");
+	const TResult<uint64> Error = TRpcExtractor<uint64>::FromResponse(ErrorResponse);
+	if (!Nested.HasValue() || Nested.GetValue() != 2 || !Error.HasError() || Error.GetError().Message != URPCCaller::ExtractUIntResult(ErrorResponse).GetError().Message)
+	{
+		return false;
+	}
+
+	//benchmark
+	constexpr int32 Iterations = 200000;
+	constexpr int32 LegacyIterations = 20000;
+	const FString Url = "https://benchmark.invalid/rpc";
+	const FString Responses[] = { UIntResponse, DataResponse };
+
+	uint64 Checksum = 0;
+	const int32 ObjectsBeforeTyped = GUObjectArray.GetObjectArrayNumMinusAvailable();
+	double Start = FPlatformTime::Seconds();
+	for (int32 i = 0; i < Iterations; i++)
+	{
+		if (i % 2 == 0)
+		{
+			Checksum += TRpcExtractor<uint64>::FromResponse(Responses[0]).GetValue();
+		}
+		else
+		{
+			Checksum += TRpcExtractor<FUnsizedData>::FromResponse(Responses[1]).GetValue().GetLength();
+		}
+	}
+	const double TypedSeconds = FPlatformTime::Seconds() - Start;
+	const int32 TypedObjects = GUObjectArray.GetObjectArrayNumMinusAvailable() - ObjectsBeforeTyped;
+
+	const int32 ObjectsBefore = GUObjectArray.GetObjectArrayNumMinusAvailable();
+	Start = FPlatformTime::Seconds();
+	for (int32 i = 0; i < LegacyIterations; i++)
+	{
+		if (i % 2 == 0)
+		{
+			Checksum += UProvider::Make(Url)->ExtractUIntResult(Responses[0]).GetValue();
+		}
+		else
+		{
+			Checksum += HexStringToBinary(UProvider::Make(Url)->ExtractStringResult(Responses[1]).GetValue()).GetLength();
+		}
+	}
+	const double LegacySeconds = FPlatformTime::Seconds() - Start;
+	const int32 LegacyObjects = GUObjectArray.GetObjectArrayNumMinusAvailable() - ObjectsBefore;
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+	AddInfo(FString::Printf(TEXT("TRpcExtractor: %d responses, %.1f ns/response, %d UObjects"), Iterations, TypedSeconds * 1e9 / Iterations, TypedObjects));
+	AddInfo(FString::Printf(TEXT("Make(Url)->Extract: %d responses, %.1f ns/response, %d UObjects"), LegacyIterations, LegacySeconds * 1e9 / LegacyIterations, LegacyObjects));
+	AddInfo(FString::Printf(TEXT("Checksum %llu"), Checksum));
+
+	return TypedObjects == 0;
+}
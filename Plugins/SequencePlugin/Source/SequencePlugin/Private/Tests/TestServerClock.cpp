@@ -0,0 +1,47 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+#include "Misc/AutomationTest.h"
+#include "ServerClock.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(TestServerClock, "Public.TestServerClock",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+/*
+* Feeds Date headers to an in memory clock and checks the offset is learned, smoothed and reset on a jump
+*/
+bool TestServerClock::RunTest(const FString& Parameters)
+{
+	FServerClock Clock("");
+	if (Clock.HasOffset() || Clock.GetOffsetSeconds() != 0.0)
+	{
+		return false;
+	}
+
+	//a device running 2 minutes behind, the 0.2s round trip is split in the middle
+	const FDateTime SentAt(2024, 10, 21, 7, 26, 0, 0);
+	const FDateTime ReceivedAt(2024, 10, 21, 7, 26, 0, 200);
+	if (!Clock.ObserveDate("Mon, 21 Oct 2024 07:28:00 GMT", SentAt, ReceivedAt)
+		|| !FMath::IsNearlyEqual(Clock.GetOffsetSeconds(), 120.4, 0.001))
+	{
+		return false;
+	}
+
+	//small differences are averaged in, a large one replaces the offset
+	Clock.ObserveOffset(124.4);
+	if (!FMath::IsNearlyEqual(Clock.GetOffsetSeconds(), 121.4, 0.001))
+	{
+		return false;
+	}
+	Clock.ObserveOffset(-3.0);
+	if (!FMath::IsNearlyEqual(Clock.GetOffsetSeconds(), -3.0, 0.001))
+	{
+		return false;
+	}
+
+	if (Clock.ObserveDate("yesterday", SentAt, ReceivedAt))
+	{
+		return false;
+	}
+
+	Clock.Reset();
+	return !Clock.HasOffset();
+}
@@ -0,0 +1,51 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+#include "Misc/AutomationTest.h"
+#include "TransactionHistoryStore.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(TestTransactionHistoryStore, "Public.TestTransactionHistoryStore",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+static FSeqTransaction StoredTransaction(const FString& Hash, const int64 Block)
+{
+	FSeqTransaction Transaction;
+	Transaction.txnHash = Hash;
+	Transaction.blockNumber = Block;
+	return Transaction;
+}
+
+/*
+* Merges overlapping batches into an in memory store and checks ordering, deduplication
+* and that the next sync only asks for the newest stored block onwards
+*/
+bool TestTransactionHistoryStore::RunTest(const FString& Parameters)
+{
+	const TSharedRef<FTransactionHistoryStore> Store = MakeShared<FTransactionHistoryStore>(137, "0xabc", "");
+	if (Store->GetSyncArgs().filter.fromBlock != -1 || Store->GetSyncArgs().filter.accountAddress != "0xabc")
+	{
+		return false;
+	}
+
+	if (Store->Merge({ StoredTransaction("0x01", 10), StoredTransaction("0x03", 30), StoredTransaction("0x02", 20) }) != 3)
+	{
+		return false;
+	}
+	if (Store->GetNewestBlock() != 30 || Store->GetSyncArgs().filter.fromBlock != 30 || Store->GetTransactions()[0].txnHash != "0x03")
+	{
+		return false;
+	}
+
+	//the newest block is fetched again, what is already stored is skipped regardless of hash case
+	if (Store->Merge({ StoredTransaction("0x04", 31), StoredTransaction("0X03", 30), StoredTransaction("0x05", 30) }) != 2)
+	{
+		return false;
+	}
+
+	const TArray<FSeqTransaction>& Transactions = Store->GetTransactions();
+	if (Transactions.Num() != 5 || Transactions[0].txnHash != "0x04" || Transactions[1].txnHash != "0x03" || Transactions[2].txnHash != "0x05" || Transactions[4].txnHash != "0x01")
+	{
+		return false;
+	}
+
+	Store->Clear();
+	return Store->GetTransactions().Num() == 0 && Store->GetNewestBlock() == -1 && Store->Merge({ StoredTransaction("0x01", 10) }) == 1;
+}
@@ -0,0 +1,65 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+#include "Misc/AutomationTest.h"
+#include "TransactionPipeline.h"
+#include "NonceManager.h"
+#include "RPCCaller.h"
+#include "Eth/Crypto.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(TestTransactionPipeline, "Public.TestTransactionPipeline",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+/*
+* Sends through a scripted node that rejects the first transaction and checks the rejection reaches OnFailure
+* and frees the nonce, then that the next send reuses that nonce and succeeds
+*/
+bool TestTransactionPipeline::RunTest(const FString& Parameters)
+{
+	const FString Url = "test://transaction-pipeline";
+	const FString Hash = "88df016429689c079f3b2f6ad39fa052532c56795b733da78a91ebe6a713944b";
+
+	TArray<FString> SendAnswers = {
+		"{\"jsonrpc\":\"2.0\",\"id\":1,\"error\":{\"code\":-32000,\"message\":\"insufficient funds for gas * price + value\"}}",
+		"{\"jsonrpc\":\"2.0\",\"id\":1,\"result\":\"0x" + Hash + "\"}"
+	};
+	int32 Sends = 0;
+	URPCCaller::SetResponder(Url, [&](const FString& Content, const TSuccessCallback<FString>& OnSuccess, const FFailureCallback& OnFailure)
+	{
+		if (Content.Contains("eth_getTransactionCount"))
+		{
+			OnSuccess("{\"jsonrpc\":\"2.0\",\"id\":1,\"result\":\"0x3\"}");
+			return;
+		}
+		OnSuccess(SendAnswers[Sends++]);
+	});
+
+	FTransactionSendRequest Request;
+	Request.PrivateKey = FPrivateKey::From("abc0000000000000000000000000000000000000000000000000000000000002");
+	Request.ChainId = 137;
+	Request.To = FAddress::From("1099542D7dFaF6757527146C0aB9E70A967f71C0");
+	Request.GasPrice = FUnsizedData::From("3b9aca00");
+	Request.GasLimit = FUnsizedData::From("5208");
+	const TSharedRef<FNonceManager> Nonces = FNonceManager::Get(Url, GetAddress(GetPublicKey(Request.PrivateKey)));
+
+	TArray<FTransactionSendResult> Results;
+	TArray<FString> Errors;
+	const TSuccessCallback<FTransactionSendResult> OnSent = [&Results](const FTransactionSendResult& Result)
+	{
+		Results.Add(Result);
+	};
+	const FFailureCallback OnFailure = [&Errors](const FSequenceError& Error)
+	{
+		Errors.Add(Error.Message);
+	};
+
+	FTransactionPipeline::Send(Url, Request, OnSent, OnFailure);
+	if (Sends != 1 || Results.Num() != 0 || Errors.Num() != 1 || !Errors[0].Contains("insufficient funds") || Nonces->NumInFlight() != 0)
+	{
+		URPCCaller::SetResponder(Url, nullptr);
+		return false;
+	}
+
+	FTransactionPipeline::Send(Url, Request, OnSent, OnFailure);
+	URPCCaller::SetResponder(Url, nullptr);
+	return Sends == 2 && Errors.Num() == 1 && Results.Num() == 1 && Results[0].Timings.Attempts == 1
+		&& Results[0].Nonce.ToHex() == FNonceManager::ToBlockNonce(3).ToHex() && Results[0].Hash.ToHex().Equals(Hash, ESearchCase::IgnoreCase);
+}
@@ -0,0 +1,198 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+#include "TransactionHistoryStore.h"
+#include "Kismet/GameplayStatics.h"
+#include "Indexer/Indexer.h"
+#include "StorableTransactionHistory.h"
+#include "Util/Log.h"
+
+static TMap<FString, TSharedRef<FTransactionHistoryStore>>& Stores()
+{
+	static TMap<FString, TSharedRef<FTransactionHistoryStore>> Registry;
+	return Registry;
+}
+
+FTransactionHistoryStore::FTransactionHistoryStore(const int64 ChainIdIn, const FString& AccountAddressIn, const FString& SaveSlotIn)
+	: ChainId(ChainIdIn), AccountAddress(AccountAddressIn), SaveSlot(SaveSlotIn)
+{
+}
+
+TSharedRef<FTransactionHistoryStore> FTransactionHistoryStore::Get(const int64 ChainId, const FString& AccountAddress)
+{
+	const FString Key = FString::Printf(TEXT("SeqTxh_%lld_%s"), ChainId, *AccountAddress.ToLower());
+	if (const TSharedRef<FTransactionHistoryStore>* Store = Stores().Find(Key))
+	{
+		return *Store;
+	}
+
+	const TSharedRef<FTransactionHistoryStore> Store = MakeShared<FTransactionHistoryStore>(ChainId, AccountAddress, Key);
+	Stores().Add(Key, Store);
+	return Store;
+}
+
+const TArray<FSeqTransaction>& FTransactionHistoryStore::GetTransactions()
+{
+	this->Load();
+	return this->Transactions;
+}
+
+int64 FTransactionHistoryStore::GetNewestBlock()
+{
+	this->Load();
+	return this->NewestBlock;
+}
+
+int64 FTransactionHistoryStore::GetSyncedAt()
+{
+	this->Load();
+	return this->SyncedAt;
+}
+
+void FTransactionHistoryStore::Sync(UIndexer* Indexer, const TSuccessCallback<TArray<FSeqTransaction>>& OnSuccess, const FFailureCallback& OnFailure)
+{
+	if (!Indexer)
+	{
+		OnFailure(FSequenceError(RequestFail, "No indexer to sync the transaction history with"));
+		return;
+	}
+
+	this->Load();
+	this->Waiting.Add({ OnSuccess, OnFailure });
+	if (this->bSyncing)
+	{
+		return;
+	}
+	this->bSyncing = true;
+
+	const TSharedRef<FTransactionHistoryStore> Self = this->AsShared();
+	Indexer->IterateTransactionHistory(this->ChainId, this->GetSyncArgs())->ReadAll(0, [Self](const TArray<FSeqTransaction>& Fetched)
+	{
+		const int32 Added = Self->Merge(Fetched);
+		SEQ_LOG(Verbose, TEXT("Synced transaction history of %s on chain %lld, %d new of %d"), *Self->AccountAddress, Self->ChainId, Added, Self->Transactions.Num());
+		Self->SyncedAt = FDateTime::UtcNow().ToUnixTimestamp();
+		Self->Save();
+		Self->FinishSync(TOptional<FSequenceError>());
+	}, [Self](const FSequenceError& Error)
+	{
+		Self->FinishSync(Error);
+	});
+}
+
+FSeqGetTransactionHistoryArgs FTransactionHistoryStore::GetSyncArgs()
+{
+	this->Load();
+	FSeqGetTransactionHistoryArgs Args(this->AccountAddress);
+	Args.includeMetaData = true;
+	if (this->NewestBlock >= 0)
+	{
+		Args.filter.fromBlock = static_cast<int32>(FMath::Min<int64>(this->NewestBlock, MAX_int32));
+	}
+	return Args;
+}
+
+int32 FTransactionHistoryStore::Merge(const TArray<FSeqTransaction>& Fetched)
+{
+	this->Load();
+
+	int32 Added = 0;
+	for (const FSeqTransaction& Transaction : Fetched)
+	{
+		bool bKnown = false;
+		this->KnownHashes.Add(Transaction.txnHash.ToLower(), &bKnown);
+		if (bKnown)
+		{
+			continue;
+		}
+
+		this->Transactions.Add(Transaction);
+		this->NewestBlock = FMath::Max(this->NewestBlock, Transaction.blockNumber);
+		Added++;
+	}
+
+	if (Added > 0)
+	{
+		//new transactions were appended, stable so transactions of the same block keep the indexer's order
+		this->Transactions.StableSort([](const FSeqTransaction& A, const FSeqTransaction& B)
+		{
+			return A.blockNumber > B.blockNumber;
+		});
+	}
+	return Added;
+}
+
+void FTransactionHistoryStore::Clear()
+{
+	this->bLoaded = true;
+	this->Transactions.Reset();
+	this->KnownHashes.Reset();
+	this->NewestBlock = -1;
+	this->SyncedAt = 0;
+	if (!this->SaveSlot.IsEmpty() && UGameplayStatics::DoesSaveGameExist(this->SaveSlot, 0))
+	{
+		UGameplayStatics::DeleteGameInSlot(this->SaveSlot, 0);
+	}
+}
+
+void FTransactionHistoryStore::FinishSync(const TOptional<FSequenceError>& Error)
+{
+	this->bSyncing = false;
+	const TArray<FWaiting> Done = MoveTemp(this->Waiting);
+	this->Waiting.Reset();
+	for (const FWaiting& Entry : Done)
+	{
+		if (Error.IsSet())
+		{
+			Entry.OnFailure(Error.GetValue());
+		}
+		else
+		{
+			Entry.OnSuccess(this->Transactions);
+		}
+	}
+}
+
+void FTransactionHistoryStore::Load()
+{
+	if (this->bLoaded)
+	{
+		return;
+	}
+	this->bLoaded = true;
+
+	if (this->SaveSlot.IsEmpty() || !UGameplayStatics::DoesSaveGameExist(this->SaveSlot, 0))
+	{
+		return;
+	}
+
+	const UStorableTransactionHistory* Stored = Cast<UStorableTransactionHistory>(UGameplayStatics::LoadGameFromSlot(this->SaveSlot, 0));
+	if (!Stored || Stored->ChainId != this->ChainId || !Stored->AccountAddress.Equals(this->AccountAddress, ESearchCase::IgnoreCase))
+	{
+		SEQ_LOG(Warning, TEXT("Ignoring unreadable transaction history in slot %s"), *this->SaveSlot);
+		return;
+	}
+
+	this->Transactions = Stored->Transactions;
+	this->NewestBlock = Stored->NewestBlock;
+	this->SyncedAt = Stored->SyncedAt;
+	for (const FSeqTransaction& Transaction : this->Transactions)
+	{
+		this->KnownHashes.Add(Transaction.txnHash.ToLower());
+	}
+}
+
+void FTransactionHistoryStore::Save()
+{
+	if (this->SaveSlot.IsEmpty())
+	{
+		return;
+	}
+
+	if (UStorableTransactionHistory* Stored = Cast<UStorableTransactionHistory>(UGameplayStatics::CreateSaveGameObject(UStorableTransactionHistory::StaticClass())))
+	{
+		Stored->ChainId = this->ChainId;
+		Stored->AccountAddress = this->AccountAddress;
+		Stored->Transactions = this->Transactions;
+		Stored->NewestBlock = this->NewestBlock;
+		Stored->SyncedAt = this->SyncedAt;
+		UGameplayStatics::AsyncSaveGameToSlot(Stored, this->SaveSlot, 0);
+	}
+}
@@ -0,0 +1,90 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+#pragma once
+#include "CoreMinimal.h"
+#include "Util/Async.h"
+#include "Indexer/Structs/SeqTransaction.h"
+#include "Indexer/Structs/SeqGetTransactionHistoryArgs.h"
+
+class UIndexer;
+
+/**
+ * Keeps the transaction history of one account on one chain on disk. The stored list is served
+ * without a request, Sync only asks the indexer for transactions from the newest block already
+ * stored onwards and merges them in, so opening a long history costs one small request instead
+ * of downloading every page again. There is one store per (chain, account). Game thread only.
+ */
+class SEQUENCEPLUGIN_API FTransactionHistoryStore : public TSharedFromThis<FTransactionHistoryStore>
+{
+	struct FWaiting
+	{
+		TSuccessCallback<TArray<FSeqTransaction>> OnSuccess;
+		FFailureCallback OnFailure;
+	};
+
+	int64 ChainId;
+	FString AccountAddress;
+	FString SaveSlot;
+
+	/* Newest first */
+	TArray<FSeqTransaction> Transactions;
+	TSet<FString> KnownHashes;
+	int64 NewestBlock = -1;
+	int64 SyncedAt = 0;
+	bool bLoaded = false;
+
+	TArray<FWaiting> Waiting;
+	bool bSyncing = false;
+
+	void Load();
+	void Save();
+	void FinishSync(const TOptional<FSequenceError>& Error);
+public:
+	/**
+	 * @param SaveSlotIn Slot the history is persisted in, empty keeps it in memory only
+	 */
+	FTransactionHistoryStore(int64 ChainIdIn, const FString& AccountAddressIn, const FString& SaveSlotIn);
+
+	/**
+	 * Gets the shared store of AccountAddress on ChainId, creating it on first use
+	 */
+	static TSharedRef<FTransactionHistoryStore> Get(int64 ChainId, const FString& AccountAddress);
+
+	/**
+	 * @return the stored history, newest first, as of the last sync
+	 */
+	const TArray<FSeqTransaction>& GetTransactions();
+
+	/**
+	 * @return the highest block number stored, -1 while the store is empty
+	 */
+	int64 GetNewestBlock();
+
+	/**
+	 * @return unix time of the last successful sync, 0 if there was none
+	 */
+	int64 GetSyncedAt();
+
+	/**
+	 * Fetches the transactions the store does not have yet and merges them in.
+	 * Syncs requested while one runs share it.
+	 * @param OnSuccess called with the whole history, newest first
+	 */
+	void Sync(UIndexer* Indexer, const TSuccessCallback<TArray<FSeqTransaction>>& OnSuccess, const FFailureCallback& OnFailure);
+
+	/**
+	 * @return the arguments of the next sync, the history from the newest stored block onwards.
+	 * That block is asked for again as transactions of it may have been indexed after the last sync
+	 */
+	FSeqGetTransactionHistoryArgs GetSyncArgs();
+
+	/**
+	 * Merges fetched transactions in, transactions already stored are skipped
+	 * @return the number of transactions added
+	 */
+	int32 Merge(const TArray<FSeqTransaction>& Fetched);
+
+	/**
+	 * Forgets the stored history and deletes it from disk
+	 */
+	void Clear();
+};
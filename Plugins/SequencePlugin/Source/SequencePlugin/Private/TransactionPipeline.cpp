@@ -0,0 +1,167 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+#include "TransactionPipeline.h"
+#include "Eth/Crypto.h"
+#include "GasOracle.h"
+#include "NonceManager.h"
+#include "Provider.h"
+#include "Types/ContractCall.h"
+#include "Util/Future.h"
+#include "Util/HexUtility.h"
+#include "Util/Log.h"
+
+namespace TransactionPipeline
+{
+	/*
+	* Runs one lookup and records when it came back, relative to the start of the send
+	*/
+	template <typename T>
+	static TSeqFuture<T> Stage(const double StartSeconds, const TSharedRef<FTransactionSendTimings>& Timings, double FTransactionSendTimings::* Field, const TFunction<void (const TSuccessCallback<T>&, const FFailureCallback&)>& Call)
+	{
+		return SeqFuture::FromCallback<T>(Call).Then([StartSeconds, Timings, Field](const T& Value)
+		{
+			(*Timings).*Field = FPlatformTime::Seconds() - StartSeconds;
+			return Value;
+		});
+	}
+
+	static TSeqFuture<FUnsizedData> EstimateGas(const FString& Url, const FAddress& From, const FTransactionSendRequest& Request)
+	{
+		if (!Request.To.IsSet())
+		{
+			return SeqFuture::FromCallback<FUnsizedData>([Url, From, Request](const TSuccessCallback<FUnsizedData>& OnSuccess, const FFailureCallback& OnFailure)
+			{
+				UProvider::Make(Url)->EstimateDeploymentGas(From, "0x" + Request.Data.ToHex(), OnSuccess, OnFailure);
+			});
+		}
+
+		FContractCall Call;
+		Call.From = From;
+		Call.To = Request.To.GetValue();
+		if (Request.Value.GetLength() > 0)
+		{
+			Call.Value = HexStringToUint64(Request.Value.ToHex());
+		}
+		if (Request.Data.GetLength() > 0)
+		{
+			Call.Data = Request.Data.ToHex();
+		}
+
+		return SeqFuture::FromCallback<FUnsizedData>([Url, Call](const TSuccessCallback<FUnsizedData>& OnSuccess, const FFailureCallback& OnFailure)
+		{
+			UProvider::Make(Url)->EstimateContractCallGas(Call, OnSuccess, OnFailure);
+		});
+	}
+}
+
+void FTransactionPipeline::Send(const FString& Url, const FTransactionSendRequest& Request, const TSuccessCallback<FTransactionSendResult>& OnSuccess, const FFailureCallback& OnFailure)
+{
+	const double StartSeconds = FPlatformTime::Seconds();
+	const FAddress From = GetAddress(GetPublicKey(Request.PrivateKey));
+	const TSharedRef<FNonceManager> Nonces = FNonceManager::Get(Url, From);
+	const TSharedRef<FTransactionSendTimings> Timings = MakeShared<FTransactionSendTimings>();
+
+	const TSeqFuture<bool> NonceReady = TransactionPipeline::Stage<bool>(StartSeconds, Timings, &FTransactionSendTimings::NonceSeconds, [Nonces](const TSuccessCallback<bool>& OnReady, const FFailureCallback& OnStageFailure)
+	{
+		Nonces->Prepare([OnReady]()
+		{
+			OnReady(true);
+		}, OnStageFailure);
+	});
+
+	const TSeqFuture<FUnsizedData> GasPrice = Request.GasPrice.IsSet()
+		? SeqFuture::MakeReady(Request.GasPrice.GetValue())
+		: TransactionPipeline::Stage<FUnsizedData>(StartSeconds, Timings, &FTransactionSendTimings::GasPriceSeconds, [Url](const TSuccessCallback<FUnsizedData>& OnStageSuccess, const FFailureCallback& OnStageFailure)
+		{
+			FGasOracle::Get(Url)->GetGasPrice(OnStageSuccess, OnStageFailure);
+		});
+
+	const TSeqFuture<FUnsizedData> GasLimit = Request.GasLimit.IsSet()
+		? SeqFuture::MakeReady(Request.GasLimit.GetValue())
+		: TransactionPipeline::Stage<FUnsizedData>(StartSeconds, Timings, &FTransactionSendTimings::GasLimitSeconds, [Url, From, Request](const TSuccessCallback<FUnsizedData>& OnStageSuccess, const FFailureCallback& OnStageFailure)
+		{
+			TransactionPipeline::EstimateGas(Url, From, Request).Then(OnStageSuccess, OnStageFailure);
+		});
+
+	SeqFuture::WhenAll(NonceReady, GasPrice, GasLimit).Then([Url, Request, From, Nonces, Timings, StartSeconds, OnSuccess, OnFailure](const TTuple<bool, FUnsizedData, FUnsizedData>& Ready)
+	{
+		Timings->PrepareSeconds = FPlatformTime::Seconds() - StartSeconds;
+
+		const FUnsizedData Price = Ready.Get<1>();
+		const FUnsizedData Limit = Ready.Get<2>();
+		const FAddress To = Request.To.Get(FAddress::From(""));
+		SendWithManagedNonce(Url, Nonces, [Price, Limit, To, Request](const FBlockNonce& Nonce)
+		{
+			return FEthTransaction{Nonce, Price, Limit, To, Request.Value, Request.Data};
+		}, Request.PrivateKey, Request.ChainId, true, Timings, [Request, From, Timings, StartSeconds, OnSuccess](const FBlockNonce& Nonce, const FUnsizedData& Hash)
+		{
+			Timings->TotalSeconds = FPlatformTime::Seconds() - StartSeconds;
+			SEQ_LOG(Verbose, TEXT("Sent 0x%s in %.0fms: prepare %.0fms (nonce %.0fms, gas price %.0fms, gas limit %.0fms), sign %.0fms, submit %.0fms"),
+				*Hash.ToHex(), Timings->TotalSeconds * 1000.0, Timings->PrepareSeconds * 1000.0, Timings->NonceSeconds * 1000.0,
+				Timings->GasPriceSeconds * 1000.0, Timings->GasLimitSeconds * 1000.0, Timings->SignSeconds * 1000.0, Timings->SubmitSeconds * 1000.0);
+
+			FTransactionSendResult Result;
+			Result.From = From;
+			Result.Nonce = Nonce;
+			Result.Hash = Hash;
+			if (!Request.To.IsSet())
+			{
+				Result.ContractAddress = GetContractAddress(From, Nonce);
+			}
+			Result.Timings = *Timings;
+			OnSuccess(Result);
+		}, OnFailure);
+	}, OnFailure);
+}
+
+void FTransactionPipeline::SendWithManagedNonce(const FString& Url, const TSharedRef<FNonceManager>& Nonces, const TFunction<FEthTransaction (const FBlockNonce&)>& Build, const FPrivateKey& PrivateKey, const int64 ChainId, const bool bRetryStaleNonce, const TSharedPtr<FTransactionSendTimings>& Timings, const TSuccessCallbackTuple<FBlockNonce, FUnsizedData>& OnSuccess, const FFailureCallback& OnFailure)
+{
+	const double SignStartSeconds = FPlatformTime::Seconds();
+	Nonces->Acquire([=](const uint64 Nonce)
+	{
+		const FBlockNonce BlockNonce = FNonceManager::ToBlockNonce(Nonce);
+		FEthTransaction Transaction = Build(BlockNonce);
+		const FUnsizedData SignedTransaction = Transaction.GetSignedTransaction(PrivateKey, ChainId);
+
+		const double SubmitStartSeconds = FPlatformTime::Seconds();
+		if (Timings)
+		{
+			Timings->SignSeconds = SubmitStartSeconds - SignStartSeconds;
+			Timings->Attempts++;
+		}
+
+		UProvider::Make(Url)->SendRawTransaction("0x" + SignedTransaction.ToHex(), [=](const FUnsizedData& Hash)
+		{
+			if (Timings)
+			{
+				Timings->SubmitSeconds = FPlatformTime::Seconds() - SubmitStartSeconds;
+			}
+			Nonces->Confirm(Nonce);
+			OnSuccess(BlockNonce, Hash);
+		}, [=](const FSequenceError& Error)
+		{
+			//without an answer from the node the transaction may still have reached the pool
+			if (!URPCCaller::IsRpcError(Error))
+			{
+				Nonces->Unresolved(Nonce);
+				OnFailure(Error);
+				return;
+			}
+
+			if (!FNonceManager::IsNonceTooLow(Error))
+			{
+				Nonces->Release(Nonce);
+				OnFailure(Error);
+				return;
+			}
+
+			Nonces->Confirm(Nonce);
+			Nonces->Resync();
+			if (!bRetryStaleNonce)
+			{
+				OnFailure(Error);
+				return;
+			}
+			SendWithManagedNonce(Url, Nonces, Build, PrivateKey, ChainId, false, Timings, OnSuccess, OnFailure);
+		});
+	}, OnFailure);
+}
@@ -0,0 +1,83 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+#pragma once
+#include "CoreMinimal.h"
+#include "Types/BinaryData.h"
+#include "Eth/EthTransaction.h"
+#include "Util/Async.h"
+
+class FNonceManager;
+
+/**
+ * A transaction to sign and send, anything left unset is looked up by the pipeline
+ */
+struct SEQUENCEPLUGIN_API FTransactionSendRequest
+{
+	FPrivateKey PrivateKey;
+	int64 ChainId = 0;
+
+	/* Unset deploys Data as contract code */
+	TOptional<FAddress> To;
+	FUnsizedData Value = FUnsizedData::Empty();
+	FUnsizedData Data = FUnsizedData::Empty();
+
+	/* Taken from the chain's FGasOracle when unset */
+	TOptional<FUnsizedData> GasPrice;
+
+	/* Estimated with eth_estimateGas when unset */
+	TOptional<FUnsizedData> GasLimit;
+};
+
+/**
+ * Time spent in each stage of a send, in seconds
+ */
+struct SEQUENCEPLUGIN_API FTransactionSendTimings
+{
+	/* Stages run side by side, each measured from the start of the send */
+	double NonceSeconds = 0.0;
+	double GasPriceSeconds = 0.0;
+	double GasLimitSeconds = 0.0;
+
+	/* Until the slowest of the three stages above was done */
+	double PrepareSeconds = 0.0;
+
+	/* Nonce acquisition and signing of the last attempt */
+	double SignSeconds = 0.0;
+
+	/* eth_sendRawTransaction of the last attempt */
+	double SubmitSeconds = 0.0;
+	double TotalSeconds = 0.0;
+	int32 Attempts = 0;
+};
+
+struct SEQUENCEPLUGIN_API FTransactionSendResult
+{
+	FAddress From;
+	FBlockNonce Nonce;
+	FUnsizedData Hash = FUnsizedData::Empty();
+
+	/* Set for deployments */
+	TOptional<FAddress> ContractAddress;
+	FTransactionSendTimings Timings;
+};
+
+/**
+ * Builds, signs and sends transactions with the independent lookups overlapped:
+ * the signer's nonce manager is seeded, the gas price read from the gas oracle and the gas limit
+ * estimated all at once, and the transaction is signed the moment the slowest of them is back.
+ * With a warm nonce manager and gas oracle a send costs the estimate plus the submission.
+ * The nonce itself is only reserved right before signing so a failed lookup never leaves a gap.
+ */
+class SEQUENCEPLUGIN_API FTransactionPipeline
+{
+public:
+	static void Send(const FString& Url, const FTransactionSendRequest& Request, const TSuccessCallback<FTransactionSendResult>& OnSuccess, const FFailureCallback& OnFailure);
+
+	/**
+	 * Signs the transaction Build makes around a managed nonce and sends it.
+	 * A nonce the node reports as used belongs to a transaction we did not track, so the manager is resynced
+	 * and, with bRetryStaleNonce, the send retried once. Other rejections by the node release the nonce, a send that
+	 * failed without an answer keeps it in flight until the next pending count tells whether it reached the pool.
+	 * @param Timings Sign and submit times of the attempt are written here if set
+	 */
+	static void SendWithManagedNonce(const FString& Url, const TSharedRef<FNonceManager>& Nonces, const TFunction<FEthTransaction (const FBlockNonce&)>& Build, const FPrivateKey& PrivateKey, const int64 ChainId, const bool bRetryStaleNonce, const TSharedPtr<FTransactionSendTimings>& Timings, const TSuccessCallbackTuple<FBlockNonce, FUnsizedData>& OnSuccess, const FFailureCallback& OnFailure);
+};
@@ -264,13 +264,16 @@ FUnsizedData StringToUTF8(FString String)
 
 FString UTF8ToString(FUnsizedData BinaryData)
 {
-	TArray<uint8> Buffer;
-	for(uint32 i = 0; i < BinaryData.GetLength(); i++)
-	{
-		Buffer.Add(BinaryData.Arr.Get()->GetData()[i]);
-	}
-	Buffer.Add('\0');
-	return reinterpret_cast<const char*>(Buffer.GetData());
+	//the data is read as a C string, so it ends at the first null byte
+	const TConstArrayView<uint8> Bytes(BinaryData.Ptr(), BinaryData.GetLength());
+	const int32 Terminator = Bytes.Find(0);
+	return UTF8BytesToString(Terminator == INDEX_NONE ? Bytes : Bytes.Left(Terminator));
+}
+
+FString UTF8BytesToString(const TConstArrayView<uint8> Bytes)
+{
+	const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Bytes.GetData()), Bytes.Num());
+	return FString(Converted.Length(), Converted.Get());
 }
 
 FUnsizedData HexStringToBinary(const FString Hex)
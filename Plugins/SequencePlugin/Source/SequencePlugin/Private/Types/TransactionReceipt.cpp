@@ -1,24 +1,24 @@
 // Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
 #include "Types/TransactionReceipt.h"
+#include "Util/HexUtility.h"
 
 FTransactionReceipt JsonToTransactionReceipt(TSharedPtr<FJsonObject> Json)
 {
-	uint64 BlockNumber;
-	uint64 TransactionIndex;
-	uint64 CumulativeGasUsed;
-	uint64 GasUsed;
 	FString ToAddress;
+	FString ContractAddressHex;
 	FAddress To = FAddress::From("");
-	bool bIsValid = Json->TryGetNumberField(TEXT("blockNumber"), BlockNumber);
-	bIsValid = Json->TryGetNumberField(TEXT("TransactionIndex"), TransactionIndex);
-	bIsValid = Json->TryGetNumberField(TEXT("CumulativeGasUsed"), CumulativeGasUsed);
-	bIsValid = Json->TryGetNumberField(TEXT("GasUsed"), GasUsed);
+	//quantities are hex strings
+	const uint64 BlockNumber = HexStringToUint64(Json->GetStringField(TEXT("blockNumber"))).Get(0);
+	const uint64 TransactionIndex = HexStringToUint64(Json->GetStringField(TEXT("transactionIndex"))).Get(0);
+	const uint64 CumulativeGasUsed = HexStringToUint64(Json->GetStringField(TEXT("cumulativeGasUsed"))).Get(0);
+	const uint64 GasUsed = HexStringToUint64(Json->GetStringField(TEXT("gasUsed"))).Get(0);
 	bool bIsContract = !(Json->TryGetStringField(TEXT("to"), ToAddress));
 	if(!bIsContract) To = FAddress::From(ToAddress);
 	FHash256 BlockHash = FHash256::From(Json->GetStringField(TEXT("blockHash")));
 	FHash256 TransactionHash = FHash256::From(Json->GetStringField(TEXT("transactionHash")));
 	FAddress From = FAddress::From(Json->GetStringField(TEXT("from")));
-	FAddress ContractAddress = FAddress::From(Json->GetStringField(TEXT("ContractAddress")));
+	Json->TryGetStringField(TEXT("contractAddress"), ContractAddressHex);
+	FAddress ContractAddress = FAddress::From(ContractAddressHex);
 	FString Status = Json->GetStringField(TEXT("status"));
 	return FTransactionReceipt{
 		BlockHash, BlockNumber, TransactionHash, TransactionIndex, From, To, CumulativeGasUsed, GasUsed, ContractAddress, Status
@@ -4,6 +4,7 @@
 #pragma warning(disable: 4104)
 #include "Util/HexUtility.h"
 #include "Types/BinaryData.h"
+#include "Util/Log.h"
 
 FString RandomHexCharacter()
 {
@@ -245,6 +246,11 @@ TOptional<uint64> HexStringToUint64(FString Hex)
 	return Sum;
 }
 
+void LogHexTooLong(const FString& Hex, const int32 Size)
+{
+	SEQ_LOG(Warning, TEXT("Hex value 0x%s is longer than %d bytes, dropping its leading %d characters"), *Hex, Size, Hex.Len() - Size * 2);
+}
+
 TArray<uint8> HexToBytesInline(FString in)
 {
 	in.RemoveFromStart("0x");
@@ -47,10 +47,30 @@ uint8 SEQUENCEPLUGIN_API RandomByte();
 */
 TArray<uint8> SEQUENCEPLUGIN_API HexToBytesInline(FString in);
 
+/*
+* Warns that Hex (without 0x) is longer than Size bytes, kept out of line so the header does not pull in logging
+*/
+void SEQUENCEPLUGIN_API LogHexTooLong(const FString& Hex, int32 Size);
+
 template<ByteLength TSize>
 TStaticArray<uint8, TSize> SEQUENCEPLUGIN_API HexToBytesInline(FString in)
 {
-	TStaticArray<uint8, TSize> Arr;
+	in.RemoveFromStart("0x");
+
+	//anything longer than the array would be written past its end, keep the low order bytes but say so
+	if (in.Len() > TSize * 2)
+	{
+		LogHexTooLong(in, static_cast<int32>(TSize));
+		in = in.Right(TSize * 2);
+	}
+
+	//shorter values are quantities such as nonces, right aligned like a big endian integer
+	if (in.Len() < TSize * 2)
+	{
+		in = FString::ChrN(TSize * 2 - in.Len(), TEXT('0')) + in;
+	}
+
+	TStaticArray<uint8, TSize> Arr(InPlace, 0);
 	HexToBytes(in, Arr.GetData());
 	return Arr;
 }
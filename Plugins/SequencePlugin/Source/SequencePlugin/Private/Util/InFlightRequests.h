@@ -0,0 +1,69 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+#pragma once
+#include "CoreMinimal.h"
+#include "Util/Async.h"
+
+/**
+ * Coalesces identical read requests that are in flight at the same time.
+ * The first caller for a key becomes the leader and performs the request, every later
+ * caller with the same key is parked until the leader resolves, then all of them
+ * receive the same result. Http completion runs on the game thread so no locking is done here.
+ */
+template<typename T>
+class TInFlightRequests
+{
+	struct FWaiter
+	{
+		TSuccessCallback<T> OnSuccess;
+		FFailureCallback OnFailure;
+	};
+
+	TMap<FString, TArray<FWaiter>> InFlight;
+public:
+
+	/**
+	 * Registers interest in Key
+	 * @return true if Key was already in flight and the callbacks were queued behind it,
+	 * false if the caller is the leader and must send the request then Resolve or Reject it
+	 */
+	bool Join(const FString& Key, const TSuccessCallback<T>& OnSuccess, const FFailureCallback& OnFailure)
+	{
+		if (TArray<FWaiter>* Waiters = this->InFlight.Find(Key))
+		{
+			Waiters->Add({OnSuccess, OnFailure});
+			return true;
+		}
+
+		this->InFlight.Add(Key).Add({OnSuccess, OnFailure});
+		return false;
+	}
+
+	void Resolve(const FString& Key, const T& Value)
+	{
+		TArray<FWaiter> Waiters;
+		if (this->InFlight.RemoveAndCopyValue(Key, Waiters))
+		{
+			for (const FWaiter& Waiter : Waiters)
+			{
+				Waiter.OnSuccess(Value);
+			}
+		}
+	}
+
+	void Reject(const FString& Key, const FSequenceError& Error)
+	{
+		TArray<FWaiter> Waiters;
+		if (this->InFlight.RemoveAndCopyValue(Key, Waiters))
+		{
+			for (const FWaiter& Waiter : Waiters)
+			{
+				Waiter.OnFailure(Error);
+			}
+		}
+	}
+
+	int32 Num() const
+	{
+		return this->InFlight.Num();
+	}
+};
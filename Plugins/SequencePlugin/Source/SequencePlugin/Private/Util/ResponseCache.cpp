@@ -0,0 +1,98 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+#include "Util/ResponseCache.h"
+
+FResponseCache::FResponseCache(const int64 MaxBytesIn) : MaxBytes(MaxBytesIn)
+{
+}
+
+int64 FResponseCache::EntrySize(const FString& Key, const FString& Value)
+{
+	return (Key.Len() + Value.Len()) * sizeof(TCHAR) + sizeof(FEntry);
+}
+
+void FResponseCache::EvictFor(const int64 ByteCountToAdd)
+{
+	while (this->Recency.Num() > 0 && (this->CurrentBytes + ByteCountToAdd) > this->MaxBytes)
+	{
+		const FString Key = this->Recency.GetTail()->GetValue();
+		this->Remove(Key);
+		if (this->OnEvicted)
+		{
+			this->OnEvicted(Key);
+		}
+	}
+}
+
+TOptional<FString> FResponseCache::Find(const FString& Key)
+{
+	if (const FEntry* Entry = this->Entries.Find(Key))
+	{
+		this->Recency.RemoveNode(Entry->Node, false);
+		this->Recency.AddHead(Entry->Node);
+		return Entry->Value;
+	}
+	return TOptional<FString>();
+}
+
+bool FResponseCache::Add(const FString& Key, const FString& Value)
+{
+	const int64 Size = EntrySize(Key, Value);
+	if (Size > this->MaxBytes)
+	{
+		return false;
+	}
+
+	this->Remove(Key);
+	this->EvictFor(Size);
+
+	this->Recency.AddHead(Key);
+	FEntry Entry;
+	Entry.Value = Value;
+	Entry.Node = this->Recency.GetHead();
+	this->Entries.Add(Key, Entry);
+	this->CurrentBytes += Size;
+	return true;
+}
+
+void FResponseCache::Remove(const FString& Key)
+{
+	if (const FEntry* Entry = this->Entries.Find(Key))
+	{
+		this->CurrentBytes -= EntrySize(Key, Entry->Value);
+		this->Recency.RemoveNode(Entry->Node);
+		this->Entries.Remove(Key);
+	}
+}
+
+void FResponseCache::Clear()
+{
+	this->Entries.Empty();
+	this->Recency.Empty();
+	this->CurrentBytes = 0;
+}
+
+void FResponseCache::SetOnEvicted(const TFunction<void (const FString&)>& OnEvictedIn)
+{
+	this->OnEvicted = OnEvictedIn;
+}
+
+void FResponseCache::SetMaxBytes(const int64 MaxBytesIn)
+{
+	this->MaxBytes = MaxBytesIn;
+	this->EvictFor(0);
+}
+
+int64 FResponseCache::GetMaxBytes() const
+{
+	return this->MaxBytes;
+}
+
+int64 FResponseCache::GetSizeInBytes() const
+{
+	return this->CurrentBytes;
+}
+
+int32 FResponseCache::Num() const
+{
+	return this->Entries.Num();
+}
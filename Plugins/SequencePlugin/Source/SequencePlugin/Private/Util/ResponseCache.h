@@ -0,0 +1,69 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+#pragma once
+#include "CoreMinimal.h"
+#include "Containers/List.h"
+
+/**
+ * Bounded, memory accounted key -> raw response cache.
+ * Every entry is charged for the bytes of its key and value, once the budget is exceeded
+ * the least recently used entries are evicted until the new entry fits.
+ */
+class SEQUENCEPLUGIN_API FResponseCache
+{
+	using FRecencyList = TDoubleLinkedList<FString>;
+
+	struct FEntry
+	{
+		FString Value;
+		/* Position of the key in Recency */
+		FRecencyList::TDoubleLinkedListNode* Node = nullptr;
+	};
+
+	TMap<FString, FEntry> Entries;
+	/* Keys, most recently used first, so touching and evicting an entry is constant time */
+	FRecencyList Recency;
+	int64 MaxBytes = 0;
+	int64 CurrentBytes = 0;
+	TFunction<void (const FString&)> OnEvicted;
+
+	static int64 EntrySize(const FString& Key, const FString& Value);
+
+	/*
+	* Evicts least recently used entries until ByteCountToAdd fits in the budget
+	*/
+	void EvictFor(int64 ByteCountToAdd);
+public:
+	explicit FResponseCache(int64 MaxBytesIn);
+
+	/* The recency list holds raw node pointers */
+	FResponseCache(const FResponseCache&) = delete;
+	FResponseCache& operator=(const FResponseCache&) = delete;
+
+	/*
+	* @return the cached value for Key if any, a hit marks the entry as recently used
+	*/
+	TOptional<FString> Find(const FString& Key);
+
+	/*
+	* Adds or replaces the value for Key, values larger than the whole budget are not cached
+	* @return false if Value was too large to cache
+	*/
+	bool Add(const FString& Key, const FString& Value);
+
+	void Remove(const FString& Key);
+	void Clear();
+
+	/*
+	* Called with the key of every entry dropped to make room, not for Remove or Clear
+	*/
+	void SetOnEvicted(const TFunction<void (const FString&)>& OnEvictedIn);
+
+	/*
+	* Changes the budget, evicting entries if the cache is now over it
+	*/
+	void SetMaxBytes(int64 MaxBytesIn);
+
+	int64 GetMaxBytes() const;
+	int64 GetSizeInBytes() const;
+	int32 Num() const;
+};
@@ -14,6 +14,7 @@ enum EErrorType
 	TestFail,
 	TimeMismatch,
 	FailedToParseIntentTime,
+	TransactionDropped,
 };
 
 class SEQUENCEPLUGIN_API FSequenceError
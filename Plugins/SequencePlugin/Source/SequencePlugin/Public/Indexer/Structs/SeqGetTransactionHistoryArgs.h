@@ -25,13 +25,10 @@ public:
         FString ret = "{";
         ret.Append("\"filter\":");
         ret.Append(filter.GetArgs());//get the args! MUST Have this!
-        if (page.IsSet())
+        if (page.IsSet() && page.GetValue().containsData())
         {
-            ret.Append(".\"page\":");
+            ret.Append(",\"page\":");
             ret.Append(page.GetValue().GetArgs());
-            TSharedPtr<FJsonObject> PageObject = MakeShared<FJsonObject>();
-            FJsonObjectConverter::UStructToJsonObject(FSeqPage::StaticStruct(), &(page.GetValue()), PageObject.ToSharedRef(), 0, 0);
-            
         }
 
         ret.Append(",\"includeMetaData\":");
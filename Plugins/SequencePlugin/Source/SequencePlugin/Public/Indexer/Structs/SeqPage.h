@@ -35,9 +35,9 @@ public:
     bool containsData()
     {
         bool ret = false;//assume nothing & look for true states!
-        ret = (page != -1 || pageSize != -1);//int32 data
-        ret = (column.Len() > 0 || before.Len() > 0 || after.Len() > 0);//FString data
-        ret = (sort.Num() > 0);//TArray data
+        ret |= (page != -1 || pageSize != -1);//int32 data
+        ret |= (column.Len() > 0 || before.Len() > 0 || after.Len() > 0);//FString data
+        ret |= (sort.Num() > 0);//TArray data
         ret |= more;//bool data
         return ret;
     }
@@ -52,21 +52,25 @@ public:
         if (containsData())
         {
             ret.Append("{");
-            ret.Append("\"page\":");
-            ret.AppendInt(page);
+            if (page != -1)
+            {
+                ret.Append("\"page\":");
+                ret.AppendInt(page);
+                ret.Append(",");
+            }
 
             if (column.Len() > 0)
-                ret += ",\"column\":\""+column+"\"";
+                ret += "\"column\":\""+column+"\",";
             
             if (before.Len() > 0)
-                ret += ",\"before\":\""+before+"\"";
+                ret += "\"before\":\""+before+"\",";
             
             if (after.Len() > 0)
-                ret += ",\"after\":\"" + after + "\"";
+                ret += "\"after\":\"" + after + "\",";
 
             if (sort.Num() > 0)
             {
-                ret.Append(",\"sort\":");
+                ret.Append("\"sort\":");
                 //convert SortBy to Json!Strings!
                 TArray<FString> stringList;
                 for (FSeqSortBy sItem : sort)
@@ -75,15 +79,17 @@ public:
                 }
                 //Parse the string list into a JsonString
                 ret.Append(USequenceSupport::StringListToSimpleString(stringList));
+                ret.Append(",");
             }
 
             if (pageSize != -1)
             {
-                ret.Append(",\"pageSize\":");
+                ret.Append("\"pageSize\":");
                 ret.AppendInt(pageSize);
+                ret.Append(",");
             }
 
-            ret.Append(",\"more\":");
+            ret.Append("\"more\":");
             ret.Append(more ? "true" : "false");
             ret.Append("}");
         }
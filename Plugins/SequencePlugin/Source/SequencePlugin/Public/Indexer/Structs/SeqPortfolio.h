@@ -0,0 +1,73 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SeqEtherBalance.h"
+#include "SeqTokenBalance.h"
+#include "SeqPortfolio.generated.h"
+
+/*
+* Balances of one account on one chain
+*/
+USTRUCT(BlueprintType)
+struct SEQUENCEPLUGIN_API FSeqChainPortfolio
+{
+    GENERATED_USTRUCT_BODY()
+public:
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Default")
+        int64 chainId = -1;
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Default")
+        FString networkName = "";
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Default")
+        bool completed = false;
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Default")
+        bool succeeded = false;
+    /* The account holds more token balances than were read, only the first pages are listed */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Default")
+        bool truncated = false;
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Default")
+        FString error = "";
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Default")
+        FSeqEtherBalance etherBalance;
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Default")
+        TArray<FSeqTokenBalance> balances;
+};
+
+/*
+* Balances of one account across several chains, chains are kept in the order they were requested
+*/
+USTRUCT(BlueprintType)
+struct SEQUENCEPLUGIN_API FSeqPortfolio
+{
+    GENERATED_USTRUCT_BODY()
+public:
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Default")
+        FString accountAddress = "";
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Default")
+        TArray<FSeqChainPortfolio> chains;
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Default")
+        int32 completedChains = 0;
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Default")
+        int32 failedChains = 0;
+
+    bool IsComplete() const
+    {
+        return completedChains == chains.Num();
+    }
+
+    /*
+    * @return the token balances of every chain that succeeded, each tagged with its chainId
+    */
+    TArray<FSeqTokenBalance> GetAllBalances() const
+    {
+        TArray<FSeqTokenBalance> ret;
+        for (const FSeqChainPortfolio& chain : chains)
+        {
+            if (chain.succeeded)
+            {
+                ret.Append(chain.balances);
+            }
+        }
+        return ret;
+    }
+};
@@ -19,6 +19,7 @@
 #include "SeqGetTransactionHistoryReturn.h"
 #include "SeqPage.h"
 #include "SeqPingReturn.h"
+#include "SeqPortfolio.h"
 #include "SeqRuntimeChecks.h"
 #include "SeqRuntimeStatus.h"
 #include "SeqRuntimeStatusReturn.h"
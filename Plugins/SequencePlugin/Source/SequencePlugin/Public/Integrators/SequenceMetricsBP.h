@@ -0,0 +1,123 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "SequenceMetricsBP.generated.h"
+
+USTRUCT(BlueprintType)
+struct SEQUENCEPLUGIN_API FSequenceEndpointMetrics
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "0xSequence SDK - Metrics")
+	FString Endpoint = "";
+
+	UPROPERTY(BlueprintReadOnly, Category = "0xSequence SDK - Metrics")
+	FString Category = "";
+
+	UPROPERTY(BlueprintReadOnly, Category = "0xSequence SDK - Metrics")
+	int32 Calls = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "0xSequence SDK - Metrics")
+	int32 Errors = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "0xSequence SDK - Metrics")
+	int32 Retries = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "0xSequence SDK - Metrics")
+	int64 BytesOut = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "0xSequence SDK - Metrics")
+	int64 BytesIn = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "0xSequence SDK - Metrics")
+	float QueueP95Ms = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "0xSequence SDK - Metrics")
+	float TimeToFirstByteP50Ms = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "0xSequence SDK - Metrics")
+	float TotalP50Ms = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "0xSequence SDK - Metrics")
+	float TotalP95Ms = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "0xSequence SDK - Metrics")
+	float TotalP99Ms = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "0xSequence SDK - Metrics")
+	TMap<int32, int32> StatusCodes;
+};
+
+USTRUCT(BlueprintType)
+struct SEQUENCEPLUGIN_API FSequenceRateBudget
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "0xSequence SDK - Metrics")
+	FString Host = "";
+
+	UPROPERTY(BlueprintReadOnly, Category = "0xSequence SDK - Metrics")
+	float Tokens = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "0xSequence SDK - Metrics")
+	float RequestsPerSecond = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "0xSequence SDK - Metrics")
+	float Burst = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "0xSequence SDK - Metrics")
+	float RetryAfterSeconds = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "0xSequence SDK - Metrics")
+	int32 Queued = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "0xSequence SDK - Metrics")
+	int32 Throttled = 0;
+};
+
+UCLASS(Blueprintable)
+class SEQUENCEPLUGIN_API USequenceMetricsBP : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+	
+public:
+	USequenceMetricsBP();
+
+	virtual void Deinitialize() override;
+
+	/*
+	* Latency, throughput and error metrics of every endpoint the SDK has called
+	*/
+	UFUNCTION(BlueprintCallable, Category="0xSequence SDK - Functions")
+	TArray<FSequenceEndpointMetrics> GetEndpointMetrics() const;
+
+	UFUNCTION(BlueprintCallable, Category="0xSequence SDK - Functions")
+	void ResetMetrics();
+
+	/*
+	* Writes the metrics to Saved/Sequence/Metrics, returns the file written or an empty string
+	*/
+	UFUNCTION(BlueprintCallable, Category="0xSequence SDK - Functions")
+	FString DumpMetrics(bool bAsJson);
+
+	UFUNCTION(BlueprintCallable, Category="0xSequence SDK - Functions")
+	void StartPeriodicMetricsDump(float IntervalSeconds, bool bAsJson);
+
+	UFUNCTION(BlueprintCallable, Category="0xSequence SDK - Functions")
+	void StopPeriodicMetricsDump();
+
+	/*
+	* Remaining client side request budget of every host the SDK has called
+	*/
+	UFUNCTION(BlueprintCallable, Category="0xSequence SDK - Functions")
+	TArray<FSequenceRateBudget> GetRateBudgets() const;
+
+	/*
+	* Sets the token bucket used for every host without a limit of its own, 0 requests per second disables limiting
+	*/
+	UFUNCTION(BlueprintCallable, Category="0xSequence SDK - Functions")
+	void SetDefaultRateLimit(float RequestsPerSecond, float Burst, float BackgroundReserve);
+};
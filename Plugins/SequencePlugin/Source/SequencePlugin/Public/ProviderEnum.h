@@ -10,4 +10,24 @@ enum EBlockTag
 	EPending UMETA(DisplayName = "pending"),
 	ESafe UMETA(DisplayName = "safe"),
 	EFinalized UMETA(DisplayName = "finalized"),
-};
\ No newline at end of file
+};
+
+/*
+* @return the JSON-RPC name of the tag, e.g. "latest"
+*/
+inline FString BlockTagToString(const EBlockTag Tag)
+{
+	switch (Tag)
+	{
+	case EEarliest:
+		return "earliest";
+	case EPending:
+		return "pending";
+	case ESafe:
+		return "safe";
+	case EFinalized:
+		return "finalized";
+	default:
+		return "latest";
+	}
+}
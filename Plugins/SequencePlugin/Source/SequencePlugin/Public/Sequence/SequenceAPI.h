@@ -3,6 +3,7 @@
 #include "Indexer/Structs/Struct_Data.h"
 #include "SequenceAuthenticator.h"
 #include "Util/Async.h"
+#include "Util/Future.h"
 #include "Eth/EthTransaction.h"
 #include "Types/BinaryData.h"
 #include "Containers/Union.h"
@@ -295,6 +296,40 @@ public:
 	*/
 	void GetTransactionHistory(const FSeqGetTransactionHistoryArgs& Args, const TSuccessCallback<FSeqGetTransactionHistoryReturn>& OnSuccess, const FFailureCallback& OnFailure) const;
 
+	/*
+		Pages through the token balances from the Chain, each page is requested while the previous one is handled
+		@param OnPage called with every page in order, return false to stop early
+		@param OnDone called once the last page was handled or OnPage stopped
+	*/
+	void ForEachTokenBalancesPage(const FSeqGetTokenBalancesArgs& Args, const TFunction<bool (const FSeqGetTokenBalancesReturn&)>& OnPage, const TFunction<void ()>& OnDone, const FFailureCallback& OnFailure) const;
+
+	/*
+		Pages through the transaction history from the Chain, see ForEachTokenBalancesPage
+	*/
+	void ForEachTransactionHistoryPage(const FSeqGetTransactionHistoryArgs& Args, const TFunction<bool (const FSeqGetTransactionHistoryReturn&)>& OnPage, const TFunction<void ()>& OnDone, const FFailureCallback& OnFailure) const;
+
+	/*
+		@return the transaction history of this wallet on the current network as stored on disk by the last
+		SyncTransactionHistory, newest first, without a request
+	*/
+	TArray<FSeqTransaction> GetStoredTransactionHistory() const;
+
+	/*
+		Fetches only the transactions of this wallet newer than the stored history and merges them in
+		@param OnSuccess called with the whole history, newest first
+	*/
+	void SyncTransactionHistory(const TSuccessCallback<TArray<FSeqTransaction>>& OnSuccess, const FFailureCallback& OnFailure) const;
+
+	/*
+		Reads the balances of this wallet on several chains at once, a chain that fails is marked in the portfolio
+		and does not fail the others
+		@param ChainIds the chains to read, empty reads every network Sequence supports
+		@param MaxConcurrentChains how many chains are read at the same time
+		@param OnChain called with each chain as it completes and the portfolio gathered so far, may be null
+		@param OnSuccess called with the whole portfolio once every chain completed
+	*/
+	void GetPortfolio(const TArray<int64>& ChainIds, int32 MaxConcurrentChains, const TFunction<void (const FSeqChainPortfolio&, const FSeqPortfolio&)>& OnChain, const TSuccessCallback<FSeqPortfolio>& OnSuccess) const;
+
 	//Provider calls
 
 	void BlockByNumber(uint64 Number, const TFunction<void(TSharedPtr<FJsonObject>)>& OnSuccess,
@@ -317,6 +352,8 @@ public:
 	                      const TFunction<void(FSequenceError)>& OnFailure) const;
 	void TransactionReceipt(const FHash256& Hash, const TFunction<void(FTransactionReceipt)>& OnSuccess,
 	                        const TFunction<void(FSequenceError)>& OnFailure) const;
+	void WaitForReceipt(const FHash256& Hash, int32 Confirmations, float TimeoutSeconds, const TFunction<void(FTransactionReceipt)>& OnSuccess,
+	                    const TFunction<void(FSequenceError)>& OnFailure) const;
 
 	void GetGasPrice(const TFunction<void(FUnsizedData)>& OnSuccess, const TFunction<void(FSequenceError)>& OnFailure) const;
 	void EstimateContractCallGas(const FContractCall& ContractCall, const TFunction<void(FUnsizedData)>& OnSuccess,
@@ -337,4 +374,26 @@ public:
 	
 	void NonViewCall(const FEthTransaction& Transaction, const FPrivateKey& PrivateKey, int ChainID,
 	                 const TFunction<void(FUnsizedData)>& OnSuccess, const TFunction<void(FSequenceError)>& OnFailure) const;
+
+	//Future returning calls, see Util/Future.h. They fail right away if the wallet is not initialized
+
+	TSeqFuture<FSeqSignMessageResponse_Response> SignMessage(const FString& Message) const;
+	TSeqFuture<FSeqTransactionResponse_Data> SendTransaction(const TArray<TransactionUnion>& Transactions) const;
+	TSeqFuture<FSeqTransactionResponse_Data> SendTransactionWithFeeOption(const TArray<TransactionUnion>& Transactions, const FFeeOption& FeeOption) const;
+	TSeqFuture<TArray<FFeeOption>> GetFeeOptions(const TArray<TransactionUnion>& Transactions) const;
+	TSeqFuture<TArray<FFeeOption>> GetUnfilteredFeeOptions(const TArray<TransactionUnion>& Transactions) const;
+
+	TSeqFuture<FSeqEtherBalance> GetEtherBalance(const FString& AccountAddr) const;
+	TSeqFuture<FSeqGetTokenBalancesReturn> GetTokenBalances(const FSeqGetTokenBalancesArgs& Args) const;
+	TSeqFuture<FSeqGetTokenSuppliesReturn> GetTokenSupplies(const FSeqGetTokenSuppliesArgs& Args) const;
+	TSeqFuture<FSeqGetTokenSuppliesMapReturn> GetTokenSuppliesMap(const FSeqGetTokenSuppliesMapArgs& Args) const;
+	TSeqFuture<FSeqGetTransactionHistoryReturn> GetTransactionHistory(const FSeqGetTransactionHistoryArgs& Args) const;
+
+	TSeqFuture<uint64> BlockNumber() const;
+	TSeqFuture<uint64> TransactionCount(const FAddress& Addr, EBlockTag Tag) const;
+	TSeqFuture<FTransactionReceipt> TransactionReceipt(const FHash256& Hash) const;
+	TSeqFuture<FTransactionReceipt> WaitForReceipt(const FHash256& Hash, int32 Confirmations, float TimeoutSeconds) const;
+	TSeqFuture<FUnsizedData> GetGasPrice() const;
+	TSeqFuture<FUnsizedData> EstimateContractCallGas(const FContractCall& ContractCall) const;
+	TSeqFuture<FUnsizedData> Call(const FContractCall& ContractCall, EBlockTag Number) const;
 };
\ No newline at end of file
@@ -52,6 +52,9 @@ FUnsizedData SEQUENCEPLUGIN_API StringToUTF8(FString String);
 // Converts a UTF8 encoded byte array ot a string
 FString SEQUENCEPLUGIN_API UTF8ToString(FUnsizedData BinaryData);
 
+// Converts UTF8 encoded bytes to a string in a single pass, the bytes need not be null terminated
+FString SEQUENCEPLUGIN_API UTF8BytesToString(TConstArrayView<uint8> Bytes);
+
 // UNIFORM DATA TYPES
 template<ByteLength TSize>
 struct SEQUENCEPLUGIN_API TSizedData : FBinaryData
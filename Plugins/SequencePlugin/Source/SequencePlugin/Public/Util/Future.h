@@ -0,0 +1,393 @@
+// Copyright 2024 Horizon Blockchain Games Inc. All rights reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "Util/Async.h"
+
+/*
+* A lightweight future / promise layer over the TSuccessCallback / FFailureCallback APIs.
+* A TSeqFuture settles once with either a value or an FSequenceError, continuations added before
+* or after it settles run exactly once. Independent calls can be started together and joined with
+* SeqFuture::WhenAll / WhenAny instead of nesting callbacks or counting completions by hand.
+* Not thread safe, futures are created, settled and continued on the game thread.
+*/
+
+template <typename T>
+class TSeqFuture;
+
+template <typename T>
+class TSeqPromise;
+
+template <typename T>
+struct TSeqFutureState
+{
+	TOptional<T> Value;
+	TOptional<FSequenceError> Error;
+	TArray<TFunction<void ()>> Continuations;
+
+	bool IsSettled() const
+	{
+		return this->Value.IsSet() || this->Error.IsSet();
+	}
+
+	void RunContinuations()
+	{
+		const TArray<TFunction<void ()>> Ready = MoveTemp(this->Continuations);
+		this->Continuations.Reset();
+		for (const TFunction<void ()>& Continuation : Ready)
+		{
+			Continuation();
+		}
+	}
+};
+
+/*
+* Maps the result of a Then continuation to the value type of the future it returns,
+* continuations returning a future are flattened into it
+*/
+template <typename R>
+struct TSeqFutureResult
+{
+	using Type = R;
+
+	static void Forward(const R& Result, const TSeqPromise<R>& Promise)
+	{
+		Promise.SetValue(Result);
+	}
+};
+
+template <typename U>
+struct TSeqFutureResult<TSeqFuture<U>>
+{
+	using Type = U;
+
+	static void Forward(const TSeqFuture<U>& Result, const TSeqPromise<U>& Promise)
+	{
+		Result.Then(Promise.SuccessCallback(), Promise.FailureCallback());
+	}
+};
+
+/*
+* Read side of an asynchronous result
+*/
+template <typename T>
+class TSeqFuture
+{
+	TSharedRef<TSeqFutureState<T>> State;
+
+	template <typename> friend class TSeqPromise;
+
+	explicit TSeqFuture(const TSharedRef<TSeqFutureState<T>>& StateIn) : State(StateIn)
+	{
+	}
+public:
+	using ValueType = T;
+
+	bool IsReady() const
+	{
+		return this->State->IsSettled();
+	}
+
+	bool IsSucceeded() const
+	{
+		return this->State->Value.IsSet();
+	}
+
+	/*
+	* Only valid once IsSucceeded
+	*/
+	const T& GetValue() const
+	{
+		return this->State->Value.GetValue();
+	}
+
+	/*
+	* Only valid once IsReady and not IsSucceeded
+	*/
+	const FSequenceError& GetError() const
+	{
+		return this->State->Error.GetValue();
+	}
+
+	/*
+	* Hands the outcome to the matching callback, immediately if the future already settled
+	*/
+	void Then(const TSuccessCallback<T>& OnSuccess, const FFailureCallback& OnFailure) const
+	{
+		const TSharedRef<TSeqFutureState<T>> Settled = this->State;
+		const TFunction<void ()> Run = [Settled, OnSuccess, OnFailure]()
+		{
+			if (Settled->Value.IsSet())
+			{
+				OnSuccess(Settled->Value.GetValue());
+			}
+			else
+			{
+				OnFailure(Settled->Error.GetValue());
+			}
+		};
+
+		if (this->State->IsSettled())
+		{
+			Run();
+		}
+		else
+		{
+			this->State->Continuations.Add(Run);
+		}
+	}
+
+	/*
+	* Runs Continuation on the value, errors are passed through untouched.
+	* Continuation may return a plain value or another future, in which case the result waits for it
+	*/
+	template <typename FContinuation>
+	auto Then(FContinuation&& Continuation) const -> TSeqFuture<typename TSeqFutureResult<decltype(Continuation(DeclVal<const T&>()))>::Type>
+	{
+		using FResult = decltype(Continuation(DeclVal<const T&>()));
+		using U = typename TSeqFutureResult<FResult>::Type;
+
+		const TSeqPromise<U> Promise;
+		this->Then([Promise, Continuation = Forward<FContinuation>(Continuation)](const T& Value)
+		{
+			TSeqFutureResult<FResult>::Forward(Continuation(Value), Promise);
+		}, Promise.FailureCallback());
+		return Promise.GetFuture();
+	}
+
+	/*
+	* Turns an error into a value, successful values are passed through untouched
+	*/
+	TSeqFuture<T> Recover(const TFunction<T (const FSequenceError&)>& Recovery) const
+	{
+		const TSeqPromise<T> Promise;
+		this->Then(Promise.SuccessCallback(), [Promise, Recovery](const FSequenceError& Error)
+		{
+			Promise.SetValue(Recovery(Error));
+		});
+		return Promise.GetFuture();
+	}
+
+	/*
+	* @return a future failing with RequestTimeExceeded if this one has not settled after Seconds
+	*/
+	TSeqFuture<T> Timeout(const float Seconds) const
+	{
+		const TSeqPromise<T> Promise;
+		this->Then(Promise.SuccessCallback(), Promise.FailureCallback());
+		if (!Promise.IsSettled())
+		{
+			FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([Promise, Seconds](float)
+			{
+				Promise.SetError(FSequenceError(RequestTimeExceeded, FString::Printf(TEXT("Timed out after %.2fs"), Seconds)));
+				return false;
+			}), Seconds);
+		}
+		return Promise.GetFuture();
+	}
+};
+
+/*
+* Write side of an asynchronous result, copies share the same future.
+* Only the first SetValue / SetError counts, later ones are ignored.
+*/
+template <typename T>
+class TSeqPromise
+{
+	TSharedRef<TSeqFutureState<T>> State;
+public:
+	TSeqPromise() : State(MakeShared<TSeqFutureState<T>>())
+	{
+	}
+
+	TSeqFuture<T> GetFuture() const
+	{
+		return TSeqFuture<T>(this->State);
+	}
+
+	bool IsSettled() const
+	{
+		return this->State->IsSettled();
+	}
+
+	/*
+	* @return false if the promise had already settled
+	*/
+	bool SetValue(const T& Value) const
+	{
+		if (this->State->IsSettled())
+		{
+			return false;
+		}
+		this->State->Value = Value;
+		this->State->RunContinuations();
+		return true;
+	}
+
+	/*
+	* @return false if the promise had already settled
+	*/
+	bool SetError(const FSequenceError& Error) const
+	{
+		if (this->State->IsSettled())
+		{
+			return false;
+		}
+		this->State->Error = Error;
+		this->State->RunContinuations();
+		return true;
+	}
+
+	/*
+	* @return a callback settling this promise, to hand to the callback based APIs
+	*/
+	TSuccessCallback<T> SuccessCallback() const
+	{
+		const TSeqPromise<T> Promise = *this;
+		return [Promise](T Value)
+		{
+			Promise.SetValue(Value);
+		};
+	}
+
+	FFailureCallback FailureCallback() const
+	{
+		const TSeqPromise<T> Promise = *this;
+		return [Promise](const FSequenceError& Error)
+		{
+			Promise.SetError(Error);
+		};
+	}
+};
+
+namespace SeqFuture
+{
+	template <typename T>
+	TSeqFuture<T> MakeReady(const T& Value)
+	{
+		const TSeqPromise<T> Promise;
+		Promise.SetValue(Value);
+		return Promise.GetFuture();
+	}
+
+	template <typename T>
+	TSeqFuture<T> MakeError(const FSequenceError& Error)
+	{
+		const TSeqPromise<T> Promise;
+		Promise.SetError(Error);
+		return Promise.GetFuture();
+	}
+
+	/*
+	* Wraps a callback based call, Call is run immediately with callbacks settling the returned future
+	*/
+	template <typename T>
+	TSeqFuture<T> FromCallback(const TFunction<void (const TSuccessCallback<T>&, const FFailureCallback&)>& Call)
+	{
+		const TSeqPromise<T> Promise;
+		Call(Promise.SuccessCallback(), Promise.FailureCallback());
+		return Promise.GetFuture();
+	}
+
+	/*
+	* Settles with every value in order once all futures succeeded, or with the first error
+	*/
+	template <typename T>
+	TSeqFuture<TArray<T>> WhenAll(const TArray<TSeqFuture<T>>& Futures)
+	{
+		const TSeqPromise<TArray<T>> Promise;
+		if (Futures.Num() == 0)
+		{
+			Promise.SetValue(TArray<T>());
+			return Promise.GetFuture();
+		}
+
+		const TSharedRef<TArray<TOptional<T>>> Values = MakeShared<TArray<TOptional<T>>>();
+		Values->SetNum(Futures.Num());
+		const TSharedRef<int32> Remaining = MakeShared<int32>(Futures.Num());
+
+		for (int32 Index = 0; Index < Futures.Num(); Index++)
+		{
+			Futures[Index].Then([Promise, Values, Remaining, Index](T Value)
+			{
+				(*Values)[Index] = Value;
+				if (--(*Remaining) > 0)
+				{
+					return;
+				}
+
+				TArray<T> Out;
+				Out.Reserve(Values->Num());
+				for (const TOptional<T>& Entry : *Values)
+				{
+					Out.Add(Entry.GetValue());
+				}
+				Promise.SetValue(Out);
+			}, Promise.FailureCallback());
+		}
+		return Promise.GetFuture();
+	}
+
+	/*
+	* Settles with the first value to arrive, or with the last error once every future failed
+	*/
+	template <typename T>
+	TSeqFuture<T> WhenAny(const TArray<TSeqFuture<T>>& Futures)
+	{
+		const TSeqPromise<T> Promise;
+		if (Futures.Num() == 0)
+		{
+			Promise.SetError(FSequenceError(EmptyResponse, "WhenAny of no futures"));
+			return Promise.GetFuture();
+		}
+
+		const TSharedRef<int32> Remaining = MakeShared<int32>(Futures.Num());
+		for (const TSeqFuture<T>& Future : Futures)
+		{
+			Future.Then(Promise.SuccessCallback(), [Promise, Remaining](const FSequenceError& Error)
+			{
+				if (--(*Remaining) == 0)
+				{
+					Promise.SetError(Error);
+				}
+			});
+		}
+		return Promise.GetFuture();
+	}
+
+	namespace Private
+	{
+		template <typename... Ts, uint32... Indices>
+		TTuple<Ts...> CollectTuple(const TTuple<TOptional<Ts>...>& Slots, TIntegerSequence<uint32, Indices...>)
+		{
+			return TTuple<Ts...>(Slots.template Get<Indices>().GetValue()...);
+		}
+
+		template <typename... Ts, uint32... Indices>
+		void BindTuple(const TSeqPromise<TTuple<Ts...>>& Promise, const TSharedRef<TTuple<TOptional<Ts>...>>& Slots, const TSharedRef<int32>& Remaining, TIntegerSequence<uint32, Indices...>, const TSeqFuture<Ts>&... Futures)
+		{
+			(Futures.Then([Promise, Slots, Remaining](Ts Value)
+			{
+				Slots->template Get<Indices>() = Value;
+				if (--(*Remaining) == 0)
+				{
+					Promise.SetValue(CollectTuple<Ts...>(*Slots, TMakeIntegerSequence<uint32, sizeof...(Ts)>()));
+				}
+			}, Promise.FailureCallback()), ...);
+		}
+	}
+
+	/*
+	* Joins futures of different types, settles with a tuple of every value or with the first error
+	*/
+	template <typename... Ts>
+	TSeqFuture<TTuple<Ts...>> WhenAll(const TSeqFuture<Ts>&... Futures)
+	{
+		const TSeqPromise<TTuple<Ts...>> Promise;
+		const TSharedRef<TTuple<TOptional<Ts>...>> Slots = MakeShared<TTuple<TOptional<Ts>...>>();
+		const TSharedRef<int32> Remaining = MakeShared<int32>(sizeof...(Ts));
+		Private::BindTuple(Promise, Slots, Remaining, TMakeIntegerSequence<uint32, sizeof...(Ts)>(), Futures...);
+		return Promise.GetFuture();
+	}
+}
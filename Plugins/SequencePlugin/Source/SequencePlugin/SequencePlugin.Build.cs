@@ -56,7 +56,7 @@ public class SequencePlugin : ModuleRules
 				"Projects",
                 "Json",
                 "JsonUtilities",
-				"ApplicationCore", "WebBrowser", "EngineSettings"
+				"ApplicationCore", "WebBrowser", "EngineSettings", "WebSockets"
 				// ... add private dependencies that you statically link with here ...	
 			}
 			);